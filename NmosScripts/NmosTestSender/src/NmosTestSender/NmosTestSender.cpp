@@ -33,6 +33,81 @@ static void handle_log(
     printf("%s [%d:%s]\n", message, level, categories);
 }
 
+#ifdef NMOS_TEST_SENDER_MEDIA
+// test pattern sender for the active SDP of "sender-video", started with --send
+static bool send_enabled = false;
+static std::string send_interface_name;
+static std::mutex send_mutex;
+static std::atomic<bool> send_stop(false);
+static std::thread send_thread;
+
+// sends color bars, a moving ramp and a frame counter on the ST 2110-21 schedule until stopped
+static void send_test_pattern(std::string sdp, std::string interface_name)
+{
+    try
+    {
+        Cf::SDPParser sdp_parser(sdp);
+        const Cf::SDP::VideoDescription* video_description = sdp_parser.GetSDP().GetFirstVideo();
+        if (!video_description)
+        {
+            printf("Test pattern sender: no video in the SDP\n");
+            return;
+        }
+
+        Cf::VideoSenderSettings settings;
+        settings.socket.interface_name = interface_name;
+        Cf::VideoSender sender(*video_description, settings);
+        Cf::TestPattern pattern(sender.GetFormat());
+        const Cf::VideoSenderStatistics& statistics = sender.GetStatistics();
+
+        printf("Test pattern sender: sending %u packets per frame\n", sender.GetPacker().GetPacketsPerFrame());
+
+        int64_t report_ns = Cf::VideoSender::GetTaiNs();
+        uint64_t report_octets = 0;
+        uint64_t frame = sender.GetNextFrame();
+        while (!send_stop.load())
+        {
+            sender.SendFrame(pattern.Render(frame), frame);
+
+            // a sender that fell behind skips to the next frame it can send on time
+            frame = std::max(frame + 1, sender.GetNextFrame());
+
+            int64_t now_ns = Cf::VideoSender::GetTaiNs();
+            if (now_ns - report_ns >= 5000000000LL)
+            {
+                uint64_t octets = statistics.octets.load();
+                printf("Test pattern sender: %llu frames, %llu packets, %.1f Mbit/s, %llu late, %llu dropped\n",
+                    (unsigned long long)statistics.frames.load(),
+                    (unsigned long long)statistics.packets.load(),
+                    (octets - report_octets) * 8e3 / (now_ns - report_ns),
+                    (unsigned long long)statistics.packets_late.load(),
+                    (unsigned long long)statistics.packets_dropped.load());
+                report_ns = now_ns;
+                report_octets = octets;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        // e.g. the x.x.x.x placeholder address of an SDP no controller has activated yet
+        printf("Test pattern sender stopped: %s\n", e.what());
+    }
+}
+
+// stops the test pattern sender, then starts it again for sdp unless sdp is null
+static void restart_test_pattern(const char* sdp)
+{
+    std::lock_guard<std::mutex> lock(send_mutex);
+    if (send_thread.joinable())
+    {
+        send_stop = true;
+        send_thread.join();
+    }
+    send_stop = false;
+    if (sdp) send_thread = std::thread(send_test_pattern, std::string(sdp), send_interface_name);
+}
+#endif
+
 static bool handle_rtp_connection_activated(
     NvNmosNodeServer* server,
     const char* id,
@@ -40,6 +115,9 @@ static bool handle_rtp_connection_activated(
 {
     printf("%s %s\n", id, sdp ? "activated via NMOS" : "deactivated via NMOS");
     if (server->user_data && sdp) printf("%s\n", sdp);
+#ifdef NMOS_TEST_SENDER_MEDIA
+    if (send_enabled && 0 == strcmp(id, "sender-video")) restart_test_pattern(sdp);
+#endif
     return true;
 }
 
@@ -172,8 +250,18 @@ static bool get_continue(void)
 }
 
 
-int main()
+int main(int argc, char** argv)
 {
+#ifdef NMOS_TEST_SENDER_MEDIA
+    // --send [interface_name] sends a test pattern to the video sender's destination while it is active
+    for (int i = 1; i < argc; i++)
+    {
+        if (0 != strcmp(argv[i], "--send")) continue;
+        send_enabled = true;
+        if (i + 1 < argc && 0 != strncmp(argv[i + 1], "--", 2)) send_interface_name = argv[++i];
+    }
+#endif
+
     // Create Asset Config
     const char* functions[1] = {
         "Nmos Test Sender"
@@ -234,11 +322,17 @@ int main()
     printf("Activating sender...\n\n");
     if (!nmos_connection_rtp_activate(static_cast<NvNmosNodeServer*>(node_server_sender.get()), "sender-video", sender_config[0].sdp)) goto cleanup;
     if (!nmos_connection_rtp_activate(static_cast<NvNmosNodeServer*>(node_server_sender.get()), "sender-audio", sender_config[1].sdp)) goto cleanup;
+#ifdef NMOS_TEST_SENDER_MEDIA
+    if (send_enabled) restart_test_pattern(sender_config[0].sdp);
+#endif
 
     printf("Deactivate the sender node and destroy server?\n");
     if (!get_continue()) goto cleanup;
 
     printf("Deactivating sender...\n");
+#ifdef NMOS_TEST_SENDER_MEDIA
+    restart_test_pattern(0);
+#endif
     if (!nmos_connection_rtp_activate(static_cast<NvNmosNodeServer*>(node_server_sender.get()), "sender-video", 0)) goto cleanup;
     if (!nmos_connection_rtp_activate(static_cast<NvNmosNodeServer*>(node_server_sender.get()), "sender-audio", 0)) goto cleanup;
 
@@ -250,6 +344,9 @@ int main()
     return 0;
 
 cleanup:
+#ifdef NMOS_TEST_SENDER_MEDIA
+    restart_test_pattern(0);
+#endif
     destroy_nmos_node_server(static_cast<NvNmosNodeServer*>(node_server_sender.get()));
     return 1;
 }
@@ -33,6 +33,18 @@ By using the Code, Licensee agrees to these terms.
 
 #include "nvnmos.h"
 
+// line-rate test pattern sender, Linux only
+#ifdef NMOS_TEST_SENDER_MEDIA
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string.h>
+#include <string>
+#include <thread>
+
+#include "st2110_adapter.h"
+#endif
+
  // example video format
 #ifndef VIDEO_DESCRIPTION
 #define VIDEO_DESCRIPTION "YCbCr-4:2:2, 10 bit, 1920 x 1080, progressive, 50 Hz"
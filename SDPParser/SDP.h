@@ -33,6 +33,17 @@ namespace Cf
 	class SDP
 	{
 	public:
+		// Longest textual address stored inline. Holds any IPv6 literal
+		// (INET6_ADDRSTRLEN) and typical host names; longer FQDNs (up to 253
+		// characters, RFC 8866 5.7) move to the heap.
+		static constexpr size_t ADDRESS_LENGTH = 63;
+
+		// Short SDP tokens such as <nettype>, <addrtype> and <bwtype>
+		using Token = FixedString<15>;
+
+		// Unicast/multicast address or host name
+		using Address = FixedString<ADDRESS_LENGTH>;
+
 		/// <summary>
 		/// Origin: Struct describing one origin ("o=") section of the SDP. See
 		///			RFC 8866 Section 5.2 for full description.
@@ -58,7 +69,7 @@ namespace Cf
 
 			// <nettype>
 			// Describes the type of network. Usually "IN" for Internet. 
-			std::string net_type;
+			Token net_type;
 
 			// <addrtype>
 			// Describes the type of address such as "IP4" or "IP6". Will be
@@ -67,7 +78,7 @@ namespace Cf
 
 			// <unicast-address>
 			// The address of the machine from which the session was created.
-			std::string unicast_address;
+			Address unicast_address;
 		};
 
 
@@ -83,19 +94,90 @@ namespace Cf
 			// <addrtype>
 			// Describes the type of address such as "IP4" or "IP6". Set as int
 			// like 4 or 6.
-			int32_t addr_type;
+			int32_t addr_type = 4;
 
 			// <connection-address>
 			// Describes the connection address. Additional subfields MAY be
 			// added after the connection address depending on the value of the 
 			// <addrtype> subfield. See RFC 8866 5.7 for full description.
-			std::string connection_address = "";
+			Address connection_address;
 
 
 			// Time to live
 			// The TTL for the session is appended to the address using a slash 
 			// as a separator. An example is: c = IN IP4 233.252.0.1/127
-			int32_t ttl;
+			// For IP6 the value after the slash is the number of addresses
+			// instead, as IPv6 has no TTL field in "c=".
+			int32_t ttl = 0;
+		};
+
+
+		/// <summary>
+		/// SocketAddress: IPv4 or IPv6 socket address in network byte order,
+		///				   sized for either family so it can be stored inline.
+		/// </summary>
+		union SocketAddress
+		{
+			sockaddr generic;
+			sockaddr_in ipv4;
+			sockaddr_in6 ipv6;
+		};
+
+
+		/// <summary>
+		/// Endpoint: Socket endpoint for one media description, resolved into
+		///			  binary form once at parse time from the "c=" connection
+		///			  address, the "m=" port, and "a=source-filter:". Can be
+		///			  handed straight to bind()/setsockopt() without any
+		///			  further inet_pton()/stoi() work.
+		/// </summary>
+		struct Endpoint
+		{
+		public:
+
+			// AF_INET or AF_INET6 taken from ConnectionInformation::addr_type.
+			// AF_UNSPEC if the connection address could not be resolved.
+			int32_t family = AF_UNSPEC;
+
+			// Destination address (multicast group or unicast) and port.
+			SocketAddress address = {};
+
+			// True if the destination address is a multicast group.
+			bool multicast = false;
+
+			// Multicast TTL from "c=". Always 0 for IP6.
+			int32_t ttl = 0;
+
+			// Source filter from "a=source-filter:". For "incl" this is the 
+			// source-specific multicast (SSM) source list, for "excl" it is
+			// the list of sources to block. Empty for any-source multicast.
+			bool exclude_sources = false;
+			SmallVector<SocketAddress, 2> sources;
+
+			bool IsResolved() const { return family != AF_UNSPEC; }
+
+			// Back to unresolved, keeping the capacity of sources
+			void Clear()
+			{
+				family = AF_UNSPEC;
+				address = {};
+				multicast = false;
+				ttl = 0;
+				exclude_sources = false;
+				sources.clear();
+			}
+
+			const sockaddr* GetSockAddr() const { return &address.generic; }
+
+			socklen_t GetSockAddrLength() const
+			{
+				return family == AF_INET6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in);
+			}
+
+			uint16_t GetPort() const
+			{
+				return ntohs(family == AF_INET6 ? address.ipv6.sin6_port : address.ipv4.sin_port);
+			}
 		};
 
 
@@ -116,7 +198,7 @@ namespace Cf
 			//		  NORMAL. More information in RFC 8866 5.8.
 			// "AS" = Application specific. The application's concept of the
 			//		  maximum bandwidth. Mux category is SUM. 
-			std::string type;
+			Token type;
 
 			// <bandwidth>
 			// The bandwidth limit
@@ -228,11 +310,11 @@ namespace Cf
 			struct RTP
 			{
 				int32_t payload;
-				std::string codec;
+				FixedString<31> codec;
 				int32_t rate;
-				std::string encoding;
+				Token encoding;
 			};
-			std::vector<RTP> rtp_map;
+			SmallVector<RTP, 2> rtp_map;
 
 			// example: a=fmtp:108 profile-level-id=24;object=23;bitrate=64000
 			struct FMTP
@@ -240,15 +322,15 @@ namespace Cf
 				int32_t payload;
 				std::string config;
 			};
-			std::vector<FMTP> fmtp;
+			SmallVector<FMTP, 2> fmtp;
 
 			// example: a=source-filter: incl IN IP4 239.5.2.31 10.1.15.5
 			struct SourceFilter
 			{
 				std::string filter_mode;
-				std::string net_type;
-				std::string address_types;
-				std::string dest_address;
+				Token net_type;
+				Token address_types;
+				Address dest_address;
 				std::string src_list;
 			};
 			SourceFilter source_filter;
@@ -265,13 +347,75 @@ namespace Cf
 				std::string dir2;
 				std::string attrs2;
 			};
-			std::vector<ImageAttributes> image_attributes;
+			SmallVector<ImageAttributes, 1> image_attributes;
 
-			// example: a=mediaclk:direct=0
-			std::string media_clock;
+			// Reference clock of the RTP timestamps. More than one when the
+			// sender is locked to several equivalent grandmasters.
+			// examples:
+			// a=ts-refclk:ptp=IEEE1588-2008:00-50-C2-FF-FE-90-04-37:0
+			// a=ts-refclk:ptp=IEEE1588-2008:traceable
+			// a=ts-refclk:localmac=7C-E9-D3-1B-9A-AF
+			struct ReferenceClock
+			{
+				SDPClockSource source = SDPClockSource::UNKNOWN;
+
+				// PTP only
+				SDPPtpVersion ptp_version = SDPPtpVersion::UNKNOWN;
+				uint64_t grandmaster_id = 0;	// EUI-64, first octet highest
+				uint8_t domain = 0;
+
+				// Any grandmaster traceable to TAI/UTC will do, no
+				// grandmaster ID given
+				bool traceable = false;
+
+				// LOCALMAC only. EUI-48 in the low 48 bits.
+				uint64_t local_mac = 0;
+			};
+			SmallVector<ReferenceClock, 2> reference_clocks;
+
+			// How RTP timestamps follow the reference clock. UNKNOWN if
+			// not present.
+			// examples:
+			// a=mediaclk:direct=0
+			// a=mediaclk:direct=963214424 rate=1000/1001
+			struct MediaClock
+			{
+				SDPMediaClockSource source = SDPMediaClockSource::UNKNOWN;
+
+				// DIRECT only. RTP timestamp at the epoch of the reference
+				// clock, and the media clock rate relative to the nominal
+				// one.
+				uint32_t offset = 0;
+				Rational rate = Rational(1, 1);
+			};
+			MediaClock media_clock;
 
 			// example: a=framerate:29.97
 			float framerate;
+
+			// Packet time in milliseconds, 0 if not present.
+			// example: a=ptime:0.125
+			double ptime = 0;
+
+			/// <summary>
+			/// Clear: Empties all attributes, keeping the capacity of the
+			///		   containers and strings for the next parse.
+			/// </summary>
+			void Clear()
+			{
+				rtp_map.clear();
+				fmtp.clear();
+				source_filter.filter_mode.clear();
+				source_filter.net_type.clear();
+				source_filter.address_types.clear();
+				source_filter.dest_address.clear();
+				source_filter.src_list.clear();
+				image_attributes.clear();
+				reference_clocks.clear();
+				media_clock = {};
+				framerate = 0;
+				ptime = 0;
+			}
 		};
 
 
@@ -285,63 +429,114 @@ namespace Cf
 			// make class polymorphic so that dynamic_pointer_cast<>() works
 			virtual ~MediaDescription() = default;
 
+			MediaDescription() = default;
+			MediaDescription(json session) : m_session(std::move(session)) {}
+
+			// The virtual destructor suppresses the implicit moves, which
+			// media_descriptions and parser reuse depend on.
+			MediaDescription(const MediaDescription&) = default;
+			MediaDescription(MediaDescription&&) = default;
+			MediaDescription& operator=(const MediaDescription&) = default;
+			MediaDescription& operator=(MediaDescription&&) = default;
+
 			json m_session; // Media Source Session
 			SDPMediaType m_type;
 
 			/// Top Level Params for all Media Descriptions
 			std::string payloads;
 			int32_t port = 0;
+
+			// payloads as numbers, in "m=" order
+			SmallVector<int32_t, 4> payload_types;
 			std::string protocol;
 			Attributes attributes;
-		};
 
+			// Connection Information ("c="). Falls back to the session level
+			// "c=" when the media description has none.
+			ConnectionInformation connection_information;
 
-		/// <summary>
-		/// VideoSource: Class to encapsulate a video media description from an 
-		///				 SDP. 
-		/// </summary>
-		class VideoDescription : public MediaDescription
-		{
-		private:
-			json m_video_params_session;
+			// Connection information, port, and source filter resolved into
+			// a ready-to-use socket endpoint.
+			Endpoint endpoint;
 
-		public:
-			VideoDescription(json video_description)
+			// Media identification ("a=mid:"). Used to look up a media
+			// description by mid (RFC 5888), empty if not present.
+			std::string mid;
+
+			// Reference clocks and media clock of this media description,
+			// falling back to the session level ones.
+			SmallVector<Attributes::ReferenceClock, 2> reference_clocks;
+			Attributes::MediaClock media_clock;
+
+			// RTP timestamp <-> TAI conversions at the rtpmap clock rate
+			// with the media clock's offset and rate.
+			RtpClock rtp_clock;
+
+		protected:
+
+			/// <summary>
+			/// Reset: Readies a previously parsed media description for the
+			///		   given media session, keeping string and container
+			///		   capacity.
+			/// </summary>
+			void Reset(json session)
 			{
-				m_session = video_description;
-				m_type = SDPMediaType::VIDEO;
+				m_session = std::move(session);
+				payloads.clear();
+				payload_types.clear();
+				port = 0;
+				protocol.clear();
+				attributes.Clear();
+				connection_information.addr_type = 4;
+				connection_information.connection_address.clear();
+				connection_information.ttl = 0;
+				endpoint.Clear();
+				mid.clear();
+				reference_clocks.clear();
+				media_clock = {};
+				rtp_clock = RtpClock();
 			}
+		};
 
-			/// Top Level Params
-			ConnectionInformation connection_information;
 
+		/// <summary>
+		/// VideoParameters: Video parameters of a video media description,
+		///					 each with the value it has when the SDP does not
+		///					 set it.
+		/// </summary>
+		struct VideoParameters
+		{
+		public:
 			/// Video Params
-			int32_t width;
-			int32_t height;
+			int32_t width = 0;
+			int32_t height = 0;
 
 			// In SDP, specified as "SSN". Mandatory for uncompressed. Not
 			// mandatory for compressed.
-			SDPStandard standard;
+			SDPStandard standard = SDPStandard::UNCOMPRESSED;
 
 			// For uncompressed video, specified as a format specific parameter 
 			// in SDP as "exactframerate".
 			// For compresed video, can be described like uncompressed, or as 
 			// an attribute "framerate".
-			int32_t framerate_num;
-			int32_t framerate_den;
+			Rational framerate;
+
+			// Frame duration, RTP ticks per frame and frame <-> RTP timestamp
+			// conversions for framerate at the rtpmap clock rate.
+			FrameTiming frame_timing;
 
 			/// COMPRESSED
 			// Mandatory Format Specific Parameters
-			SDP_TP tp;
+			SDP_TP tp = SDP_TP::NARROW;
 			// Optional Format Specific Parameters
-			int32_t cmax;
+			int32_t cmax = 0;
 
 			/// UNCOMPRESSED
 			// Required Media Type Parameters
-			SDPSampling sampling;
-			SDPDepth depth;
-			SDPColorimetry colorimetry;
-			SDPPackingMode packing_mode; // In SDP, specified as "PM"
+			SDPSampling sampling = {};
+			SDPDepth depth = {};
+			SDPColorimetry colorimetry = {};
+			SDPPackingMode packing_mode = {}; // In SDP, specified as "PM"
 
 			// Media Type Parameters with Default Values
 			bool interlaced = false; // true = interlaced, false = progressive
@@ -361,6 +556,35 @@ namespace Cf
 		};
 
 
+		/// <summary>
+		/// VideoSource: Class to encapsulate a video media description from an 
+		///				 SDP. 
+		/// </summary>
+		class VideoDescription : public MediaDescription, public VideoParameters
+		{
+		private:
+			json m_video_params_session;
+
+		public:
+			VideoDescription(json video_description)
+				: MediaDescription(std::move(video_description))
+			{
+				m_type = SDPMediaType::VIDEO;
+			}
+
+			/// <summary>
+			/// Reset: Readies this description for reuse by SDPParser with the
+			///		   given video media session. The video parameters go back
+			///		   to their defaults, as in a new description.
+			/// </summary>
+			void Reset(json video_description)
+			{
+				MediaDescription::Reset(std::move(video_description));
+				static_cast<VideoParameters&>(*this) = VideoParameters();
+			}
+		};
+
+
 		/// <summary>
 		/// VideoSource: Class to encapsulate an audio media description from
 		///				 an SDP. 
@@ -369,11 +593,24 @@ namespace Cf
 		{
 		public:
 			AudioDescription(json audio_description)
+				: MediaDescription(std::move(audio_description))
 			{
-				m_session = audio_description;
 				m_type = SDPMediaType::AUDIO;
 			}
 
+			/// <summary>
+			/// Reset: Readies this description for reuse by SDPParser with the
+			///		   given audio media session.
+			/// </summary>
+			void Reset(json audio_description)
+			{
+				MediaDescription::Reset(std::move(audio_description));
+				channel_order.clear();
+				channel_groups.clear();
+				channel_count = 0;
+				channel_map.clear();
+			}
+
 			// In the SMPTE2110 channel-order convention, the <order> shall be 
 			// a listing of Channel Grouping Symbols contained within 
 			// parenthesis and separated by commas. 
@@ -391,8 +628,34 @@ namespace Cf
 			// 222 (22.2 Surround), 24 channels. Order: see SMPTE ST 2036-2, Table 1
 			// SGRP (One SDI audio group), 4 channels. Order: 1, 2, 3, 4
 			// U01-U64 (Undefined), channel indicated by grouping symbol nn. No order specified.
+			//
+			// Raw order listing, e.g. "M,M,M,M,ST,U02".
 			std::string channel_order;
 
+			// One channel group of the channel order.
+			struct ChannelGroup
+			{
+				SDPChannelGroup symbol;
+				int32_t first_channel;
+				int32_t channel_count;
+			};
+
+			// Group and role of one channel.
+			struct ChannelAssignment
+			{
+				uint16_t group_index;
+				SDPChannelRole role;
+			};
+
+			// channel_order parsed into its groups, in order.
+			SmallVector<ChannelGroup, 4> channel_groups;
+
+			// Total channels described by channel_order
+			int32_t channel_count = 0;
+
+			// Channel index -> (group, role), one entry per channel.
+			SmallVector<ChannelAssignment, 16> channel_map;
+
 		};
 
 		class DataDescription : public MediaDescription
@@ -401,14 +664,28 @@ namespace Cf
 			//json m_data_params_session;
 		public:
 			DataDescription(json data_description)
+				: MediaDescription(std::move(data_description))
 			{
-				m_session = data_description;
 				//m_data_params_session = parseParams(m_session.at("fmtp")[0].at("config"));
 				m_type = SDPMediaType::DATA;
 			}
+
+			void Reset(json data_description)
+			{
+				MediaDescription::Reset(std::move(data_description));
+			}
 		};
 
 
+		/// <summary>
+		/// MediaVariant: One media description stored by value. Media
+		///				  descriptions are kept contiguously as variants so
+		///				  that typed lookups need no RTTI, heap indirection,
+		///				  or copies.
+		/// </summary>
+		using MediaVariant = std::variant<VideoDescription, AudioDescription, DataDescription>;
+
+
 	public:
 
 		// Protocol Version ("v="). REQUIRED.
@@ -456,7 +733,7 @@ namespace Cf
 		// Denotes the proposed bandwidth to be used by the session or media
 		// description.
 		// b = <bwtype>:<bandwidth>
-		std::vector<BandwidthInformation> bandwidth_informations;
+		SmallVector<BandwidthInformation, 2> bandwidth_informations;
 
 
 		// Time Descriptions. One REQUIRED. More can be added.
@@ -484,59 +761,173 @@ namespace Cf
 		// A session description may contain a number of media descriptions. 
 		// Each media description starts with an "m=" line (media-field) and is 
 		// terminated by either the next "m=" line or by the end of the session 
-		// description.
-		std::vector<shared_ptr<MediaDescription>> media_descriptions;
+		// description. Stored in SDP order.
+		std::vector<MediaVariant> media_descriptions;
+
+		// Positions into media_descriptions for each media type, and for
+		// each "a=mid:" value. Built once at parse time so typed lookups are
+		// O(1).
+		std::vector<uint32_t> video_indices;
+		std::vector<uint32_t> audio_indices;
+		std::vector<uint32_t> data_indices;
+		std::unordered_map<std::string, uint32_t> mid_indices;
+
+
+		/// <summary>
+		/// Clear: Empties the SDP for the next parse while keeping the
+		///		   capacity of its strings and containers. Media descriptions
+		///		   are destroyed, see SDPParser::Reset() for how they are 
+		///		   reused.
+		/// </summary>
+		void Clear()
+		{
+			protocol_version = 0;
+			origin.username.clear();
+			origin.sess_id = 0;
+			origin.sess_version = 0;
+			origin.net_type.clear();
+			origin.addr_type = 0;
+			origin.unicast_address.clear();
+			session_name.clear();
+			session_information.clear();
+			uri.clear();
+			email_address.clear();
+			phone_number.clear();
+			connection_information.addr_type = 4;
+			connection_information.connection_address.clear();
+			connection_information.ttl = 0;
+			bandwidth_informations.clear();
+			time_description.time_active = {};
+			attributes.Clear();
+			media_descriptions.clear();
+			video_indices.clear();
+			audio_indices.clear();
+			data_indices.clear();
+			mid_indices.clear();
+		}
+
+
+		/// <summary>
+		/// GetMedia: Returns the common part of the media description at 
+		///			  the given position in SDP order.
+		/// </summary>
+		const MediaDescription& GetMedia(size_t index) const
+		{
+			return std::visit([](const MediaDescription& media) -> const MediaDescription& { return media; },
+				media_descriptions[index]);
+		}
+
+
+		/// <summary>
+		/// GetMediaByMid: Returns the media description tagged with the given
+		///				   "a=mid:" value, or nullptr if there is none.
+		/// </summary>
+		const MediaDescription* GetMediaByMid(const std::string& mid) const
+		{
+			auto iter = mid_indices.find(mid);
+			if (iter == mid_indices.end())
+				return nullptr;
+
+			return &GetMedia(iter->second);
+		}
+
+
+		/// <summary>
+		/// GetVideo: Returns the n-th video description in SDP order.
+		/// </summary>
+		const VideoDescription& GetVideo(size_t n) const
+		{
+			return *std::get_if<VideoDescription>(&media_descriptions[video_indices[n]]);
+		}
+		size_t GetVideoCount() const { return video_indices.size(); }
+
+
+		/// <summary>
+		/// GetAudio: Returns the n-th audio description in SDP order.
+		/// </summary>
+		const AudioDescription& GetAudio(size_t n) const
+		{
+			return *std::get_if<AudioDescription>(&media_descriptions[audio_indices[n]]);
+		}
+		size_t GetAudioCount() const { return audio_indices.size(); }
+
+
+		/// <summary>
+		/// GetData: Returns the n-th data description in SDP order.
+		/// </summary>
+		const DataDescription& GetData(size_t n) const
+		{
+			return *std::get_if<DataDescription>(&media_descriptions[data_indices[n]]);
+		}
+		size_t GetDataCount() const { return data_indices.size(); }
+
+
+		/// <summary>
+		/// GetFirstVideo: Returns the first video description, or nullptr if
+		///				   the SDP has none.
+		/// </summary>
+		const VideoDescription* GetFirstVideo() const
+		{
+			return video_indices.empty() ? nullptr : &GetVideo(0);
+		}
 
 
 		/// <summary>
 		/// GetVideoHost: Returns video host for from this SDP for use in 
-		///				  SwxtchSourceFilter.
+		///				  SwxtchSourceFilter. The view is valid as long as
+		///				  this SDP is.
 		/// </summary>
-		std::string GetVideoHost()
+		std::string_view GetVideoHost() const
 		{
 			if (media_descriptions.size() == 0)
 				throw std::runtime_error("SDP::GetVideoHost: No media descriptions in SDP");
 
-			for (int i = 0; i < media_descriptions.size(); i++)
-			{
-				if (media_descriptions[i]->m_type == SDPMediaType::VIDEO)
-				{
-					VideoDescription video_description = dynamic_cast<VideoDescription&>(*media_descriptions[i]);
-					if (video_description.connection_information.connection_address == "")
-						throw std::runtime_error("SDP::GetVideoHost: Video host not set in SDP");
-
-					return video_description.connection_information.connection_address;
-				}
-			}
+			const VideoDescription* video_description = GetFirstVideo();
+			if (video_description == nullptr)
+				throw std::runtime_error("SDP::GetVideoHost: Video host not found in SDP");
 
-			throw std::runtime_error("SDP::GetVideoPort: Video port not found in SDP");
+			if (video_description->connection_information.connection_address.empty())
+				throw std::runtime_error("SDP::GetVideoHost: Video host not set in SDP");
+
+			return video_description->connection_information.connection_address.view();
 		}
 		
 
+		/// <summary>
+		/// GetVideoEndpoint: Returns the resolved socket endpoint of the first
+		///					  video description in this SDP.
+		/// </summary>
+		const Endpoint& GetVideoEndpoint() const
+		{
+			const VideoDescription* video_description = GetFirstVideo();
+			if (video_description == nullptr)
+				throw std::runtime_error("SDP::GetVideoEndpoint: No video description in SDP");
+
+			if (!video_description->endpoint.IsResolved())
+				throw std::runtime_error("SDP::GetVideoEndpoint: Video endpoint could not be resolved from SDP");
+
+			return video_description->endpoint;
+		}
+
+
 		/// <summary>
 		/// GetVideoPort:: Returns video port for from this SDP for use in 
 		///				   SwxtchSourceFilter.
 		/// </summary>
-		std::string GetVideoPort()
+		std::string GetVideoPort() const
 		{
 			if (media_descriptions.size() == 0)
 				throw std::runtime_error("SDP::GetVideoPort: No media descriptions in SDP");
 
-			for (int i = 0; i < media_descriptions.size(); i++)
-			{
-				if (media_descriptions[i]->m_type == SDPMediaType::VIDEO)
-				{
-					if (media_descriptions[i]->port == 0)
-						throw std::runtime_error("SDP::GetVideoPort: Video port not set in SDP");
-					
-					return std::to_string(media_descriptions[i]->port);
-				}
-			}
+			const VideoDescription* video_description = GetFirstVideo();
+			if (video_description == nullptr)
+				throw std::runtime_error("SDP::GetVideoPort: Video port not found in SDP");
 
-			throw std::runtime_error("SDP::GetVideoPort: Video port not found in SDP");
+			if (video_description->port == 0)
+				throw std::runtime_error("SDP::GetVideoPort: Video port not set in SDP");
+
+			return std::to_string(video_description->port);
 		}
 
 	};
 }
-
-	
\ No newline at end of file
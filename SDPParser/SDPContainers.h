@@ -0,0 +1,382 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	/// <summary>
+	/// SmallVector: Vector that stores up to N elements inline and only
+	///				 moves to the heap beyond that. Most SDP lists (rtpmap,
+	///				 fmtp, source addresses, ...) hold one to four entries,
+	///				 so they never allocate.
+	/// </summary>
+	template<typename T, size_t N>
+	class SmallVector
+	{
+		static_assert(N > 0, "SmallVector: inline capacity must be at least one");
+
+	public:
+		using value_type = T;
+		using size_type = size_t;
+		using reference = T&;
+		using const_reference = const T&;
+		using iterator = T*;
+		using const_iterator = const T*;
+
+		SmallVector() = default;
+
+		SmallVector(std::initializer_list<T> values)
+		{
+			reserve(values.size());
+			for (const T& value : values)
+				push_back(value);
+		}
+
+		SmallVector(const SmallVector& other)
+		{
+			reserve(other.m_size);
+			std::uninitialized_copy(other.begin(), other.end(), m_data);
+			m_size = other.m_size;
+		}
+
+		SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			MoveFrom(other);
+		}
+
+		~SmallVector()
+		{
+			clear();
+			Deallocate();
+		}
+
+		SmallVector& operator=(const SmallVector& other)
+		{
+			if (this != &other)
+			{
+				clear();
+				reserve(other.m_size);
+				std::uninitialized_copy(other.begin(), other.end(), m_data);
+				m_size = other.m_size;
+			}
+
+			return *this;
+		}
+
+		SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this != &other)
+			{
+				clear();
+				Deallocate();
+				MoveFrom(other);
+			}
+
+			return *this;
+		}
+
+		iterator begin() { return m_data; }
+		iterator end() { return m_data + m_size; }
+		const_iterator begin() const { return m_data; }
+		const_iterator end() const { return m_data + m_size; }
+
+		T* data() { return m_data; }
+		const T* data() const { return m_data; }
+
+		size_t size() const { return m_size; }
+		size_t capacity() const { return m_capacity; }
+		bool empty() const { return m_size == 0; }
+
+		// True while the elements are stored inline
+		bool IsInline() const { return m_data == Inline(); }
+
+		T& operator[](size_t index) { return m_data[index]; }
+		const T& operator[](size_t index) const { return m_data[index]; }
+
+		T& front() { return m_data[0]; }
+		const T& front() const { return m_data[0]; }
+		T& back() { return m_data[m_size - 1]; }
+		const T& back() const { return m_data[m_size - 1]; }
+
+		void reserve(size_t capacity)
+		{
+			if (capacity > m_capacity)
+				Reallocate(capacity);
+		}
+
+		template<typename... Args>
+		T& emplace_back(Args&&... args)
+		{
+			if (m_size < m_capacity)
+				return *std::construct_at(m_data + m_size++, std::forward<Args>(args)...);
+
+			// Construct the new element before moving the old ones, args may
+			// refer to an element of this vector.
+			size_t capacity = m_capacity * 2;
+			T* data = std::allocator<T>().allocate(capacity);
+			try
+			{
+				std::construct_at(data + m_size, std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				std::allocator<T>().deallocate(data, capacity);
+				throw;
+			}
+
+			std::uninitialized_move(begin(), end(), data);
+			std::destroy(begin(), end());
+			Deallocate();
+
+			m_data = data;
+			m_capacity = capacity;
+			return m_data[m_size++];
+		}
+
+		void push_back(const T& value) { emplace_back(value); }
+		void push_back(T&& value) { emplace_back(std::move(value)); }
+
+		void pop_back()
+		{
+			std::destroy_at(m_data + --m_size);
+		}
+
+		void resize(size_t size)
+		{
+			if (size < m_size)
+			{
+				std::destroy(m_data + size, end());
+			}
+			else
+			{
+				reserve(size);
+				std::uninitialized_value_construct(end(), m_data + size);
+			}
+
+			m_size = size;
+		}
+
+		// Destroys the elements, keeping the capacity
+		void clear()
+		{
+			std::destroy(begin(), end());
+			m_size = 0;
+		}
+
+	private:
+		T* Inline() { return reinterpret_cast<T*>(m_inline); }
+		const T* Inline() const { return reinterpret_cast<const T*>(m_inline); }
+
+		void Reallocate(size_t capacity)
+		{
+			T* data = std::allocator<T>().allocate(capacity);
+			std::uninitialized_move(begin(), end(), data);
+			std::destroy(begin(), end());
+			Deallocate();
+
+			m_data = data;
+			m_capacity = capacity;
+		}
+
+		void Deallocate()
+		{
+			if (!IsInline())
+				std::allocator<T>().deallocate(m_data, m_capacity);
+
+			m_data = Inline();
+			m_capacity = N;
+		}
+
+		// Expects this to be empty and inline
+		void MoveFrom(SmallVector& other)
+		{
+			if (other.IsInline())
+			{
+				std::uninitialized_move(other.begin(), other.end(), m_data);
+				m_size = other.m_size;
+				other.clear();
+				return;
+			}
+
+			m_data = other.m_data;
+			m_size = other.m_size;
+			m_capacity = other.m_capacity;
+
+			other.m_data = other.Inline();
+			other.m_size = 0;
+			other.m_capacity = N;
+		}
+
+		T* m_data = Inline();
+		size_t m_size = 0;
+		size_t m_capacity = N;
+		alignas(T) unsigned char m_inline[N * sizeof(T)];
+	};
+
+
+	/// <summary>
+	/// FixedString: String that stores up to N characters inline and only
+	///				 moves to the heap beyond that, for SDP fields that are
+	///				 usually short such as addresses, net types and codec
+	///				 names. Always null terminated.
+	/// </summary>
+	template<size_t N>
+	class FixedString
+	{
+	public:
+		FixedString() = default;
+		FixedString(std::string_view text) { assign(text); }
+		FixedString(const char* text) { assign(text); }
+
+		FixedString(const FixedString& other)
+		{
+			assign(other.view());
+		}
+
+		FixedString(FixedString&& other) noexcept
+		{
+			MoveFrom(other);
+		}
+
+		~FixedString()
+		{
+			Deallocate();
+		}
+
+		FixedString& operator=(const FixedString& other)
+		{
+			if (this != &other)
+				assign(other.view());
+
+			return *this;
+		}
+
+		FixedString& operator=(FixedString&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Deallocate();
+				MoveFrom(other);
+			}
+
+			return *this;
+		}
+
+		FixedString& operator=(std::string_view text)
+		{
+			assign(text);
+			return *this;
+		}
+
+		FixedString& operator=(const char* text)
+		{
+			assign(text);
+			return *this;
+		}
+
+		void assign(std::string_view text)
+		{
+			if (text.size() > m_capacity)
+			{
+				// Copy before releasing the old buffer, text may point into it
+				char* data = new char[text.size() + 1];
+				std::memcpy(data, text.data(), text.size());
+				Deallocate();
+
+				m_data = data;
+				m_capacity = text.size();
+			}
+			else
+			{
+				std::memmove(m_data, text.data(), text.size());
+			}
+
+			m_data[text.size()] = '\0';
+			m_size = text.size();
+		}
+
+		// Empties the string, keeping the capacity
+		void clear()
+		{
+			m_data[0] = '\0';
+			m_size = 0;
+		}
+
+		const char* c_str() const { return m_data; }
+		const char* data() const { return m_data; }
+		size_t size() const { return m_size; }
+		size_t length() const { return m_size; }
+		bool empty() const { return m_size == 0; }
+		size_t capacity() const { return m_capacity; }
+
+		// True while the characters are stored inline
+		bool IsInline() const { return m_data == m_inline; }
+
+		std::string_view view() const { return std::string_view(m_data, m_size); }
+		operator std::string_view() const { return view(); }
+		explicit operator std::string() const { return std::string(view()); }
+
+		friend bool operator==(const FixedString& left, const FixedString& right) { return left.view() == right.view(); }
+		friend bool operator==(const FixedString& left, std::string_view right) { return left.view() == right; }
+		friend bool operator==(const FixedString& left, const char* right) { return left.view() == right; }
+
+		friend std::ostream& operator<<(std::ostream& stream, const FixedString& text) { return stream << text.view(); }
+
+	private:
+		void Deallocate()
+		{
+			if (!IsInline())
+				delete[] m_data;
+
+			m_data = m_inline;
+			m_capacity = N;
+		}
+
+		// Expects this to be inline
+		void MoveFrom(FixedString& other)
+		{
+			if (other.IsInline())
+			{
+				std::memcpy(m_inline, other.m_inline, other.m_size + 1);
+				m_size = other.m_size;
+				other.clear();
+				return;
+			}
+
+			m_data = other.m_data;
+			m_size = other.m_size;
+			m_capacity = other.m_capacity;
+
+			other.m_data = other.m_inline;
+			other.m_capacity = N;
+			other.clear();
+		}
+
+		char* m_data = m_inline;
+		size_t m_size = 0;
+		size_t m_capacity = N;
+		char m_inline[N + 1] = {};
+	};
+}
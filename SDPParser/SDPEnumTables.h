@@ -0,0 +1,436 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	/// <summary>
+	/// SDPEnumEntry: One SDP token and the enum value it maps to.
+	/// </summary>
+	template<typename Enum>
+	struct SDPEnumEntry
+	{
+		std::string_view token;
+		Enum value;
+	};
+
+
+	/// <summary>
+	/// SDPEnumTable: Token table for one SDPEnums.h enum. Each table is the
+	///				  single source of truth for both directions of the
+	///				  mapping, so supporting a new 2110 value is a one line
+	///				  edit here. When two tokens map to the same value, the
+	///				  first one is used when formatting.
+	/// </summary>
+	template<typename Enum>
+	struct SDPEnumTable;
+
+	// m=<media> (RFC 8866 5.14)
+	template<>
+	struct SDPEnumTable<SDPMediaType>
+	{
+		static constexpr SDPEnumEntry<SDPMediaType> entries[] =
+		{
+			{ "video",			SDPMediaType::VIDEO },
+			{ "audio",			SDPMediaType::AUDIO },
+			{ "application",	SDPMediaType::DATA },
+		};
+	};
+
+	// colorimetry= (2110-20:2022 7.5)
+	template<>
+	struct SDPEnumTable<SDPColorimetry>
+	{
+		static constexpr SDPEnumEntry<SDPColorimetry> entries[] =
+		{
+			{ "BT601",			SDPColorimetry::BT601 },
+			{ "BT709",			SDPColorimetry::BT709 },
+			{ "BT2020",			SDPColorimetry::BT2020 },
+			{ "BT2100",			SDPColorimetry::BT2100 },
+			{ "ST2065-1",		SDPColorimetry::ST2065_1 },
+			{ "ST2065-3",		SDPColorimetry::ST2065_3 },
+			{ "UNSPECIFIED",	SDPColorimetry::UNSPECIFIED },
+			{ "XYZ",			SDPColorimetry::XYZ },
+			{ "ALPHA",			SDPColorimetry::ALPHA },
+		};
+	};
+
+	// sampling= (2110-20:2022 7.4.1)
+	template<>
+	struct SDPEnumTable<SDPSampling>
+	{
+		static constexpr SDPEnumEntry<SDPSampling> entries[] =
+		{
+			{ "YCbCr-4:4:4",	SDPSampling::YCBCR_444 },
+			{ "YCbCr-4:2:2",	SDPSampling::YCBCR_422 },
+			{ "YCbCr-4:2:0",	SDPSampling::YCBCR_420 },
+			{ "CLYCbCr-4:4:4",	SDPSampling::CLYCBCR_444 },
+			{ "CLYCbCr-4:2:2",	SDPSampling::CLYCBCR_422 },
+			{ "CLYCbCr-4:2:0",	SDPSampling::CLYCBCR_420 },
+			{ "ICtCp-4:4:4",	SDPSampling::ICTCP_444 },
+			{ "ICtCp-4:2:2",	SDPSampling::ICTCP_422 },
+			{ "ICtCp-4:2:0",	SDPSampling::ICTCP_420 },
+			{ "RGB",			SDPSampling::RGB },
+			{ "XYZ",			SDPSampling::XYZ },
+			{ "KEY",			SDPSampling::KEY },
+		};
+	};
+
+	// depth= (2110-20:2022 7.4.2)
+	template<>
+	struct SDPEnumTable<SDPDepth>
+	{
+		static constexpr SDPEnumEntry<SDPDepth> entries[] =
+		{
+			{ "8",				SDPDepth::INT_8 },
+			{ "10",				SDPDepth::INT_10 },
+			{ "12",				SDPDepth::INT_12 },
+			{ "16",				SDPDepth::INT_16 },
+			{ "16f",			SDPDepth::FLOAT_16 },
+		};
+	};
+
+	// PM= (2110-20:2022 6.3)
+	template<>
+	struct SDPEnumTable<SDPPackingMode>
+	{
+		static constexpr SDPEnumEntry<SDPPackingMode> entries[] =
+		{
+			{ "2110GPM",		SDPPackingMode::GPM },
+			{ "2110BPM",		SDPPackingMode::BPM },
+		};
+	};
+
+	// TCS= (2110-20:2022 7.6)
+	template<>
+	struct SDPEnumTable<SDPTransferCharacteristicSystem>
+	{
+		static constexpr SDPEnumEntry<SDPTransferCharacteristicSystem> entries[] =
+		{
+			{ "SDR",			SDPTransferCharacteristicSystem::SDR },
+			{ "PQ",				SDPTransferCharacteristicSystem::PQ },
+			{ "HLG",			SDPTransferCharacteristicSystem::HLG },
+			{ "LINEAR",			SDPTransferCharacteristicSystem::LINEAR },
+			{ "BT2100LINPQ",	SDPTransferCharacteristicSystem::BT2100LINPQ },
+			{ "BT2100LINHLG",	SDPTransferCharacteristicSystem::BT2100LINHLG },
+			{ "ST2065-1",		SDPTransferCharacteristicSystem::ST2065_1 },
+			{ "ST428-1",		SDPTransferCharacteristicSystem::ST428_1 },
+			{ "DENSITY",		SDPTransferCharacteristicSystem::DENSITY },
+			{ "ST2115LOGS3",	SDPTransferCharacteristicSystem::ST2115LOGS3 },
+			{ "UNSPECIFIED",	SDPTransferCharacteristicSystem::UNSPECIFIED },
+		};
+	};
+
+	// RANGE= (2110-20:2022 7.3)
+	template<>
+	struct SDPEnumTable<SDPRange>
+	{
+		static constexpr SDPEnumEntry<SDPRange> entries[] =
+		{
+			{ "NARROW",			SDPRange::NARROW },
+			{ "FULL",			SDPRange::FULL },
+			{ "FULLPROTECT",	SDPRange::FULLPROTECT },
+		};
+	};
+
+	// TP= (2110-21:2022)
+	template<>
+	struct SDPEnumTable<SDP_TP>
+	{
+		static constexpr SDPEnumEntry<SDP_TP> entries[] =
+		{
+			{ "2110TPN",		SDP_TP::NARROW },
+			{ "2110TPNL",		SDP_TP::NARROWLINEAR },
+			{ "2110TPW",		SDP_TP::WIDE },
+		};
+	};
+
+	// SSN= without the ":<year>" suffix (2110-20:2022 7.2, 2110-22:2022 7.2)
+	template<>
+	struct SDPEnumTable<SDPStandard>
+	{
+		static constexpr SDPEnumEntry<SDPStandard> entries[] =
+		{
+			{ "ST2110-20",		SDPStandard::UNCOMPRESSED },
+			{ "ST2110-22",		SDPStandard::JPEGXS },
+		};
+	};
+
+	// channel-order=SMPTE2110.(...) grouping symbols (2110-30:2017 Table 1).
+	// U01-U64 carry a channel count and are parsed separately.
+	template<>
+	struct SDPEnumTable<SDPChannelGroup>
+	{
+		static constexpr SDPEnumEntry<SDPChannelGroup> entries[] =
+		{
+			{ "M",				SDPChannelGroup::MONO },
+			{ "DM",				SDPChannelGroup::DUAL_MONO },
+			{ "ST",				SDPChannelGroup::STEREO },
+			{ "LtRt",			SDPChannelGroup::MATRIX_STEREO },
+			{ "51",				SDPChannelGroup::SURROUND_51 },
+			{ "71",				SDPChannelGroup::SURROUND_71 },
+			{ "222",			SDPChannelGroup::SURROUND_222 },
+			{ "SGRP",			SDPChannelGroup::SDI_GROUP },
+		};
+	};
+
+
+	// a=ts-refclk:<clksrc> (RFC 7273 4.8, 2110-10:2022 8.2)
+	template<>
+	struct SDPEnumTable<SDPClockSource>
+	{
+		static constexpr SDPEnumEntry<SDPClockSource> entries[] =
+		{
+			{ "ntp",			SDPClockSource::NTP },
+			{ "ptp",			SDPClockSource::PTP },
+			{ "gps",			SDPClockSource::GPS },
+			{ "gal",			SDPClockSource::GALILEO },
+			{ "glonass",		SDPClockSource::GLONASS },
+			{ "local",			SDPClockSource::LOCAL },
+			{ "private",		SDPClockSource::PRIVATE },
+			{ "localmac",		SDPClockSource::LOCALMAC },
+		};
+	};
+
+	// a=ts-refclk:ptp=<ptp-version> (RFC 7273 4.8)
+	template<>
+	struct SDPEnumTable<SDPPtpVersion>
+	{
+		static constexpr SDPEnumEntry<SDPPtpVersion> entries[] =
+		{
+			{ "IEEE1588-2002",		SDPPtpVersion::IEEE1588_2002 },
+			{ "IEEE1588-2008",		SDPPtpVersion::IEEE1588_2008 },
+			{ "IEEE1588-2019",		SDPPtpVersion::IEEE1588_2019 },
+			{ "IEEE802.1AS-2011",	SDPPtpVersion::IEEE802_1AS_2011 },
+		};
+	};
+
+	// a=mediaclk:<mediaclock> (RFC 7273 5)
+	template<>
+	struct SDPEnumTable<SDPMediaClockSource>
+	{
+		static constexpr SDPEnumEntry<SDPMediaClockSource> entries[] =
+		{
+			{ "direct",			SDPMediaClockSource::DIRECT },
+			{ "sender",			SDPMediaClockSource::SENDER },
+			{ "IEEE1722",		SDPMediaClockSource::IEEE1722 },
+		};
+	};
+
+
+	namespace SDPEnumDetail
+	{
+		constexpr uint8_t EMPTY_SLOT = 0xff;
+
+		/// <summary>
+		/// Hash: FNV-1a of the token, perturbed by a seed so that a collision
+		///		  free seed can be searched for at compile time.
+		/// </summary>
+		constexpr uint32_t Hash(std::string_view token, uint32_t seed)
+		{
+			uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+			for (char c : token)
+			{
+				hash ^= (uint8_t)c;
+				hash *= 16777619u;
+			}
+			return hash ^ (hash >> 15);
+		}
+
+
+		/// <summary>
+		/// PerfectHash: Open table with at least twice as many slots as
+		///				 tokens, and a seed under which every token lands in
+		///				 its own slot. A lookup is one hash and one compare.
+		/// </summary>
+		template<size_t N>
+		struct PerfectHash
+		{
+			static constexpr size_t SIZE = std::bit_ceil(N * 2);
+
+			uint32_t seed = 0;
+			std::array<uint8_t, SIZE> slots = {};
+		};
+
+		template<typename Enum, size_t N>
+		consteval PerfectHash<N> BuildPerfectHash(const SDPEnumEntry<Enum>(&entries)[N])
+		{
+			static_assert(N < EMPTY_SLOT, "SDP enum table too large for 8 bit slots");
+
+			PerfectHash<N> result;
+			for (uint32_t seed = 0; seed < 100000; seed++)
+			{
+				result.seed = seed;
+				result.slots.fill(EMPTY_SLOT);
+
+				bool collision = false;
+				for (size_t i = 0; i < N && !collision; i++)
+				{
+					size_t slot = Hash(entries[i].token, seed) & (PerfectHash<N>::SIZE - 1);
+					if (result.slots[slot] != EMPTY_SLOT)
+						collision = true;
+					else
+						result.slots[slot] = (uint8_t)i;
+				}
+
+				if (!collision)
+					return result;
+			}
+
+			throw "SDPEnumDetail::BuildPerfectHash: No collision free seed found";
+		}
+
+
+		/// <summary>
+		/// Reverse: Table index for each underlying enum value, so formatting
+		///			 an enum is a single array read.
+		/// </summary>
+		template<typename Enum, size_t N>
+		consteval size_t ReverseSize(const SDPEnumEntry<Enum>(&entries)[N])
+		{
+			size_t max_value = 0;
+			for (size_t i = 0; i < N; i++)
+				max_value = std::max(max_value, (size_t)entries[i].value);
+
+			return max_value + 1;
+		}
+
+		template<size_t SIZE, typename Enum, size_t N>
+		consteval std::array<uint8_t, SIZE> BuildReverse(const SDPEnumEntry<Enum>(&entries)[N])
+		{
+			std::array<uint8_t, SIZE> result = {};
+			result.fill(EMPTY_SLOT);
+
+			// First token wins for values listed more than once
+			for (size_t i = N; i-- > 0;)
+				result[(size_t)entries[i].value] = (uint8_t)i;
+
+			return result;
+		}
+	}
+
+
+	/// <summary>
+	/// SDPEnumLookup: Compile-time generated lookup structures for one
+	///				   SDPEnumTable.
+	/// </summary>
+	template<typename Enum>
+	struct SDPEnumLookup
+	{
+		static constexpr auto& entries = SDPEnumTable<Enum>::entries;
+		static constexpr auto hash = SDPEnumDetail::BuildPerfectHash(entries);
+		static constexpr auto reverse = SDPEnumDetail::BuildReverse<SDPEnumDetail::ReverseSize(entries)>(entries);
+	};
+
+
+	/// <summary>
+	/// SDPEnumFromString: Maps an SDP token to its enum value. Returns
+	///					   std::nullopt for tokens not in the table.
+	/// </summary>
+	template<typename Enum>
+	constexpr std::optional<Enum> SDPEnumFromString(std::string_view token)
+	{
+		using Lookup = SDPEnumLookup<Enum>;
+
+		size_t slot = SDPEnumDetail::Hash(token, Lookup::hash.seed) & (Lookup::hash.SIZE - 1);
+		uint8_t index = Lookup::hash.slots[slot];
+		if (index == SDPEnumDetail::EMPTY_SLOT || Lookup::entries[index].token != token)
+			return std::nullopt;
+
+		return Lookup::entries[index].value;
+	}
+
+
+	/// <summary>
+	/// SDPEnumToString: Maps an enum value back to its SDP token. Returns an
+	///					 empty view for values without a token (e.g.
+	///					 SDPMediaType::UNKNOWN).
+	/// </summary>
+	template<typename Enum>
+	constexpr std::string_view SDPEnumToString(Enum value)
+	{
+		using Lookup = SDPEnumLookup<Enum>;
+
+		size_t raw = (size_t)value;
+		if (raw >= Lookup::reverse.size() || Lookup::reverse[raw] == SDPEnumDetail::EMPTY_SLOT)
+			return {};
+
+		return Lookup::entries[Lookup::reverse[raw]].token;
+	}
+
+
+	namespace SDPEnumDetail
+	{
+		using R = SDPChannelRole;
+		inline constexpr R MONO_ROLES[] = { R::MONO };
+		inline constexpr R DUAL_MONO_ROLES[] = { R::M1, R::M2 };
+		inline constexpr R STEREO_ROLES[] = { R::LEFT, R::RIGHT };
+		inline constexpr R MATRIX_STEREO_ROLES[] = { R::LEFT_TOTAL, R::RIGHT_TOTAL };
+		inline constexpr R SURROUND_51_ROLES[] = { R::LEFT, R::RIGHT, R::CENTER, R::LFE, R::LEFT_SURROUND, R::RIGHT_SURROUND };
+		inline constexpr R SURROUND_71_ROLES[] = { R::LEFT, R::RIGHT, R::CENTER, R::LFE,
+			R::LEFT_SIDE_SURROUND, R::RIGHT_SIDE_SURROUND, R::LEFT_REAR_SURROUND, R::RIGHT_REAR_SURROUND };
+		inline constexpr R SURROUND_222_ROLES[] = { R::FL, R::FR, R::FC, R::LFE1, R::BL, R::BR, R::FLC, R::FRC,
+			R::BC, R::LFE2, R::SIL, R::SIR, R::TPFL, R::TPFR, R::TPFC, R::TPC, R::TPBL, R::TPBR,
+			R::TPSIL, R::TPSIR, R::TPBC, R::BTFC, R::BTFL, R::BTFR };
+		inline constexpr R SDI_GROUP_ROLES[] = { R::SDI_1, R::SDI_2, R::SDI_3, R::SDI_4 };
+	}
+
+
+	/// <summary>
+	/// SDPChannelGroupRoles: Channel roles of a grouping symbol in channel
+	///						  order. Empty for UNDEFINED (Unn) groups, whose
+	///						  channels have no order.
+	/// </summary>
+	constexpr std::span<const SDPChannelRole> SDPChannelGroupRoles(SDPChannelGroup group)
+	{
+		switch (group)
+		{
+		case SDPChannelGroup::MONO: return SDPEnumDetail::MONO_ROLES;
+		case SDPChannelGroup::DUAL_MONO: return SDPEnumDetail::DUAL_MONO_ROLES;
+		case SDPChannelGroup::STEREO: return SDPEnumDetail::STEREO_ROLES;
+		case SDPChannelGroup::MATRIX_STEREO: return SDPEnumDetail::MATRIX_STEREO_ROLES;
+		case SDPChannelGroup::SURROUND_51: return SDPEnumDetail::SURROUND_51_ROLES;
+		case SDPChannelGroup::SURROUND_71: return SDPEnumDetail::SURROUND_71_ROLES;
+		case SDPChannelGroup::SURROUND_222: return SDPEnumDetail::SURROUND_222_ROLES;
+		case SDPChannelGroup::SDI_GROUP: return SDPEnumDetail::SDI_GROUP_ROLES;
+		default: return {};
+		}
+	}
+
+
+	/// <summary>
+	/// operator<<: Streams any table-backed SDP enum as its SDP token, so
+	///				enums can be logged directly.
+	/// </summary>
+	template<typename Enum, typename = decltype(SDPEnumTable<Enum>::entries)>
+	std::ostream& operator<<(std::ostream& stream, Enum value)
+	{
+		std::string_view token = SDPEnumToString(value);
+		if (token.empty())
+			return stream << "UNKNOWN(" << (int32_t)value << ")";
+
+		return stream << token;
+	}
+}
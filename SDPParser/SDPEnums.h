@@ -76,15 +76,23 @@ namespace Cf
 	};
 
 	// Specified in 2110_20:2022 7.4.2
+	// Integer depths carry their bit count as value. FLOAT_16 must differ
+	// from INT_16 so "16f" is not read back as "16"; use SDPDepthBits() 
+	// for the sample width.
 	enum class SDPDepth
 	{
 		INT_8 = 8,
 		INT_10 = 10,
 		INT_12 = 12,
 		INT_16 = 16,
-		FLOAT_16 = 16
+		FLOAT_16 = 17
 	};
 
+	constexpr int32_t SDPDepthBits(SDPDepth depth)
+	{
+		return depth == SDPDepth::FLOAT_16 ? 16 : (int32_t)depth;
+	}
+
 	// Specified in 2110-20:2022 6.3
 	enum class SDPPackingMode
 	{
@@ -129,4 +137,75 @@ namespace Cf
 		UNCOMPRESSED,
 		JPEGXS
 	};
+
+	// Channel Grouping Symbols for the SMPTE2110 channel-order convention
+	// (2110-30:2017 Table 1)
+	enum class SDPChannelGroup : uint8_t
+	{
+		MONO,			// M, 1 channel
+		DUAL_MONO,		// DM, 2 channels
+		STEREO,			// ST, 2 channels
+		MATRIX_STEREO,	// LtRt, 2 channels
+		SURROUND_51,	// 51, 6 channels
+		SURROUND_71,	// 71, 8 channels
+		SURROUND_222,	// 222, 24 channels
+		SDI_GROUP,		// SGRP, 4 channels
+		UNDEFINED		// U01-U64, nn channels
+	};
+
+	// Role of one channel within its channel group (2110-30:2017 Table 1)
+	enum class SDPChannelRole : uint8_t
+	{
+		MONO,
+		M1, M2,
+		LEFT, RIGHT,
+		LEFT_TOTAL, RIGHT_TOTAL,
+		CENTER, LFE,
+		LEFT_SURROUND, RIGHT_SURROUND,
+		LEFT_SIDE_SURROUND, RIGHT_SIDE_SURROUND,
+		LEFT_REAR_SURROUND, RIGHT_REAR_SURROUND,
+
+		// 22.2 channel labels in SMPTE ST 2036-2 Table 1 order
+		FL, FR, FC, LFE1, BL, BR, FLC, FRC, BC, LFE2, SIL, SIR,
+		TPFL, TPFR, TPFC, TPC, TPBL, TPBR, TPSIL, TPSIR, TPBC, BTFC, BTFL, BTFR,
+
+		// One SDI audio group
+		SDI_1, SDI_2, SDI_3, SDI_4,
+
+		UNDEFINED
+	};
+
+	// Clock source of a reference clock, "a=ts-refclk:<source>" (RFC 7273
+	// 4.8, localmac from 2110-10:2022 8.2)
+	enum class SDPClockSource : uint8_t
+	{
+		NTP,
+		PTP,
+		GPS,
+		GALILEO,
+		GLONASS,
+		LOCAL,
+		PRIVATE,
+		LOCALMAC,		// Free-running clock of the sender's interface
+		UNKNOWN
+	};
+
+	// PTP profile of a "ts-refclk:ptp=" reference clock (RFC 7273 4.8)
+	enum class SDPPtpVersion : uint8_t
+	{
+		IEEE1588_2002,
+		IEEE1588_2008,
+		IEEE1588_2019,
+		IEEE802_1AS_2011,
+		UNKNOWN
+	};
+
+	// Media clock of a stream, "a=mediaclk:<source>" (RFC 7273 5)
+	enum class SDPMediaClockSource : uint8_t
+	{
+		DIRECT,			// direct=<offset>, RTP clock locked to the reference clock
+		SENDER,			// Sender's own clock, not related to the reference
+		IEEE1722,		// IEEE1722=<stream id>, clock of an AVB stream
+		UNKNOWN
+	};
 }
\ No newline at end of file
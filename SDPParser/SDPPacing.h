@@ -0,0 +1,172 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	/// <summary>
+	/// PacingSchedule: ST 2110-21 timing model of a video stream and the send
+	///					time of every packet of one frame, precomputed so a
+	///					sender does one table lookup per packet.
+	/// <para>
+	///	Narrow (2110TPN) and wide (2110TPW) senders are gapped: packets go
+	///	out TRS apart during the active part (RACTIVE) of each frame or 
+	///	field, starting TROFFSET after the frame alignment point. Narrow
+	///	linear (2110TPNL) senders spread packets over the whole frame, 
+	///	starting at the alignment point. Interlaced streams are scheduled
+	///	per field. </para>
+	/// <para>
+	/// RACTIVE and TROFFSET follow 2110-21:2022 for 2160, 1080 and 720 line
+	/// formats. Other formats use the 1080 line values. </para>
+	/// </summary>
+	class PacingSchedule
+	{
+	public:
+		PacingSchedule() = default;
+
+		explicit PacingSchedule(const SDP::VideoDescription& video_description)
+		{
+			VideoFormat format(video_description);
+			Build(format, VideoStreamGeometry(format), video_description.tp, video_description.cmax);
+		}
+
+		PacingSchedule(const VideoFormat& format, const VideoStreamGeometry& geometry, SDP_TP tp, int32_t sdp_cmax = 0)
+		{
+			Build(format, geometry, tp, sdp_cmax);
+		}
+
+		SDP_TP GetTP() const { return m_tp; }
+		const FrameTiming& GetFrameTiming() const { return m_frame_timing; }
+
+		// NPACKETS per field (progressive: per frame) and per frame
+		uint32_t GetPacketsPerField() const { return m_packets_per_field; }
+		uint32_t GetPacketsPerFrame() const { return (uint32_t)m_packet_offsets_ns.size(); }
+
+		// TFRAME of the schedule: the field period for interlaced streams
+		double GetTFrameNs() const { return m_tframe_ns; }
+		double GetRActive() const { return m_ractive; }
+		double GetTrsNs() const { return m_trs_ns; }
+		double GetTrOffsetNs() const { return m_troffset_ns; }
+
+		// Maximum sender burst (packets) and receiver buffer (packets)
+		int32_t GetCmax() const { return m_cmax; }
+		int32_t GetVrxFull() const { return m_vrx_full; }
+
+		// Send time of each packet of a frame, in ns after its alignment
+		// point
+		const std::vector<uint32_t>& GetPacketOffsets() const { return m_packet_offsets_ns; }
+
+		// Send time of a packet, in ns since the epoch of the frame timing
+		// (the SMPTE/PTP epoch when frame indices count from it)
+		int64_t GetSendTimeNs(uint64_t frame_index, uint32_t packet_index) const
+		{
+			return m_frame_timing.FrameToNs(frame_index) + m_packet_offsets_ns[packet_index];
+		}
+
+	private:
+
+		void Build(const VideoFormat& format, const VideoStreamGeometry& geometry, SDP_TP tp, int32_t sdp_cmax)
+		{
+			if (!format.framerate.IsValid() || geometry.packets_per_field == 0)
+				throw std::runtime_error("PacingSchedule: Video format has no frame rate or packets");
+
+			m_tp = tp;
+			m_frame_timing = FrameTiming(format.framerate);
+			m_packets_per_field = geometry.packets_per_field;
+
+			uint32_t fields = format.IsInterlaced() ? 2 : 1;
+			double frame_ns = 1e9 * format.framerate.den / format.framerate.num;
+			m_tframe_ns = frame_ns / fields;
+
+			// Total lines and TROFFSET lines of the frame (2110-21:2022 6.3)
+			double total_lines = 1125;
+			double troffset_lines = format.IsInterlaced() ? 22 : 43;
+			if (format.height == 2160)
+			{
+				total_lines = 2250;
+				troffset_lines = 86;
+			}
+			else if (format.height == 720)
+			{
+				total_lines = 750;
+				troffset_lines = 28;
+			}
+
+			double packets = m_packets_per_field;
+			if (tp == SDP_TP::NARROWLINEAR)
+			{
+				m_ractive = 1;
+				m_troffset_ns = 0;
+			}
+			else
+			{
+				m_ractive = format.height == 2160 || format.height == 720 ? format.height / total_lines : 1080 / 1125.0;
+				m_troffset_ns = troffset_lines * frame_ns / total_lines;
+			}
+
+			m_trs_ns = m_tframe_ns * m_ractive / packets;
+
+			// Cmax and VRX_FULL in packets (2110-21:2022 6.4 and 7.2)
+			double tframe_s = m_tframe_ns * 1e-9;
+			if (tp == SDP_TP::WIDE)
+			{
+				m_cmax = std::max(16, (int32_t)(packets / (21600 * tframe_s)));
+				m_vrx_full = std::max(720, (int32_t)(packets / (300 * tframe_s)));
+			}
+			else
+			{
+				m_cmax = std::max(4, (int32_t)(packets / (43200 * m_ractive * tframe_s)));
+				m_vrx_full = std::max(8, (int32_t)(packets / (27000 * tframe_s)));
+			}
+
+			// CMAX signalled in the SDP overrides the computed value
+			if (sdp_cmax > 0)
+				m_cmax = sdp_cmax;
+
+			m_packet_offsets_ns.resize((size_t)m_packets_per_field * fields);
+			for (uint32_t field = 0; field < fields; field++)
+			{
+				for (uint32_t packet = 0; packet < m_packets_per_field; packet++)
+				{
+					double offset = field * m_tframe_ns + m_troffset_ns + packet * m_trs_ns;
+					m_packet_offsets_ns[(size_t)field * m_packets_per_field + packet] = (uint32_t)offset;
+				}
+			}
+		}
+
+		SDP_TP m_tp = SDP_TP::NARROW;
+		FrameTiming m_frame_timing;
+		uint32_t m_packets_per_field = 0;
+
+		double m_tframe_ns = 0;
+		double m_ractive = 0;
+		double m_trs_ns = 0;
+		double m_troffset_ns = 0;
+		int32_t m_cmax = 0;
+		int32_t m_vrx_full = 0;
+
+		std::vector<uint32_t> m_packet_offsets_ns;
+	};
+}
@@ -26,13 +26,38 @@ By using the Code, Licensee agrees to these terms.
 
 namespace Cf
 {
+	/// <summary>
+	/// SDPParser Constructor: Parser for later Parse() calls with the
+	///						   given settings.
+	/// </summary>
+	SDPParser::SDPParser(const SDPParserSettings& settings)
+		: m_settings(settings)
+	{
+	}
+
+
 	/// <summary>
 	/// SDPParser Constructor: Parse a given SDP into a SDP object.	
 	/// </summary>
-	SDPParser::SDPParser(std::string SDP)
+	SDPParser::SDPParser(std::string SDP, const SDPParserSettings& settings)
+		: m_settings(settings)
 	{
+		Parse(SDP);
+	}
+
+
+	/// <summary>
+	/// Parse: Parse a given SDP into the SDP object, reusing the memory of
+	///		   the previous parse. The returned reference is valid until the
+	///		   next Parse() or Reset().
+	/// </summary>
+	const SDP& SDPParser::Parse(std::string_view SDP)
+	{
+		Reset();
+
 		// Get SDP Session
-		m_session = parse(SDP);
+		m_sdp_text.assign(SDP);
+		m_session = m_settings.bounded ? parse(m_sdp_text, m_settings.limits) : parse(m_sdp_text);
 
 		//	Parse SDP Session file...
 		//	An SDP is composed of three parts:
@@ -43,13 +68,36 @@ namespace Cf
 		ParseSessionDescription();
 		ParseTimingDescription();
 		ParseMediaDescriptions();
+
+		return m_sdp;
+	}
+
+
+	/// <summary>
+	/// Reset: Clears the parse result. Media descriptions are moved to a 
+	///		   pool so their strings and containers are reused by the next
+	///		   parse instead of being reallocated.
+	/// </summary>
+	void SDPParser::Reset()
+	{
+		for (SDP::MediaVariant& media_description : m_sdp.media_descriptions)
+			m_media_pool.push_back(std::move(media_description));
+
+		m_sdp.Clear();
+
+		m_session = nullptr;
+		m_format_parameters.clear();
+
+		m_video_description = nullptr;
+		m_audio_description = nullptr;
+		m_data_description = nullptr;
 	}
 
 
 	/// <summary>
 	/// GetSDP: Get SDP as deserialized object.
 	/// </summary>
-	SDP SDPParser::GetSDP()
+	const SDP& SDPParser::GetSDP() const
 	{
 		return m_sdp;
 	}
@@ -75,15 +123,15 @@ namespace Cf
 	void SDPParser::ParseOrigin()
 	{
 		// Origin Params
-		auto iter = m_session.find("origin");
-		if (iter != m_session.end())
+		auto origin_iter = m_session.find("origin");
+		if (origin_iter != m_session.end())
 		{
-			json origin_session = m_session["origin"];
+			const json& origin_session = *origin_iter;
 
-			iter = origin_session.find("address");
+			auto iter = origin_session.find("address");
 			if (iter != origin_session.end() && iter->is_string())
 			{
-				m_sdp.origin.unicast_address = *iter;
+				m_sdp.origin.unicast_address = iter->get_ref<const std::string&>();
 			}
 
 			iter = origin_session.find("ipVer");
@@ -95,7 +143,7 @@ namespace Cf
 			iter = origin_session.find("netType");
 			if (iter != origin_session.end() && iter->is_string())
 			{
-				m_sdp.origin.net_type = *iter;
+				m_sdp.origin.net_type = iter->get_ref<const std::string&>();
 			}
 
 			iter = origin_session.find("sessionId");
@@ -113,7 +161,7 @@ namespace Cf
 			iter = origin_session.find("username");
 			if (iter != origin_session.end() && iter->is_string())
 			{
-				m_sdp.origin.username = *iter;
+				m_sdp.origin.username = iter->get_ref<const std::string&>();
 			}
 		}
 		else
@@ -129,17 +177,17 @@ namespace Cf
 	///								ConnectionInformation object from SDP into
 	///							    given pointer.
 	/// </summary>
-	void SDPParser::ParseConnectionInformation(SDP::ConnectionInformation* connection_information_ptr, json session)
+	void SDPParser::ParseConnectionInformation(SDP::ConnectionInformation* connection_information_ptr, const json& session)
 	{
-		auto iter = session.find("connection");
-		if (iter != session.end())
+		auto connection_iter = session.find("connection");
+		if (connection_iter != session.end())
 		{
-			json connection_session = session["connection"];
+			const json& connection_session = *connection_iter;
 
-			iter = connection_session.find("ip");
+			auto iter = connection_session.find("ip");
 			if (iter != connection_session.end() && iter->is_string())
 			{
-				connection_information_ptr->connection_address = *iter;
+				connection_information_ptr->connection_address = iter->get_ref<const std::string&>();
 			}
 
 			iter = connection_session.find("version");
@@ -157,6 +205,335 @@ namespace Cf
 	}
 
 
+	/// <summary>
+	/// ResolveAddress: Converts a textual IPv4/IPv6 address into a socket 
+	///					address of the given family. Returns false if the 
+	///					text is not a valid address of that family.
+	/// </summary>
+	bool SDPParser::ResolveAddress(std::string_view address, int32_t family, SDP::SocketAddress* socket_address_ptr)
+	{
+		// inet_pton needs a terminated string
+		char buffer[INET6_ADDRSTRLEN + 1];
+		if (address.empty() || address.size() > INET6_ADDRSTRLEN)
+			return false;
+
+		address.copy(buffer, address.size());
+		buffer[address.size()] = '\0';
+
+		*socket_address_ptr = {};
+		if (family == AF_INET6)
+		{
+			socket_address_ptr->ipv6.sin6_family = AF_INET6;
+			return inet_pton(AF_INET6, buffer, &socket_address_ptr->ipv6.sin6_addr) == 1;
+		}
+
+		socket_address_ptr->ipv4.sin_family = AF_INET;
+		return inet_pton(AF_INET, buffer, &socket_address_ptr->ipv4.sin_addr) == 1;
+	}
+
+
+	/// <summary>
+	/// ResolveEndpoint: Resolves the connection information, port, and source
+	///					 filter of a parsed media description into its binary
+	///					 socket endpoint. Session level "c=" and
+	///					 "a=source-filter:" are used when the media
+	///					 description has none. Unresolvable addresses (such as
+	///					 placeholder receiver SDPs) leave the endpoint unset.
+	/// </summary>
+	void SDPParser::ResolveEndpoint(SDP::MediaDescription* media_description_ptr)
+	{
+		if (media_description_ptr->connection_information.connection_address.empty())
+			media_description_ptr->connection_information = m_sdp.connection_information;
+
+		const SDP::ConnectionInformation& connection_information = media_description_ptr->connection_information;
+		SDP::Endpoint& endpoint = media_description_ptr->endpoint;
+		endpoint.Clear();
+
+		int32_t family = connection_information.addr_type == 6 ? AF_INET6 : AF_INET;
+		if (!ResolveAddress(connection_information.connection_address, family, &endpoint.address))
+		{
+			PLOG_INFO << "SDP connection address \"" << connection_information.connection_address << "\" could not be resolved.";
+			endpoint.address = {};
+			return;
+		}
+
+		endpoint.family = family;
+		if (family == AF_INET6)
+		{
+			endpoint.address.ipv6.sin6_port = htons((uint16_t)media_description_ptr->port);
+			endpoint.multicast = endpoint.address.ipv6.sin6_addr.s6_addr[0] == 0xff;
+		}
+		else
+		{
+			endpoint.address.ipv4.sin_port = htons((uint16_t)media_description_ptr->port);
+			endpoint.multicast = (ntohl(endpoint.address.ipv4.sin_addr.s_addr) & 0xf0000000) == 0xe0000000;
+			endpoint.ttl = connection_information.ttl;
+		}
+
+		// Source filter (example: a=source-filter: incl IN IP4 239.5.2.31 10.1.15.5)
+		const SDP::Attributes::SourceFilter* source_filter = &media_description_ptr->attributes.source_filter;
+		if (source_filter->src_list == "")
+			source_filter = &m_sdp.attributes.source_filter;
+
+		endpoint.exclude_sources = source_filter->filter_mode == "excl";
+
+		std::string_view src_list = source_filter->src_list;
+		while (!src_list.empty())
+		{
+			size_t start = src_list.find_first_not_of(' ');
+			if (start == std::string_view::npos)
+				break;
+
+			size_t end = src_list.find(' ', start);
+			std::string_view source = src_list.substr(start, end - start);
+			src_list = end == std::string_view::npos ? std::string_view() : src_list.substr(end);
+
+			SDP::SocketAddress source_address;
+			if (ResolveAddress(source, family, &source_address))
+				endpoint.sources.push_back(source_address);
+			else
+				PLOG_INFO << "SDP source-filter address \"" << source << "\" could not be resolved.";
+		}
+	}
+
+
+	/// <summary>
+	/// ResolveClocks: Sets the reference clocks and media clock of a media
+	///				   description, falling back to the session level ones,
+	///				   and its RtpClock at the rtpmap clock rate. Only a
+	///				   direct media clock ties RTP timestamps to the
+	///				   reference clock; others get offset 0 and rate 1.
+	/// </summary>
+	void SDPParser::ResolveClocks(SDP::MediaDescription* media_description_ptr, uint32_t default_clock_rate)
+	{
+		const SDP::Attributes& attributes = media_description_ptr->attributes;
+
+		media_description_ptr->reference_clocks = attributes.reference_clocks.empty() ? m_sdp.attributes.reference_clocks : attributes.reference_clocks;
+		media_description_ptr->media_clock = attributes.media_clock.source != SDPMediaClockSource::UNKNOWN ? attributes.media_clock : m_sdp.attributes.media_clock;
+
+		uint32_t clock_rate = default_clock_rate;
+		if (!attributes.rtp_map.empty() && attributes.rtp_map[0].rate > 0)
+			clock_rate = attributes.rtp_map[0].rate;
+
+		const SDP::Attributes::MediaClock& media_clock = media_description_ptr->media_clock;
+		if (media_clock.source == SDPMediaClockSource::DIRECT)
+			media_description_ptr->rtp_clock = RtpClock(clock_rate, media_clock.offset, media_clock.rate);
+		else
+			media_description_ptr->rtp_clock = RtpClock(clock_rate);
+	}
+
+
+	/// <summary>
+	/// ParseReferenceClock: Parses one "a=ts-refclk:" value (RFC 7273 4.8,
+	///						 2110-10:2022 8.2). Returns false if the value
+	///						 does not follow the form of its clock source.
+	///						 Unknown clock sources are kept as UNKNOWN.
+	/// <para>
+	///		ptp=IEEE1588-2008:00-50-C2-FF-FE-90-04-37:0 </para>
+	/// <para>
+	///		ptp=IEEE1588-2008:traceable </para>
+	/// <para>
+	///		localmac=7C-E9-D3-1B-9A-AF </para>
+	/// <para>
+	///		ntp=/traceable/, private:traceable, gps, local </para>
+	/// </summary>
+	bool SDPParser::ParseReferenceClock(std::string_view value, SDP::Attributes::ReferenceClock* reference_clock_ptr)
+	{
+		size_t separator = value.find_first_of("=:");
+		std::string_view extension = separator == std::string_view::npos ? std::string_view() : value.substr(separator + 1);
+
+		SDP::Attributes::ReferenceClock reference_clock;
+		reference_clock.source = SDPEnumFromString<SDPClockSource>(value.substr(0, separator)).value_or(SDPClockSource::UNKNOWN);
+
+		switch (reference_clock.source)
+		{
+		case SDPClockSource::PTP:
+		{
+			// <ptp-version>:<grandmaster>[:<domain>] or <ptp-version>:traceable
+			size_t version_end = extension.find(':');
+			if (version_end == std::string_view::npos)
+				return false;
+
+			reference_clock.ptp_version = SDPEnumFromString<SDPPtpVersion>(extension.substr(0, version_end)).value_or(SDPPtpVersion::UNKNOWN);
+
+			std::string_view server = extension.substr(version_end + 1);
+			if (server == "traceable")
+			{
+				reference_clock.traceable = true;
+				break;
+			}
+
+			size_t domain_start = server.find(':');
+			if (!ParseEui(server.substr(0, domain_start), 8, &reference_clock.grandmaster_id))
+				return false;
+
+			if (domain_start == std::string_view::npos)
+				break;
+
+			// IEEE 1588-2002 names its domains, later versions number them
+			std::string_view domain = server.substr(domain_start + 1);
+			constexpr std::string_view SUBDOMAINS[] = { "_DFLT", "_ALT1", "_ALT2", "_ALT3" };
+			auto subdomain = std::find(std::begin(SUBDOMAINS), std::end(SUBDOMAINS), domain);
+			if (subdomain != std::end(SUBDOMAINS))
+			{
+				reference_clock.domain = (uint8_t)(subdomain - std::begin(SUBDOMAINS));
+				break;
+			}
+
+			auto result = std::from_chars(domain.data(), domain.data() + domain.size(), reference_clock.domain);
+			if (result.ec != std::errc() || result.ptr != domain.data() + domain.size())
+				return false;
+			break;
+		}
+		case SDPClockSource::LOCALMAC:
+			if (!ParseEui(extension, 6, &reference_clock.local_mac))
+				return false;
+			break;
+		case SDPClockSource::NTP:
+			reference_clock.traceable = extension == "/traceable/";
+			break;
+		case SDPClockSource::PRIVATE:
+			reference_clock.traceable = extension == "traceable";
+			break;
+		default:
+			break;
+		}
+
+		*reference_clock_ptr = reference_clock;
+		return true;
+	}
+
+
+	/// <summary>
+	/// ParseMediaClock: Parses an "a=mediaclk:" value (RFC 7273 5) into its
+	///					 source and, for a direct media clock, the offset
+	///					 and rate. Returns false for unknown media clocks.
+	/// <para>
+	///		direct=0 </para>
+	/// <para>
+	///		direct=963214424 rate=1000/1001 </para>
+	/// <para>
+	///		id=src:1 sender </para>
+	/// </summary>
+	bool SDPParser::ParseMediaClock(std::string_view value, SDP::Attributes::MediaClock* media_clock_ptr)
+	{
+		SDP::Attributes::MediaClock media_clock;
+
+		while (!value.empty())
+		{
+			size_t end = value.find(' ');
+			std::string_view field = value.substr(0, end);
+			value = end == std::string_view::npos ? std::string_view() : value.substr(end + 1);
+
+			size_t separator = field.find('=');
+			std::string_view name = field.substr(0, separator);
+			std::string_view parameter = separator == std::string_view::npos ? std::string_view() : field.substr(separator + 1);
+
+			// Media clock source identifier, only needed to tell several
+			// media clocks apart
+			if (field.empty() || name == "id")
+				continue;
+
+			if (name == "rate")
+			{
+				std::optional<Rational> rate = Rational::Parse(parameter);
+				if (!rate)
+					return false;
+
+				media_clock.rate = *rate;
+				continue;
+			}
+
+			std::optional<SDPMediaClockSource> source = SDPEnumFromString<SDPMediaClockSource>(name);
+			if (!source || media_clock.source != SDPMediaClockSource::UNKNOWN)
+				return false;
+
+			media_clock.source = *source;
+
+			// Offset in media clock units, 0 if not given. RTP timestamps
+			// wrap, so only its low 32 bits matter.
+			if (*source == SDPMediaClockSource::DIRECT && !parameter.empty())
+			{
+				uint64_t offset = 0;
+				auto result = std::from_chars(parameter.data(), parameter.data() + parameter.size(), offset);
+				if (result.ec != std::errc() || result.ptr != parameter.data() + parameter.size())
+					return false;
+
+				media_clock.offset = (uint32_t)offset;
+			}
+		}
+
+		if (media_clock.source == SDPMediaClockSource::UNKNOWN)
+			return false;
+
+		*media_clock_ptr = media_clock;
+		return true;
+	}
+
+
+	/// <summary>
+	/// ParseEui: Parses an EUI-48 or EUI-64 written as hex octets separated
+	///			  by '-' (example: 00-50-C2-FF-FE-90-04-37), first octet
+	///			  highest.
+	/// </summary>
+	bool SDPParser::ParseEui(std::string_view eui, size_t octets, uint64_t* eui_ptr)
+	{
+		if (eui.size() != octets * 3 - 1)
+			return false;
+
+		uint64_t value = 0;
+		for (size_t i = 0; i < octets; i++)
+		{
+			const char* octet_start = eui.data() + i * 3;
+			if (i > 0 && octet_start[-1] != '-')
+				return false;
+
+			uint8_t octet = 0;
+			auto result = std::from_chars(octet_start, octet_start + 2, octet, 16);
+			if (result.ec != std::errc() || result.ptr != octet_start + 2)
+				return false;
+
+			value = (value << 8) | octet;
+		}
+
+		*eui_ptr = value;
+		return true;
+	}
+
+
+	/// <summary>
+	/// ParsePayloadTypes: Parses the "m=" payload type list (example: 
+	///					   "96 97") into numbers. Stops at the first 
+	///					   non-numeric format.
+	/// </summary>
+	void SDPParser::ParsePayloadTypes(SDP::MediaDescription* media_description_ptr)
+	{
+		media_description_ptr->payload_types.clear();
+
+		const char* position = media_description_ptr->payloads.data();
+		const char* end = position + media_description_ptr->payloads.size();
+		while (position < end)
+		{
+			if (*position == ' ')
+			{
+				position++;
+				continue;
+			}
+
+			int32_t payload_type = 0;
+			auto result = std::from_chars(position, end, payload_type);
+			if (result.ec != std::errc())
+			{
+				PLOG_INFO << "SDP media payload types \"" << media_description_ptr->payloads << "\" are not numeric.";
+				return;
+			}
+
+			media_description_ptr->payload_types.push_back(payload_type);
+			position = result.ptr;
+		}
+	}
+
+
 	/// <summary>
 	/// ParseBandwidthInformation: Parses all bandwidth informations in an SDP.
 	/// </summary>
@@ -165,24 +542,23 @@ namespace Cf
 		auto iter = m_session.find("bandwidth");
 		if (iter != m_session.end())
 		{
-			json bandwidth_session = m_session.at("bandwidth");
-			for (int i = 0; i < bandwidth_session.size(); i++)
+			for (const json& bandwidth_session : *iter)
 			{
 				SDP::BandwidthInformation bandwidth_information;
 
-				auto iter = bandwidth_session[i].find("type");
-				if (iter != bandwidth_session[i].end() && iter->is_string())
+				auto iter = bandwidth_session.find("type");
+				if (iter != bandwidth_session.end() && iter->is_string())
 				{
-					bandwidth_information.type = *iter;
+					bandwidth_information.type = iter->get_ref<const std::string&>();
 				}
 
-				iter = bandwidth_session[i].find("limit");
-				if (iter != bandwidth_session[i].end() && iter->is_number())
+				iter = bandwidth_session.find("limit");
+				if (iter != bandwidth_session.end() && iter->is_number())
 				{
 					bandwidth_information.limit = *iter;
 				}
 
-				m_sdp.bandwidth_informations.push_back(bandwidth_information);
+				m_sdp.bandwidth_informations.push_back(std::move(bandwidth_information));
 			}
 		}
 	}
@@ -194,13 +570,15 @@ namespace Cf
 	///					 progress. See sdptransform/ grammar.cpp for all "a=" 
 	///					 scenarios.
 	/// </summary>
-	void SDPParser::ParseAttributes(SDP::Attributes* attribute_ptr, json session)
+	void SDPParser::ParseAttributes(SDP::Attributes* attribute_ptr, const json& session)
 	{
 		// Parse mediaclk attribute (example: a=mediaclk:direct=0)
 		auto iter = session.find("mediaclk");
 		if (iter != session.end() && iter->is_string())
 		{
-			attribute_ptr->media_clock = *iter;
+			const std::string& media_clock = iter->get_ref<const std::string&>();
+			if (!ParseMediaClock(media_clock, &attribute_ptr->media_clock))
+				PLOG_INFO << "SDP mediaclk \"" << media_clock << "\" could not be parsed.";
 		}
 
 		// Parse framerate attribute (example: a=framerate:29.97)
@@ -210,153 +588,178 @@ namespace Cf
 			attribute_ptr->framerate = *iter;
 		}
 
+		// Parse ptime attribute (example: a=ptime:0.125)
+		iter = session.find("ptime");
+		if (iter != session.end() && iter->is_number())
+		{
+			attribute_ptr->ptime = *iter;
+		}
+
+		// Parse ts-refclk attributes (example: a=ts-refclk:ptp=IEEE1588-2008:00-50-C2-FF-FE-90-04-37:0)
+		auto array_iter = session.find("tsRefclks");
+		if (array_iter != session.end())
+		{
+			for (const json& reference_clock_session : *array_iter)
+			{
+				iter = reference_clock_session.find("value");
+				if (iter == reference_clock_session.end() || !iter->is_string())
+					continue;
+
+				SDP::Attributes::ReferenceClock reference_clock;
+				const std::string& value = iter->get_ref<const std::string&>();
+				if (ParseReferenceClock(value, &reference_clock))
+					attribute_ptr->reference_clocks.push_back(reference_clock);
+				else
+					PLOG_INFO << "SDP ts-refclk \"" << value << "\" could not be parsed.";
+			}
+		}
+
 		// Parse rtpmap attribute (example: a=rtpmap:110 opus/48000/2)
-		if (session.find("rtp") != session.end())
+		array_iter = session.find("rtp");
+		if (array_iter != session.end())
 		{
-			json rtp_session = session["rtp"];
-			for (int i = 0; i < rtp_session.size(); i++)
+			for (const json& rtp_session : *array_iter)
 			{
 				SDP::Attributes::RTP rtp;
 
-				iter = rtp_session[i].find("payload");
-				if (iter != rtp_session[i].end() && iter->is_number())
+				iter = rtp_session.find("payload");
+				if (iter != rtp_session.end() && iter->is_number())
 				{
 					rtp.payload = *iter;
 				}
 
-				iter = rtp_session[i].find("codec");
-				if (iter != rtp_session[i].end() && iter->is_string())
+				iter = rtp_session.find("codec");
+				if (iter != rtp_session.end() && iter->is_string())
 				{
-					rtp.codec = *iter;
+					rtp.codec = iter->get_ref<const std::string&>();
 				}
 
-				iter = rtp_session[i].find("rate");
-				if (iter != rtp_session[i].end() && iter->is_number())
+				iter = rtp_session.find("rate");
+				if (iter != rtp_session.end() && iter->is_number())
 				{
 					rtp.rate = *iter;
 				}
 
-				iter = rtp_session[i].find("encoding");
-				if (iter != rtp_session[i].end() && iter->is_string())
+				iter = rtp_session.find("encoding");
+				if (iter != rtp_session.end() && iter->is_string())
 				{
-					rtp.encoding = *iter;
+					rtp.encoding = iter->get_ref<const std::string&>();
 				}
 
-				attribute_ptr->rtp_map.push_back(rtp);
+				attribute_ptr->rtp_map.push_back(std::move(rtp));
 			}
 		}
 
 		// Parse fmtp attirbute (example: a=fmtp:108 profile-level-id=24;object=23;bitrate=64000)
-		if (session.find("fmtp") != session.end())
+		array_iter = session.find("fmtp");
+		if (array_iter != session.end())
 		{
-			json fmtp_session = session["fmtp"];
-
-			for (int i = 0; i < fmtp_session.size(); i++)
+			for (const json& fmtp_session : *array_iter)
 			{
 				SDP::Attributes::FMTP fmtp;
 
-				iter = fmtp_session[i].find("payload");
-				if (iter != fmtp_session[i].end() && iter->is_number())
+				iter = fmtp_session.find("payload");
+				if (iter != fmtp_session.end() && iter->is_number())
 				{
 					fmtp.payload = *iter;
 				}
 
-				iter = fmtp_session[i].find("config");
-				if (iter != fmtp_session[i].end() && iter->is_string())
+				iter = fmtp_session.find("config");
+				if (iter != fmtp_session.end() && iter->is_string())
 				{
-					fmtp.config = *iter;
+					fmtp.config = iter->get_ref<const std::string&>();
 				}
 
-				attribute_ptr->fmtp.push_back(fmtp);
+				attribute_ptr->fmtp.push_back(std::move(fmtp));
 			}
 		}
 
 		// Parse source-filter attribute (example: a=source-filter: incl IN IP4 239.5.2.31 10.1.15.5)
-		if (session.find("sourceFilter") != session.end())
+		iter = session.find("sourceFilter");
+		if (iter != session.end())
 		{
-			json source_filter_session = session["sourceFilter"];
+			const json& source_filter_session = *iter;
 
 			iter = source_filter_session.find("filterMode");
 			if (iter != source_filter_session.end() && iter->is_string())
 			{
-				attribute_ptr->source_filter.filter_mode = *iter;
+				attribute_ptr->source_filter.filter_mode = iter->get_ref<const std::string&>();
 			}
 
 			iter = source_filter_session.find("netType");
 			if (iter != source_filter_session.end() && iter->is_string())
 			{
-				attribute_ptr->source_filter.net_type = *iter;
+				attribute_ptr->source_filter.net_type = iter->get_ref<const std::string&>();
 			}
 
 			iter = source_filter_session.find("addressTypes");
 			if (iter != source_filter_session.end() && iter->is_string())
 			{
-				attribute_ptr->source_filter.address_types = *iter;
+				attribute_ptr->source_filter.address_types = iter->get_ref<const std::string&>();
 			}
 
 			iter = source_filter_session.find("destAddress");
 			if (iter != source_filter_session.end() && iter->is_string())
 			{
-				attribute_ptr->source_filter.dest_address = *iter;
+				attribute_ptr->source_filter.dest_address = iter->get_ref<const std::string&>();
 			}
 
 			iter = source_filter_session.find("srcList");
 			if (iter != source_filter_session.end() && iter->is_string())
 			{
-				attribute_ptr->source_filter.src_list = *iter;
+				attribute_ptr->source_filter.src_list = iter->get_ref<const std::string&>();
 			}
 		}
 
 		// Parse imageattr attribute (example: a=imageattr:97 send [x=800,y=640,sar=1.1,q=0.6] [x=480,y=320] recv [x=330,y=250])
-		if (session.find("imageattrs") != session.end())
+		array_iter = session.find("imageattrs");
+		if (array_iter != session.end())
 		{
-			json image_attributes_session = session["imageattrs"];
-
-			for (int i = 0; i < image_attributes_session.size(); i++)
+			for (const json& image_attributes_session : *array_iter)
 			{
 				SDP::Attributes::ImageAttributes image_attributes;
 
-				iter = image_attributes_session[i].find("pt");
-				if (iter != image_attributes_session[i].end() && iter->is_string())
+				iter = image_attributes_session.find("pt");
+				if (iter != image_attributes_session.end() && iter->is_string())
 				{
-					image_attributes.pt = *iter;
+					image_attributes.pt = iter->get_ref<const std::string&>();
 				}
 
-				iter = image_attributes_session[i].find("dir1");
-				if (iter != image_attributes_session[i].end() && iter->is_string())
+				iter = image_attributes_session.find("dir1");
+				if (iter != image_attributes_session.end() && iter->is_string())
 				{
-					image_attributes.dir1 = *iter;
+					image_attributes.dir1 = iter->get_ref<const std::string&>();
 				}
 
-				iter = image_attributes_session[i].find("attrs1");
-				if (iter != image_attributes_session[i].end() && iter->is_string())
+				iter = image_attributes_session.find("attrs1");
+				if (iter != image_attributes_session.end() && iter->is_string())
 				{
-					image_attributes.attrs1 = *iter;
+					image_attributes.attrs1 = iter->get_ref<const std::string&>();
 				}
 
-				iter = image_attributes_session[i].find("dir2");
-				if (iter != image_attributes_session[i].end() && iter->is_string())
+				iter = image_attributes_session.find("dir2");
+				if (iter != image_attributes_session.end() && iter->is_string())
 				{
-					image_attributes.dir2 = *iter;
+					image_attributes.dir2 = iter->get_ref<const std::string&>();
 				}
 
-				iter = image_attributes_session[i].find("attrs2");
-				if (iter != image_attributes_session[i].end() && iter->is_string())
+				iter = image_attributes_session.find("attrs2");
+				if (iter != image_attributes_session.end() && iter->is_string())
 				{
-					image_attributes.attrs2 = *iter;
+					image_attributes.attrs2 = iter->get_ref<const std::string&>();
 				}
 
-				attribute_ptr->image_attributes.push_back(image_attributes);
+				attribute_ptr->image_attributes.push_back(std::move(image_attributes));
 			}
 		}
 
 		// Attribute is unknown - print alert message
-		if (m_session.find("invalid") != m_session.end())
+		auto invalid_iter = m_session.find("invalid");
+		if (invalid_iter != m_session.end())
 		{
-			json invalid_attributes = m_session["invalid"];
-			for (int i = 0; i < invalid_attributes.size(); i++)
+			for (const json& invalid_attribute : *invalid_iter)
 			{
-				PLOG_INFO << "Unknown attribute \"" << (std::string)invalid_attributes[i]["value"] << "\" found in the SDP.";
+				PLOG_INFO << "Unknown attribute \"" << invalid_attribute.value("value", "") << "\" found in the SDP.";
 			}
 		}
 	}
@@ -370,7 +773,50 @@ namespace Cf
 	/// </summary>
 	void SDPParser::ParseSessionDescription()
 	{
-		// REDACTED // 
+		// Protocol Version ("v=")
+		auto iter = m_session.find("version");
+		if (iter != m_session.end() && iter->is_number())
+			m_sdp.protocol_version = *iter;
+		else
+			throw std::runtime_error("No protocol version found in SDP. This is a required parameter.");
+
+		// Origin ("o=")
+		ParseOrigin();
+
+		// Session Name ("s=")
+		iter = m_session.find("name");
+		if (iter != m_session.end() && iter->is_string())
+			m_sdp.session_name = iter->get_ref<const std::string&>();
+		else
+			throw std::runtime_error("No session name found in SDP. This is a required parameter.");
+
+		// Session Information ("i="), URI ("u="), Email Address ("e=") and 
+		// Phone Number ("p=") are optional
+		iter = m_session.find("description");
+		if (iter != m_session.end() && iter->is_string())
+			m_sdp.session_information = iter->get_ref<const std::string&>();
+
+		iter = m_session.find("uri");
+		if (iter != m_session.end() && iter->is_string())
+			m_sdp.uri = iter->get_ref<const std::string&>();
+
+		iter = m_session.find("email");
+		if (iter != m_session.end() && iter->is_string())
+			m_sdp.email_address = iter->get_ref<const std::string&>();
+
+		iter = m_session.find("phone");
+		if (iter != m_session.end() && iter->is_string())
+			m_sdp.phone_number = iter->get_ref<const std::string&>();
+
+		// Session level "c=" is optional when every media description has
+		// its own. ResolveEndpoint() falls back to it.
+		ParseConnectionInformation(&m_sdp.connection_information, m_session);
+
+		ParseBandwidthInformation();
+
+		// Session level attributes, such as the "a=ts-refclk:" and
+		// "a=mediaclk:" that ResolveClocks() falls back to
+		ParseAttributes(&m_sdp.attributes, m_session);
 	}
 
 
@@ -383,10 +829,10 @@ namespace Cf
 	/// </summary>
 	void SDPParser::ParseTimingDescription()
 	{
-		auto iter = m_session.find("timing");
-		if (iter != m_session.end())
+		auto timing_iter = m_session.find("timing");
+		if (timing_iter != m_session.end())
 		{
-			json timing_session = m_session["timing"];
+			const json& timing_session = *timing_iter;
 
 			auto iter = timing_session.find("start");
 			if (iter != timing_session.end() && iter->is_number())
@@ -410,14 +856,18 @@ namespace Cf
 	/// <summary>
 	/// ParseVideoDescription: Parses one video description from an SDP.
 	/// </summary>
-	void SDPParser::ParseVideoDescription(json video_description_session)
+	void SDPParser::ParseVideoDescription(json&& media_session)
 	{
-		m_video_description = make_shared<SDP::VideoDescription>(video_description_session);
+		m_video_description = AddMediaDescription<SDP::VideoDescription>(std::move(media_session));
+
+		// The media json now lives in the description. Parse from there.
+		const json& video_description_session = m_video_description->m_session;
 
 		auto iter = video_description_session.find("payloads");
 		if (iter != video_description_session.end() && iter->is_string())
 		{
-			m_video_description->payloads = *iter;
+			m_video_description->payloads = iter->get_ref<const std::string&>();
+			ParsePayloadTypes(m_video_description);
 		}
 
 		iter = video_description_session.find("port");
@@ -429,31 +879,54 @@ namespace Cf
 		iter = video_description_session.find("protocol");
 		if (iter != video_description_session.end() && iter->is_string())
 		{
-			m_video_description->protocol = *iter;
+			m_video_description->protocol = iter->get_ref<const std::string&>();
+		}
+
+		iter = video_description_session.find("mid");
+		if (iter != video_description_session.end() && iter->is_string())
+		{
+			m_video_description->mid = iter->get_ref<const std::string&>();
 		}
 
 		ParseConnectionInformation(&m_video_description->connection_information, video_description_session);
 
 		ParseAttributes(&m_video_description->attributes, video_description_session);
 
-		m_video_params_session = parseParams(m_video_description->attributes.fmtp[0].config);
+		ResolveEndpoint(m_video_description);
+
+		// 90 kHz for 2110-20/-22 if the rtpmap has no rate
+		ResolveClocks(m_video_description, 90000);
+
+		// Without an fmtp there are no media type parameters, which
+		// ParseVideoParams() reports
+		ParseFormatParameters(*m_video_description);
 		ParseVideoParams();
 
-		m_sdp.media_descriptions.push_back(m_video_description);
+		// Precompute frame timing at the RTP clock rate
+		if (m_video_description->framerate.IsValid())
+		{
+			m_video_description->frame_timing = FrameTiming(m_video_description->framerate, m_video_description->rtp_clock.GetClockRate());
+		}
+
+		IndexMediaDescription(*m_video_description, m_sdp.video_indices);
 	}
 
 
 	/// <summary>
 	/// ParseAudioDescription: Parses one audio description from an SDP.
 	/// </summary>
-	void SDPParser::ParseAudioDescription(json audio_description_session)
+	void SDPParser::ParseAudioDescription(json&& media_session)
 	{
-		m_audio_description = make_shared<SDP::AudioDescription>(audio_description_session);
+		m_audio_description = AddMediaDescription<SDP::AudioDescription>(std::move(media_session));
+
+		// The media json now lives in the description. Parse from there.
+		const json& audio_description_session = m_audio_description->m_session;
 
 		auto iter = audio_description_session.find("payloads");
 		if (iter != audio_description_session.end() && iter->is_string())
 		{
-			m_audio_description->payloads = *iter;
+			m_audio_description->payloads = iter->get_ref<const std::string&>();
+			ParsePayloadTypes(m_audio_description);
 		}
 
 		iter = audio_description_session.find("port");
@@ -465,24 +938,83 @@ namespace Cf
 		iter = audio_description_session.find("protocol");
 		if (iter != audio_description_session.end() && iter->is_string())
 		{
-			m_audio_description->protocol = *iter;
+			m_audio_description->protocol = iter->get_ref<const std::string&>();
+		}
+
+		iter = audio_description_session.find("mid");
+		if (iter != audio_description_session.end() && iter->is_string())
+		{
+			m_audio_description->mid = iter->get_ref<const std::string&>();
 		}
 
+		ParseConnectionInformation(&m_audio_description->connection_information, audio_description_session);
+
 		ParseAttributes(&m_audio_description->attributes, audio_description_session);
 
-		m_audio_params_session = parseParams(m_audio_description->attributes.fmtp[0].config);
+		ResolveEndpoint(m_audio_description);
+
+		// 48 kHz for 2110-30 if the rtpmap has no rate
+		ResolveClocks(m_audio_description, 48000);
+
+		// Channel order is optional, and with it the fmtp
+		ParseFormatParameters(*m_audio_description);
 		ParseAudioParams();
 
-		m_sdp.media_descriptions.push_back(m_audio_description);
+		IndexMediaDescription(*m_audio_description, m_sdp.audio_indices);
 	}
 
 
 	/// <summary>
 	/// ParseDataDescription: Parses one data description from an SDP.
 	/// </summary>
-	void SDPParser::ParseDataDescription(json data_description_session)
+	void SDPParser::ParseDataDescription(json&& media_session)
+	{
+
+	}
+
+
+	/// <summary>
+	/// AddMediaDescription: Appends a media description of the given type
+	///						 holding media_session to the SDP. A pooled
+	///						 description from an earlier parse is reused
+	///						 when there is one.
+	/// </summary>
+	template<typename Description>
+	Description* SDPParser::AddMediaDescription(json&& media_session)
+	{
+		for (size_t i = m_media_pool.size(); i-- > 0;)
+		{
+			if (std::holds_alternative<Description>(m_media_pool[i]))
+			{
+				Description& description = std::get<Description>(
+					m_sdp.media_descriptions.emplace_back(std::move(m_media_pool[i])));
+
+				if (i != m_media_pool.size() - 1)
+					m_media_pool[i] = std::move(m_media_pool.back());
+				m_media_pool.pop_back();
+
+				description.Reset(std::move(media_session));
+				return &description;
+			}
+		}
+
+		return &std::get<Description>(m_sdp.media_descriptions.emplace_back(
+			std::in_place_type<Description>, std::move(media_session)));
+	}
+
+
+	/// <summary>
+	/// IndexMediaDescription: Records the position of the media description 
+	///						  just added to the SDP in its per-type index
+	///						  and, if it has one, under its mid.
+	/// </summary>
+	void SDPParser::IndexMediaDescription(const SDP::MediaDescription& media_description, std::vector<uint32_t>& type_indices)
 	{
+		uint32_t index = (uint32_t)(m_sdp.media_descriptions.size() - 1);
+		type_indices.push_back(index);
 
+		if (!media_description.mid.empty())
+			m_sdp.mid_indices.emplace(media_description.mid, index);
 	}
 
 
@@ -492,27 +1024,104 @@ namespace Cf
 	/// </summary>
 	void SDPParser::ParseMediaDescriptions()
 	{
-		for (int i = 0; i < m_session.at("media").size(); i++)
-		{
-			json media_description_session = m_session.at("media")[i];
+		auto iter = m_session.find("media");
+		if (iter == m_session.end())
+			return;
 
-			if ((media_description_session.at("type")) == "video")
-			{
-				ParseVideoDescription(media_description_session);
-			}
-			else if ((media_description_session.at("type")) == "audio")
-			{
-				ParseAudioDescription(media_description_session);
-			}
-			else
+		for (json& media_description_session : *iter)
+		{
+			const std::string& media_type = media_description_session.at("type").get_ref<const std::string&>();
+			switch (SDPEnumFromString<SDPMediaType>(media_type).value_or(SDPMediaType::UNKNOWN))
 			{
-				PLOG_INFO << "SDP Parsing for " <<
-					(char*)m_session.at("media")[i].type() << " is not supported yet";
+			case SDPMediaType::VIDEO:
+				ParseVideoDescription(std::move(media_description_session));
+				break;
+			case SDPMediaType::AUDIO:
+				ParseAudioDescription(std::move(media_description_session));
+				break;
+			default:
+				PLOG_INFO << "SDP Parsing for " << media_type << " is not supported yet";
+				break;
 			}
 		}
 	}
 
 
+	/// <summary>
+	/// ParseFormatParameters: Splits the config of the first "a=fmtp:" of a
+	///						   media description into its media type
+	///						   parameters, "name=value" or a bare "name"
+	///						   separated by ";". The parameters are views
+	///						   into the config, so no json or strings are
+	///						   built for them. No fmtp means no parameters.
+	/// </summary>
+	void SDPParser::ParseFormatParameters(const SDP::MediaDescription& media_description)
+	{
+		m_format_parameters.clear();
+		if (media_description.attributes.fmtp.empty())
+			return;
+
+		auto trim = [](std::string_view text)
+		{
+			size_t first = text.find_first_not_of(" \t");
+			if (first == std::string_view::npos)
+				return std::string_view();
+
+			return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+		};
+
+		std::string_view config = media_description.attributes.fmtp[0].config;
+		while (!config.empty())
+		{
+			size_t separator = config.find(';');
+			std::string_view parameter = trim(config.substr(0, separator));
+			config.remove_prefix(separator == std::string_view::npos ? config.size() : separator + 1);
+
+			if (parameter.empty())
+				continue;
+
+			size_t equals = parameter.find('=');
+			FormatParameter& format_parameter = m_format_parameters.emplace_back();
+			format_parameter.name = trim(parameter.substr(0, equals));
+			format_parameter.value = equals == std::string_view::npos ? std::string_view() : trim(parameter.substr(equals + 1));
+		}
+	}
+
+
+	/// <summary>
+	/// FindFormatParameter: Returns the media type parameter of the given
+	///						 name, or nullptr if the fmtp does not have it.
+	///						 The last one wins if a name is repeated.
+	/// </summary>
+	const SDPParser::FormatParameter* SDPParser::FindFormatParameter(std::string_view name) const
+	{
+		for (size_t i = m_format_parameters.size(); i-- > 0;)
+		{
+			if (m_format_parameters[i].name == name)
+				return &m_format_parameters[i];
+		}
+
+		return nullptr;
+	}
+
+
+	/// <summary>
+	/// ParseInteger: Parses a whole decimal media type parameter value.
+	///				  Returns false, leaving the value unchanged, if the
+	///				  text is not one.
+	/// </summary>
+	bool SDPParser::ParseInteger(std::string_view text, int32_t* value_ptr)
+	{
+		int32_t value = 0;
+		auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+		if (result.ec != std::errc() || result.ptr != text.data() + text.size())
+			return false;
+
+		*value_ptr = value;
+		return true;
+	}
+
+
 	/// <summary>
 	/// ParseAudioParams: Parse audio parameters (channel order) from SDP.
 	///					  More params may need to be added if they come up,
@@ -520,27 +1129,93 @@ namespace Cf
 	/// </summary>
 	void SDPParser::ParseAudioParams()
 	{
-		auto iter = m_audio_params_session.find("channel-order");
-		if (iter != m_audio_params_session.end() && iter->is_string())
+		const FormatParameter* parameter = FindFormatParameter("channel-order");
+		if (parameter != nullptr)
 		{
-			std::string channel_order = *iter;
+			// Channel order string. Example: "SMPTE2110.(M,M,M,M,ST,U02)"
+			std::string_view channel_order = parameter->value;
+
+			size_t convention = channel_order.find("SMPTE2110.");
+			size_t open = convention == std::string_view::npos ? convention : channel_order.find('(', convention);
+			size_t close = channel_order.rfind(')');
+			if (open == std::string_view::npos || close == std::string_view::npos || close <= open + 1)
+				throw std::runtime_error("Channel order from SDP File is of unknown format. See 2110-30:2017 6.2.2 for details");
+
+			m_audio_description->channel_order = channel_order.substr(open + 1, close - open - 1);
+			ParseChannelOrder();
+		}
+		
+	}
 
-			// Regex Pattern for Channel order string. Example: "SMPTE2110.(M,M,M,M,ST,U02)"
-			std::regex pattern("SMPTE2110.\\((.+)\\)");
-			std::smatch matches;
 
-			// regex_search produces:
-			// matches[0] = the full match, matches[1] = group 1
-			if (std::regex_search(channel_order, matches, pattern))
+	/// <summary>
+	/// ParseChannelOrder: Parses the channel order listing into its channel
+	///					   groups and builds the channel index -> (group, 
+	///					   role) table.
+	/// </summary>
+	void SDPParser::ParseChannelOrder()
+	{
+		m_audio_description->channel_groups.clear();
+		m_audio_description->channel_map.clear();
+		m_audio_description->channel_count = 0;
+
+		std::string_view order = m_audio_description->channel_order;
+		while (true)
+		{
+			size_t comma = order.find(',');
+			std::string_view symbol = order.substr(0, comma);
+
+			SDP::AudioDescription::ChannelGroup group;
+			group.first_channel = m_audio_description->channel_count;
+
+			std::optional<SDPChannelGroup> known = SDPEnumFromString<SDPChannelGroup>(symbol);
+			if (known)
+			{
+				group.symbol = *known;
+				group.channel_count = (int32_t)SDPChannelGroupRoles(*known).size();
+			}
+			else if (symbol.size() == 3 && symbol[0] == 'U' && std::isdigit((unsigned char)symbol[1]) && std::isdigit((unsigned char)symbol[2]))
 			{
-				m_audio_description->channel_order = matches[1];
+				// Unn: nn undefined channels, 01-64
+				group.symbol = SDPChannelGroup::UNDEFINED;
+				group.channel_count = (symbol[1] - '0') * 10 + (symbol[2] - '0');
+				if (group.channel_count < 1 || group.channel_count > 64)
+					throw std::runtime_error("Channel order grouping symbol \"" + std::string(symbol) + "\" is out of range. See 2110-30:2017 Table 1");
 			}
 			else
 			{
-				throw std::runtime_error("Channel order from SDP File is of unknown format. See 2110-30:2017 6.2.2 for details");
+				throw std::runtime_error("Channel order grouping symbol \"" + std::string(symbol) + "\" from SDP File is unknown. See 2110-30:2017 Table 1");
+			}
+
+			uint16_t group_index = (uint16_t)m_audio_description->channel_groups.size();
+			std::span<const SDPChannelRole> roles = SDPChannelGroupRoles(group.symbol);
+			for (int32_t i = 0; i < group.channel_count; i++)
+			{
+				SDPChannelRole role = roles.empty() ? SDPChannelRole::UNDEFINED : roles[i];
+				m_audio_description->channel_map.push_back({ group_index, role });
+			}
+
+			m_audio_description->channel_groups.push_back(group);
+			m_audio_description->channel_count += group.channel_count;
+
+			if (comma == std::string_view::npos)
+				break;
+
+			order.remove_prefix(comma + 1);
+		}
+
+		// Cross check with the channel count of the rtpmap (example: L24/48000/8)
+		if (!m_audio_description->attributes.rtp_map.empty())
+		{
+			std::string_view encoding = m_audio_description->attributes.rtp_map[0].encoding;
+			int32_t rtp_channels = 0;
+			auto result = std::from_chars(encoding.data(), encoding.data() + encoding.size(), rtp_channels);
+			if (result.ec == std::errc() && rtp_channels != m_audio_description->channel_count)
+			{
+				PLOG_INFO << "SDP channel-order describes " << m_audio_description->channel_count 
+					<< " channels but rtpmap declares " << rtp_channels << ".";
 			}
 		}
-		
 	}
 
 
@@ -549,7 +1224,54 @@ namespace Cf
 	/// </summary>
 	void SDPParser::ParseVideoParams()
 	{
-		// REDACTED // 
+		// SSN = SMPTE Standard Number. Required for uncompressed video, not
+		// present for compressed video.
+		const FormatParameter* parameter = FindFormatParameter("SSN");
+		SetStandard(parameter != nullptr ? parameter->value : std::string_view());
+
+		if (m_video_description->standard == SDPStandard::UNCOMPRESSED)
+			ParseUncompressedVideoParams();
+		else
+			ParseCompressedVideoParams();
+
+		///
+		/// Media Type Parameters with Default Values (ST2110-20 7.3)
+		///
+
+		// Interlace and segmented are flags without a value
+		if (FindFormatParameter("interlace") != nullptr)
+			m_video_description->interlaced = true;
+
+		if (FindFormatParameter("segmented") != nullptr)
+		{
+			if (!m_video_description->interlaced)
+				throw std::runtime_error("In the SDP, segmented is only allowed together with interlace. See 2110-20:2022 7.3");
+
+			m_video_description->segmented = true;
+		}
+
+		parameter = FindFormatParameter("TCS");
+		if (parameter != nullptr)
+			SetTCS(parameter->value);
+
+		// Checked against colorimetry, which is parsed above
+		parameter = FindFormatParameter("RANGE");
+		if (parameter != nullptr)
+			SetRange(parameter->value);
+
+		parameter = FindFormatParameter("PAR");
+		if (parameter != nullptr)
+			SetPAR(parameter->value);
+
+		parameter = FindFormatParameter("MAXUDP");
+		if (parameter != nullptr)
+			ParseInteger(parameter->value, &m_video_description->max_udp);
+
+		// TP is required for compressed video and read with it. For
+		// uncompressed video it keeps its default when not present.
+		parameter = FindFormatParameter("TP");
+		if (m_video_description->standard == SDPStandard::UNCOMPRESSED && parameter != nullptr)
+			SetTP(parameter->value);
 	}
 
 
@@ -566,66 +1288,50 @@ namespace Cf
 		/// Required Media Type Parameters (ST2110-20 7.2)
 		///
 
+		// Width and height of the image in pixels
+		const FormatParameter* parameter = FindFormatParameter("width");
+		if (parameter == nullptr || !ParseInteger(parameter->value, &m_video_description->width))
+			throw std::runtime_error("No width found in SDP. This is a required media type parameter.");
+
+		parameter = FindFormatParameter("height");
+		if (parameter == nullptr || !ParseInteger(parameter->value, &m_video_description->height))
+			throw std::runtime_error("No height found in SDP. This is a required media type parameter.");
+
 		// Framerate = Signals the frame rate in frames per second. 
 		// Can be a single decimal number (e.g. "25"), or a ratio of two int decimal numbers seperated by forward slash (e.g. "20000/1001)
-		auto iter = m_video_params_session.find("exactframerate");
-		if (iter != m_video_params_session.end())
-		{
-			if (iter->is_number()) // For case: exactframerate=25
-			{
-				m_video_description->framerate_num = *iter;
-				m_video_description->framerate_den = 1;
-			}
-			else if (iter->is_string()) // For case: exactframerate=30000/1001
-			{
-				SetFramerate(*iter);
-			}
-		}
+		parameter = FindFormatParameter("exactframerate");
+		if (parameter != nullptr)
+			SetFramerate(parameter->value);
 		else
 			throw std::runtime_error("No exactframerate found in SDP. This is a required media type parameter.");
 
 		// Depth = Signals the number of bits per sample. Can be 8, 10, 12, 16, or 16f.
-		iter = m_video_params_session.find("depth");
-		if (iter != m_video_params_session.end())
-		{
-			if (iter->is_string())
-			{
-				if (*iter == "16f")
-					m_video_description->depth = SDPDepth::FLOAT_16;
-				else
-					throw std::runtime_error("Depth value from SDP is of unsupported value");
-			}
-			else if (iter->is_number())
-			{
-				if (ValidDepth(*iter))
-					m_video_description->depth = *iter;
-			}
-		}
+		parameter = FindFormatParameter("depth");
+		if (parameter != nullptr)
+			SetDepth(parameter->value);
 		else
-		{
 			throw std::runtime_error("No depth found in SDP. This is a required media type parameter.");
-		}
 
 		// Colorimetry: Specifies the system colorimetry used by the image samples.
 		// Permitted values found in SDPColorimetry enumueration.
-		iter = m_video_params_session.find("colorimetry");
-		if (iter != m_video_params_session.end() && iter->is_string())
-			SetColorimetry(*iter);
+		parameter = FindFormatParameter("colorimetry");
+		if (parameter != nullptr)
+			SetColorimetry(parameter->value);
 		else
 			throw std::runtime_error("No colorimetry found in SDP. This is a required media type parameter.");
 
 		// Packing Mode
 		// Permitted values found in SDPPackingMode enumeration.
-		iter = m_video_params_session.find("PM");
-		if (iter != m_video_params_session.end() && iter->is_string())
-			SetPackingMode(*iter);
+		parameter = FindFormatParameter("PM");
+		if (parameter != nullptr)
+			SetPackingMode(parameter->value);
 		else
 			throw std::runtime_error("No PM (packing mode) found in SDP. This is a required media type parameter.");
 
 		// Sampling = Signals the color difference signal sub-sampling structure
-		iter = m_video_params_session.find("sampling");
-		if (iter != m_video_params_session.end() && iter->is_string())
-			SetSampling(*iter);
+		parameter = FindFormatParameter("sampling");
+		if (parameter != nullptr)
+			SetSampling(parameter->value);
 		else
 			throw std::runtime_error("No sampling found in SDP. This is a required media type parameter.");
 	}
@@ -644,106 +1350,105 @@ namespace Cf
 
 		// Framerate = Signals the frame rate in frames per second. 
 		// For compresseed video, it can be found as an attribute isntead of in the media type parameters.
-		auto iter = m_session.find("framerate");
-		if (iter == m_session.end())
+		// The attribute is media level ("a=framerate:" after "m=").
+		auto iter = m_video_description->m_session.find("framerate");
+		const FormatParameter* parameter = FindFormatParameter("exactframerate");
+		if (iter != m_video_description->m_session.end())
 		{
-			iter = m_video_params_session.find("exactframerate");
-			if (iter == m_video_params_session.end())
-				throw std::runtime_error("No framerate found in SDP. This is a required media type parameter.");
+			if (iter->is_number_integer()) // For case: framerate=25
+			{
+				m_video_description->framerate = Rational(iter->get<int64_t>(), 1);
+			}
+			else if (iter->is_number()) // For case: framerate=29.97
+			{
+				SetFramerate(iter->dump());
+			}
+			else if (iter->is_string()) // For case: framerate=30000.1001
+			{
+				SetFramerate(iter->get_ref<const std::string&>());
+			}
 		}
-
-		// Framerate value found in either attribute or media type parameter location
-		if (iter->is_number()) // For case: framerate=25 or exactframerate=25
+		else if (parameter != nullptr) // For case: exactframerate=30000/1001
 		{
-			m_video_description->framerate_num = *iter;
-			m_video_description->framerate_den = 1;
+			SetFramerate(parameter->value);
 		}
-		else if (iter->is_string()) // For case: framerate=30000.1001 or exactframerate = 30000/1001
+		else
 		{
-			SetFramerate(*iter);
+			throw std::runtime_error("No framerate found in SDP. This is a required media type parameter.");
 		}
 
 		// TP (traffic and delievery)
-		iter = m_video_params_session.find("TP");
-		if (iter != m_video_params_session.end() && iter->is_string())
-			SetTP(*iter);
+		parameter = FindFormatParameter("TP");
+		if (parameter != nullptr)
+			SetTP(parameter->value);
 		else
 			throw std::runtime_error("No TP found in SDP. This is a required media type parameter.");
 
 
 		/// Optional? Parameters in Compressed Video. Spec doesn't say otherwise, but they can arise..
 
-		iter = m_video_params_session.find("CMAX");
-		if (iter != m_video_params_session.end() && iter->is_number())
-			m_video_description->cmax = *iter;
+		parameter = FindFormatParameter("CMAX");
+		if (parameter != nullptr)
+			ParseInteger(parameter->value, &m_video_description->cmax);
+
+		parameter = FindFormatParameter("width");
+		if (parameter != nullptr)
+			ParseInteger(parameter->value, &m_video_description->width);
+
+		parameter = FindFormatParameter("height");
+		if (parameter != nullptr)
+			ParseInteger(parameter->value, &m_video_description->height);
 
 		// Depth = Signals the number of bits per sample. Can be 8, 10, 12, 16, or 16f.
-		iter = m_video_params_session.find("depth");
-		if (iter != m_video_params_session.end())
-		{
-			if (iter->is_string())
-			{
-				if (*iter == "16f")
-					m_video_description->depth = SDPDepth::FLOAT_16;
-				else
-					throw std::runtime_error("Depth value from SDP is of unsupported value");
-			}
-			else if (iter->is_number())
-			{
-				if (ValidDepth(*iter))
-					m_video_description->depth = *iter;
-			}
-		}
+		parameter = FindFormatParameter("depth");
+		if (parameter != nullptr)
+			SetDepth(parameter->value);
 
 		// Colorimetry: Specifies the system colorimetry used by the image samples.
 		// Permitted values found in SDPColorimetry enumueration.
-		iter = m_video_params_session.find("colorimetry");
-		if (iter != m_video_params_session.end() && iter->is_string())
-			SetColorimetry(*iter);
+		parameter = FindFormatParameter("colorimetry");
+		if (parameter != nullptr)
+			SetColorimetry(parameter->value);
 
 		// Packing Mode
 		// Permitted values found in SDPPackingMode enumeration.
-		iter = m_video_params_session.find("PM");
-		if (iter != m_video_params_session.end() && iter->is_string())
-			SetPackingMode(*iter);
+		parameter = FindFormatParameter("PM");
+		if (parameter != nullptr)
+			SetPackingMode(parameter->value);
 
 		// Sampling = Signals the color difference signal sub-sampling structure
-		iter = m_video_params_session.find("sampling");
-		if (iter != m_video_params_session.end() && iter->is_string())
-			SetSampling(*iter);
+		parameter = FindFormatParameter("sampling");
+		if (parameter != nullptr)
+			SetSampling(parameter->value);
 	}
 
 
 	/// <summary>
-	/// SetFramerate: Finds and sets framerate numerator and denominator from 
-	///				  the SDP in the deserialized video_description.
+	/// SetFramerate: Parses the framerate from the SDP into an exact rational
+	///				  in the deserialized video_description. See Rational for
+	///				  the accepted forms.
 	/// </summary>
-	void SDPParser::SetFramerate(std::string framerate_string)
+	void SDPParser::SetFramerate(std::string_view framerate_string)
 	{
-		// Regex Pattern for Framerate string. 
-		// Examples: "30000.1001" or "30000/1001"
-		std::regex pattern1("(\\d+)\\.(\\d+)");
-		std::regex pattern2("(\\d+)\\/(\\d+)");
-		std::smatch matches;
-
-		// regex_search produces:
-		// matches[0] = the full match, matches[1] = group 1, matches[2] = group 2
-		if (std::regex_search(framerate_string, matches, pattern1))
-		{
-			m_video_description->framerate_num = stoi(matches[1]);
-			m_video_description->framerate_den = stoi(matches[2]);
-			return;
-		}
-		else if (std::regex_search(framerate_string, matches, pattern2))
-		{
-			m_video_description->framerate_num = stoi(matches[1]);
-			m_video_description->framerate_den = stoi(matches[2]);
-			return;
-		}
-		else
-		{
+		std::optional<Rational> framerate = Rational::Parse(framerate_string);
+		if (!framerate)
 			throw std::runtime_error("Framerate from SDP File is of unknown format. See 2110-20:2022 7.2 or 2110-22:2022 7.4 for valid format descriptions.");
-		}
+
+		m_video_description->framerate = *framerate;
+	}
+
+
+	/// <summary>
+	/// SetDepth: Sets depth (bits per sample) from the SDP as an enum in the
+	///			  deserialized video_description.
+	/// </summary>
+	void SDPParser::SetDepth(std::string_view depth)
+	{
+		std::optional<SDPDepth> value = SDPEnumFromString<SDPDepth>(depth);
+		if (!value)
+			throw std::runtime_error("Depth value from SDP is of unsupported value. See 2110-20:2022 7.4.2 for valid values");
+
+		m_video_description->depth = *value;
 	}
 
 
@@ -751,28 +1456,13 @@ namespace Cf
 	/// SetColorimetry: Sets colorimetry from the SDP as an enum in the
 	///					deserialized video_description.
 	/// </summary>
-	void SDPParser::SetColorimetry(std::string colorimetry)
-	{
-		if (colorimetry == "BT601")
-			m_video_description->colorimetry = SDPColorimetry::BT601;
-		else if (colorimetry == "BT709")
-			m_video_description->colorimetry = SDPColorimetry::BT709;
-		else if (colorimetry == "BT2020")
-			m_video_description->colorimetry = SDPColorimetry::BT2020;
-		else if (colorimetry == "BT2100")
-			m_video_description->colorimetry = SDPColorimetry::BT2100;
-		else if (colorimetry == "ST2065-1")
-			m_video_description->colorimetry = SDPColorimetry::ST2065_1;
-		else if (colorimetry == "ST2065-3")
-			m_video_description->colorimetry = SDPColorimetry::ST2065_3;
-		else if (colorimetry == "UNSPECIFIED")
-			m_video_description->colorimetry = SDPColorimetry::UNSPECIFIED;
-		else if (colorimetry == "XYZ")
-			m_video_description->colorimetry = SDPColorimetry::XYZ;
-		else if (colorimetry == "ALPHA")
-			m_video_description->colorimetry = SDPColorimetry::ALPHA;
-		else
+	void SDPParser::SetColorimetry(std::string_view colorimetry)
+	{
+		std::optional<SDPColorimetry> value = SDPEnumFromString<SDPColorimetry>(colorimetry);
+		if (!value)
 			throw std::runtime_error("Colorimetry type from SDP File is of unsupported type. See 2110-20:2022 7.5 for valid types");
+
+		m_video_description->colorimetry = *value;
 	}
 
 
@@ -780,12 +1470,11 @@ namespace Cf
 	/// SetPackingMode: Sets packing mode from the SDP as an enum in the
 	///					deserialized video_description.
 	/// </summary>
-	void SDPParser::SetPackingMode(std::string packing_mode)
+	void SDPParser::SetPackingMode(std::string_view packing_mode)
 	{
-		if (packing_mode == "2110GPM")
-			m_video_description->packing_mode = SDPPackingMode::GPM;
-		else if (packing_mode == "2110BPM")
-			m_video_description->packing_mode = SDPPackingMode::BPM;
+		std::optional<SDPPackingMode> value = SDPEnumFromString<SDPPackingMode>(packing_mode);
+		if (value)
+			m_video_description->packing_mode = *value;
 	}
 
 
@@ -793,33 +1482,13 @@ namespace Cf
 	/// SetTCS: Sets TCS (Transfer characteristic system) from the SDP as an 
 	///		    enum in the deserialized video_description.
 	/// </summary>
-	void SDPParser::SetTCS(std::string tcs)
-	{
-		if (tcs == "SDR")
-			m_video_description->tcs = SDPTransferCharacteristicSystem::SDR;
-		else if (tcs == "PQ")
-			m_video_description->tcs = SDPTransferCharacteristicSystem::PQ;
-		else if (tcs == "HLG")
-			m_video_description->tcs = SDPTransferCharacteristicSystem::HLG;
-		else if (tcs == "LINEAR")
-			m_video_description->tcs = SDPTransferCharacteristicSystem::LINEAR;
-		else if (tcs == "BT2100LINPQ")
-			m_video_description->tcs = SDPTransferCharacteristicSystem::BT2100LINPQ;
-		else if (tcs == "BT2100LINHLG")
-			m_video_description->tcs = SDPTransferCharacteristicSystem::BT2100LINHLG;
-		else if (tcs == "ST2065-1")
-			m_video_description->tcs = SDPTransferCharacteristicSystem::ST2065_1;
-		else if (tcs == "ST428-1")
-			m_video_description->tcs = SDPTransferCharacteristicSystem::ST428_1;
-		else if (tcs == "DENSITY")
-			m_video_description->tcs = SDPTransferCharacteristicSystem::DENSITY;
-		else if (tcs == "ST2115LOGS3")
-			m_video_description->tcs = SDPTransferCharacteristicSystem::ST2115LOGS3;
-		else if (tcs == "UNSPECIFIED")
-			m_video_description->tcs = SDPTransferCharacteristicSystem::UNSPECIFIED;
-		else
+	void SDPParser::SetTCS(std::string_view tcs)
+	{
+		std::optional<SDPTransferCharacteristicSystem> value = SDPEnumFromString<SDPTransferCharacteristicSystem>(tcs);
+		if (!value)
 			throw std::runtime_error("TCS from SDP File is of unsupported type. See 2110-20:2022 7.6 for valid types");
 
+		m_video_description->tcs = *value;
 	}
 
 
@@ -827,17 +1496,14 @@ namespace Cf
 	/// SetRange: Sets range from the SDP as an enum in the deserialized 
 	///			  video_description.
 	/// </summary>
-	void SDPParser::SetRange(std::string range)
+	void SDPParser::SetRange(std::string_view range)
 	{
-		if (range == "NARROW")
-			m_video_description->range = SDPRange::NARROW;
-		else if (range == "FULLPROTECT")
-			m_video_description->range = SDPRange::FULLPROTECT;
-		else if (range == "FULL")
-			m_video_description->range = SDPRange::FULL;
-		else
+		std::optional<SDPRange> value = SDPEnumFromString<SDPRange>(range);
+		if (!value)
 			throw std::runtime_error("RANGE type from SDP file is of unsupported type. See 2110-20:2022 7.3 for valid types");
 
+		m_video_description->range = *value;
+
 		if (m_video_description->colorimetry == SDPColorimetry::BT2100)
 		{
 			if (m_video_description->range != SDPRange::NARROW && m_video_description->range != SDPRange::FULL)
@@ -850,23 +1516,22 @@ namespace Cf
 	/// SetPAR: Finds and sets PAR (pixel aspect ratio) from the SDP in the
 	///			deserialized video_description.
 	/// </summary>
-	void SDPParser::SetPAR(std::string par)
+	void SDPParser::SetPAR(std::string_view par)
 	{
-		// Regex Pattern for pixel aspect ratio string. Example: "1:1"
-		std::regex pattern("(\\d+):(\\d+)");
-		std::smatch matches;
+		// Pixel aspect ratio string. Example: "1:1"
+		int32_t width = 0;
+		int32_t height = 0;
+		const char* end = par.data() + par.size();
 
-		// regex_search produces:
-		// matches[0] = the full match, matches[1] = group 1, matches[2] = group 2
-		if (std::regex_search(par, matches, pattern))
-		{
-			m_video_description->par_width = stoi(matches[1]);
-			m_video_description->par_height = stoi(matches[2]);
-		}
-		else
-		{
+		auto result = std::from_chars(par.data(), end, width);
+		if (result.ec == std::errc() && result.ptr != end && *result.ptr == ':')
+			result = std::from_chars(result.ptr + 1, end, height);
+
+		if (result.ec != std::errc() || width <= 0 || height <= 0)
 			throw std::runtime_error("PAR (Pixel Aspect Ratio) from SDP File is of unknown format. See 2110-20:2022 7.3 for valid format description.");
-		}
+
+		m_video_description->par_width = width;
+		m_video_description->par_height = height;
 	}
 
 
@@ -874,17 +1539,13 @@ namespace Cf
 	/// SetTP: Sets TP (traffic shape) from the SDP as an enum in the
 	///		   deserialized video_description.
 	/// </summary>
-	void SDPParser::SetTP(std::string TP)
+	void SDPParser::SetTP(std::string_view TP)
 	{
-		if (TP == "2110TPN")
-			m_video_description->tp = SDP_TP::NARROW;
-		else if (TP == "2110TPNL")
-			m_video_description->tp = SDP_TP::NARROWLINEAR;
-		else if (TP == "2110TPW")
-			m_video_description->tp = SDP_TP::WIDE;
-		else
+		std::optional<SDP_TP> value = SDPEnumFromString<SDP_TP>(TP);
+		if (!value)
 			throw std::runtime_error("TP from SDP File is of unknown type. See 2110-22:2022 5.3 for valid types.");
 
+		m_video_description->tp = *value;
 	}
 
 
@@ -892,40 +1553,19 @@ namespace Cf
 	/// SetSampling: Sets sampling from the SDP as an enum in the deserialized
 	///			     video_description.
 	/// </summary>
-	void SDPParser::SetSampling(std::string sampling)
-	{
-		if (sampling == "YCbCr-4:4:4")
-			m_video_description->sampling = SDPSampling::YCBCR_444;
-		else if (sampling == "YCbCr-4:2:2")
-			m_video_description->sampling = SDPSampling::YCBCR_422;
-		else if (sampling == "YCbCr-4:2:0")
-			m_video_description->sampling = SDPSampling::YCBCR_420;
-		else if (sampling == "CLYCbCr-4:4:4")
-			m_video_description->sampling = SDPSampling::CLYCBCR_444;
-		else if (sampling == "CLYCbCr-4:2:2")
-			m_video_description->sampling = SDPSampling::CLYCBCR_422;
-		else if (sampling == "CLYCbCr-4:2:0")
-			m_video_description->sampling = SDPSampling::CLYCBCR_420;
-		else if (sampling == "ICtCp-4:4:4")
-			m_video_description->sampling = SDPSampling::ICTCP_444;
-		else if (sampling == "ICtCp-4:2:2")
-			m_video_description->sampling = SDPSampling::ICTCP_422;
-		else if (sampling == "ICtCp-4:2:0")
-			m_video_description->sampling = SDPSampling::ICTCP_420;
-		else if (sampling == "RGB")
-			m_video_description->sampling = SDPSampling::RGB;
-		else if (sampling == "XYZ")
-			m_video_description->sampling = SDPSampling::XYZ;
-		else if (sampling == "KEY")
-		{
-			m_video_description->sampling = SDPSampling::KEY;
+	void SDPParser::SetSampling(std::string_view sampling)
+	{
+		std::optional<SDPSampling> value = SDPEnumFromString<SDPSampling>(sampling);
+		if (!value)
+			throw std::runtime_error("Sampling from SDP File is of unknown format. See 2110-20:2022 7.3 for valid format description.");
+
+		m_video_description->sampling = *value;
+
+		if (*value == SDPSampling::KEY)
+		{
 			PLOG_INFO << "KEY sampling from SDP not implemented.";
 			throw std::runtime_error("KEY sampling declared in SDP is not supported");
 		}
-		else
-		{
-			throw std::runtime_error("Sampling from SDP File is of unknown format. See 2110-20:2022 7.3 for valid format description.");
-		}
 	}
 
 	
@@ -933,54 +1573,22 @@ namespace Cf
 	/// SetStandard: Finds and sets 2110 standard (jpegxs or uncompresesd) from
 	///				 the SDP in the deserialized video_description.
 	/// </summary>
-	void SDPParser::SetStandard(std::string standard)
+	void SDPParser::SetStandard(std::string_view standard)
 	{
 		// Param not required for compressed video SDPs.
-		if (standard == "")
+		if (standard.empty())
 		{
 			m_video_description->standard = SDPStandard::JPEGXS;
 			return;
 		}
 
-		std::regex pattern("ST2110-(\\d+):\\d+");
-		std::smatch matches;
-		if (std::regex_search(standard, matches, pattern))
-		{
-			if (matches[1].str() == "22")
-			{
-				m_video_description->standard = SDPStandard::JPEGXS;
-				return;
-			}
-			else if (matches[1].str() == "20")
-			{
-				m_video_description->standard = SDPStandard::UNCOMPRESSED;
-				return;
-			}
-		}
+		// SSN is "ST2110-<part>:<year>", the year does not change the standard
+		std::optional<SDPStandard> value = SDPEnumFromString<SDPStandard>(standard.substr(0, standard.find(':')));
+		if (!value || standard.find(':') == std::string_view::npos)
+			throw std::runtime_error("SMPTE Standard Number (SSN) \"" + std::string(standard) + "\" was not recognized");
 
-		throw std::runtime_error("SMPTE Standard Number (SSN) \"" + standard + "\" was not recognized");
+		m_video_description->standard = *value;
 	}
 
 
-	/// <summary>
-	/// ValidDepth: Returns true if depth is valid for a 2110 stream.
-	/// </summary>
-	bool SDPParser::ValidDepth(int32_t depth)
-	{
-		switch ((SDPDepth)depth)
-		{
-		case SDPDepth::INT_8:
-			break;
-		case SDPDepth::INT_10:
-			break;
-		case SDPDepth::INT_12:
-			break;
-		case SDPDepth::INT_16:
-			break;
-		default:
-			throw std::runtime_error("Depth value from SDP is of unsupported value. See 2110-20:2022 7.4.2 for valid values");
-		}
-
-		return true;
-	}
 }
\ No newline at end of file
@@ -26,15 +26,39 @@ By using the Code, Licensee agrees to these terms.
 
 namespace Cf
 {
+	/// <summary>
+	/// SDPParserSettings: How an SDPParser reads SDP text.
+	/// </summary>
+	struct SDPParserSettings
+	{
+	public:
+		// SDPs from third-party devices go through sdptransform's bounded
+		// parse, which rejects one past these limits rather than taking
+		// unbounded time or stack on it
+		bool bounded = false;
+		sdptransform::ParseLimits limits;
+	};
+
+
 	class SDPParser
 	{
 	public:
 		
-		// Constructor
-		SDPParser(std::string SDP);
+		// Constructors. The third parses the given SDP right away.
+		SDPParser() = default;
+		explicit SDPParser(const SDPParserSettings& settings);
+		SDPParser(std::string SDP, const SDPParserSettings& settings = {});
+
+		// Parses an SDP, replacing the previous result. The parser keeps its
+		// buffers between calls, so one long-lived parser per thread parses
+		// with little allocator traffic.
+		const SDP& Parse(std::string_view SDP);
+
+		// Drops the last parse result and keeps its memory for the next one
+		void Reset();
 
 		// Main function to parse/receive the de-serialized SDP
-		SDP GetSDP();
+		const SDP& GetSDP() const;
 
 	private:
 
@@ -42,48 +66,78 @@ namespace Cf
 		void ParseSessionDescription();
 		void ParseTimingDescription();
 		void ParseMediaDescriptions();
-		void ParseVideoDescription(json video_description_session);
-		void ParseAudioDescription(json audio_description_session);
-		void ParseDataDescription(json data_description_session);
+		void ParseVideoDescription(json&& media_session);
+		void ParseAudioDescription(json&& media_session);
+		void ParseDataDescription(json&& media_session);
 
 		// Session/General helpers
 		void ParseOrigin();
 		void ParseBandwidthInformation();
-		void ParseConnectionInformation(SDP::ConnectionInformation* connection_information_ptr, json session);
-		void ParseAttributes(SDP::Attributes* attribute_ptr, json session);
+		void ParsePayloadTypes(SDP::MediaDescription* media_description_ptr);
+		void ParseConnectionInformation(SDP::ConnectionInformation* connection_information_ptr, const json& session);
+		void ParseAttributes(SDP::Attributes* attribute_ptr, const json& session);
+		void ResolveEndpoint(SDP::MediaDescription* media_description_ptr);
+		void ResolveClocks(SDP::MediaDescription* media_description_ptr, uint32_t default_clock_rate);
+		bool ParseReferenceClock(std::string_view value, SDP::Attributes::ReferenceClock* reference_clock_ptr);
+		bool ParseMediaClock(std::string_view value, SDP::Attributes::MediaClock* media_clock_ptr);
+		bool ParseEui(std::string_view eui, size_t octets, uint64_t* eui_ptr);
+		bool ResolveAddress(std::string_view address, int32_t family, SDP::SocketAddress* socket_address_ptr);
+		void IndexMediaDescription(const SDP::MediaDescription& media_description, std::vector<uint32_t>& type_indices);
+
+		template<typename Description>
+		Description* AddMediaDescription(json&& media_session);
+
+		// Media type parameters ("a=fmtp:") of the media description being
+		// parsed, as views into its fmtp config
+		struct FormatParameter
+		{
+			std::string_view name;
+			std::string_view value;
+		};
+		SmallVector<FormatParameter, 16> m_format_parameters;
+		void ParseFormatParameters(const SDP::MediaDescription& media_description);
+		const FormatParameter* FindFormatParameter(std::string_view name) const;
+		static bool ParseInteger(std::string_view text, int32_t* value_ptr);
 
 		// Video Description helpers
-		json m_video_params_session;
-		shared_ptr<SDP::VideoDescription> m_video_description;
+		SDP::VideoDescription* m_video_description = nullptr;
 		void ParseVideoParams();
 		void ParseUncompressedVideoParams(); 
 		void ParseCompressedVideoParams();
-		void SetFramerate(std::string framerate_string);
-		void SetColorimetry(std::string colorimetry); 
-		void SetPackingMode(std::string packing_mode);
-		void SetTCS(std::string tcs);
-		void SetRange(std::string range);
-		void SetPAR(std::string par);
-		void SetTP(std::string TP);
-		void SetSampling(std::string sampling);
-		void SetStandard(std::string standard);
-		bool ValidDepth(int32_t depth);
+		void SetFramerate(std::string_view framerate_string);
+		void SetDepth(std::string_view depth);
+		void SetColorimetry(std::string_view colorimetry); 
+		void SetPackingMode(std::string_view packing_mode);
+		void SetTCS(std::string_view tcs);
+		void SetRange(std::string_view range);
+		void SetPAR(std::string_view par);
+		void SetTP(std::string_view TP);
+		void SetSampling(std::string_view sampling);
+		void SetStandard(std::string_view standard);
 
 		// Audio Description helpers
-		json m_audio_params_session;
-		shared_ptr<SDP::AudioDescription> m_audio_description;
+		SDP::AudioDescription* m_audio_description = nullptr;
 		void ParseAudioParams();
+		void ParseChannelOrder();
 
 		// Data Description helpers
-		json m_data_params_session;
-		shared_ptr<SDP::DataDescription> m_data_description;
+		SDP::DataDescription* m_data_description = nullptr;
 
 		// Helper functions
 		std::string GetSDPFileString(std::string SDPFilePath);
 
+		SDPParserSettings m_settings;
+
+		// SDP text handed to sdptransform, kept for its capacity
+		std::string m_sdp_text;
+
 		// Full SDP as Json
 		json m_session; 
 
+		// Media descriptions of earlier parses, reused by 
+		// AddMediaDescription() for their string and container capacity
+		std::vector<SDP::MediaVariant> m_media_pool;
+
 		// Deserialized SDP
 		SDP m_sdp;	
 	};
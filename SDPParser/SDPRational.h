@@ -0,0 +1,386 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	namespace RationalDetail
+	{
+		/// <summary>
+		/// MulDiv: floor(a * b / c) without intermediate overflow.
+		/// </summary>
+		inline uint64_t MulDiv(uint64_t a, uint64_t b, uint64_t c)
+		{
+#if defined(__SIZEOF_INT128__)
+			return (uint64_t)(((unsigned __int128)a * b) / c);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			uint64_t high;
+			uint64_t low = _umul128(a, b, &high);
+			uint64_t remainder;
+			return _udiv128(high, low, c, &remainder);
+#else
+			return (a / c) * b + (uint64_t)(((long double)(a % c) * b) / c);
+#endif
+		}
+	}
+
+
+	/// <summary>
+	/// Rational: Exact frame rate as numerator/denominator, always kept in
+	///			  lowest terms. Parsed without regex from every frame rate
+	///			  form found in 2110 SDPs:
+	/// <para>
+	///		"25"			  -> 25/1 </para>
+	/// <para>
+	///		"30000/1001"	  -> 30000/1001 (exactframerate, 2110-20:2022 7.2) </para>
+	/// <para>
+	///		"29.97", "23.976" -> 30000/1001, 24000/1001 (a=framerate, the
+	///							 1000/1001 rates written as decimals) </para>
+	/// <para>
+	///		"12.5"			  -> 25/2 (any other decimal is taken exactly) </para>
+	/// <para>
+	///		"30000.1001"	  -> 30000/1001 (legacy form with '.' as the
+	///							 separator, only for a "1001" denominator) </para>
+	/// </summary>
+	struct Rational
+	{
+	public:
+		int32_t num = 0;
+		int32_t den = 1;
+
+		constexpr Rational() = default;
+
+		constexpr Rational(int64_t numerator, int64_t denominator = 1)
+		{
+			if (denominator < 0)
+			{
+				numerator = -numerator;
+				denominator = -denominator;
+			}
+
+			int64_t divisor = std::gcd(numerator, denominator);
+			if (divisor == 0)
+				divisor = 1;
+
+			num = (int32_t)(numerator / divisor);
+			den = (int32_t)(denominator / divisor);
+		}
+
+		constexpr bool IsValid() const { return num > 0 && den > 0; }
+
+		constexpr double ToDouble() const { return (double)num / den; }
+
+		constexpr bool operator==(const Rational& other) const = default;
+
+
+		/// <summary>
+		/// Parse: Parses a frame rate string. Returns std::nullopt if the
+		///		   text is not a positive frame rate.
+		/// </summary>
+		static std::optional<Rational> Parse(std::string_view text)
+		{
+			while (!text.empty() && text.front() == ' ')
+				text.remove_prefix(1);
+			while (!text.empty() && text.back() == ' ')
+				text.remove_suffix(1);
+
+			size_t separator = text.find_first_of("/.");
+			std::string_view whole = text.substr(0, separator);
+
+			int64_t integer = 0;
+			if (!ParseDigits(whole, &integer))
+				return std::nullopt;
+
+			// "25"
+			if (separator == std::string_view::npos)
+				return Make(integer, 1);
+
+			std::string_view fraction = text.substr(separator + 1);
+			int64_t fraction_value = 0;
+			if (!ParseDigits(fraction, &fraction_value))
+				return std::nullopt;
+
+			// "30000/1001"
+			if (text[separator] == '/')
+				return Make(integer, fraction_value);
+
+			// "30000.1001"
+			if (fraction == "1001" && integer >= 1000 && integer % 1000 == 0)
+				return Make(integer, 1001);
+
+			// Decimal. Limit to 9 digits so the exact value fits in 64 bits.
+			if (fraction.size() > 9 || integer > INT32_MAX)
+				return std::nullopt;
+
+			int64_t scale = 1;
+			for (size_t i = 0; i < fraction.size(); i++)
+				scale *= 10;
+
+			// "29.97" and friends are a rounded N*1000/1001. Match them when
+			// the written value is within half a unit of its last digit.
+			if (fraction_value != 0 && integer < 1000 && fraction.size() <= 6)
+			{
+				int64_t nominal = (integer * scale + fraction_value) * 1001 / (1000 * scale);
+				for (int64_t candidate = nominal; candidate <= nominal + 1; candidate++)
+				{
+					// |value - candidate*1000/1001| < 0.5/scale, in integers
+					int64_t difference = (integer * scale + fraction_value) * 1001 * 2 - candidate * 1000 * scale * 2;
+					if (difference < 0)
+						difference = -difference;
+
+					if (candidate > 0 && difference < 1001)
+						return Make(candidate * 1000, 1001);
+				}
+			}
+
+			return Make(integer * scale + fraction_value, scale);
+		}
+
+	private:
+
+		static constexpr bool ParseDigits(std::string_view digits, int64_t* value_ptr)
+		{
+			if (digits.empty() || digits.size() > 18)
+				return false;
+
+			int64_t value = 0;
+			for (char c : digits)
+			{
+				if (c < '0' || c > '9')
+					return false;
+
+				value = value * 10 + (c - '0');
+			}
+
+			*value_ptr = value;
+			return true;
+		}
+
+		static constexpr std::optional<Rational> Make(int64_t numerator, int64_t denominator)
+		{
+			if (numerator <= 0 || denominator <= 0)
+				return std::nullopt;
+
+			int64_t divisor = std::gcd(numerator, denominator);
+			if (numerator / divisor > INT32_MAX || denominator / divisor > INT32_MAX)
+				return std::nullopt;
+
+			return Rational(numerator / divisor, denominator / divisor);
+		}
+	};
+
+
+	/// <summary>
+	/// FrameTiming: Per-frame timing for one frame rate and RTP clock rate,
+	///				 precomputed once so receivers and senders only do integer
+	///				 arithmetic per frame. RTP timestamps of frame n are
+	///				 floor(n * clock_rate * den / num), which gives the
+	///				 alternating cadence for rates such as 60000/1001 at
+	///				 90 kHz (1501, 1502, 1501, ...).
+	/// </summary>
+	class FrameTiming
+	{
+	public:
+		FrameTiming() = default;
+
+		FrameTiming(Rational framerate, uint32_t clock_rate = 90000)
+		{
+			if (!framerate.IsValid() || clock_rate == 0)
+				throw std::runtime_error("FrameTiming: Frame rate and clock rate must be positive");
+
+			m_framerate = framerate;
+			m_clock_rate = clock_rate;
+
+			m_ticks_numerator = (uint64_t)clock_rate * (uint64_t)framerate.den;
+			m_ticks_per_frame = m_ticks_numerator / (uint64_t)framerate.num;
+			m_integer_ticks = m_ticks_numerator % (uint64_t)framerate.num == 0;
+
+			// Nanoseconds per frame as a reduced fraction
+			uint64_t ns_numerator = 1000000000ull * (uint64_t)framerate.den;
+			uint64_t divisor = std::gcd(ns_numerator, (uint64_t)framerate.num);
+			m_ns_numerator = ns_numerator / divisor;
+			m_ns_denominator = (uint64_t)framerate.num / divisor;
+		}
+
+		Rational GetFramerate() const { return m_framerate; }
+		uint32_t GetClockRate() const { return m_clock_rate; }
+
+		// Frame duration rounded down to whole nanoseconds. Use FrameToNs()
+		// to place frames without accumulating the rounding error.
+		int64_t GetFrameDurationNs() const { return (int64_t)(m_ns_numerator / m_ns_denominator); }
+
+		// Nominal RTP ticks per frame. Exact when HasIntegerTicks() is true,
+		// otherwise the smaller of the two cadence values.
+		uint32_t GetTicksPerFrame() const { return (uint32_t)m_ticks_per_frame; }
+		bool HasIntegerTicks() const { return m_integer_ticks; }
+
+		// RTP ticks from frame n to frame n + 1, following the cadence
+		uint32_t GetTicksForFrame(uint64_t frame_index) const
+		{
+			return (uint32_t)(GetFrameTicks(frame_index + 1) - GetFrameTicks(frame_index));
+		}
+
+		// Unwrapped RTP ticks of frame n since the epoch
+		uint64_t GetFrameTicks(uint64_t frame_index) const
+		{
+			if (m_integer_ticks)
+				return frame_index * m_ticks_per_frame;
+
+			return RationalDetail::MulDiv(frame_index, m_ticks_numerator, (uint64_t)m_framerate.num);
+		}
+
+		// 32 bit RTP timestamp of frame n
+		uint32_t FrameToRtp(uint64_t frame_index) const { return (uint32_t)GetFrameTicks(frame_index); }
+
+		// Index of the first frame whose timestamp is at or after the given
+		// unwrapped tick count. Exact inverse of GetFrameTicks().
+		uint64_t TicksToFrame(uint64_t ticks) const
+		{
+			uint64_t frame_index = RationalDetail::MulDiv(ticks, (uint64_t)m_framerate.num, m_ticks_numerator);
+			if (GetFrameTicks(frame_index) < ticks)
+				frame_index++;
+
+			return frame_index;
+		}
+
+		// Frame index of a wrapped 32 bit RTP timestamp, unwrapped relative
+		// to a nearby known frame (within +/- 2^31 ticks).
+		uint64_t RtpToFrame(uint32_t rtp_timestamp, uint64_t reference_frame) const
+		{
+			uint64_t reference_ticks = GetFrameTicks(reference_frame);
+			int32_t delta = (int32_t)(rtp_timestamp - (uint32_t)reference_ticks);
+			if (delta < 0 && (uint64_t)(-(int64_t)delta) > reference_ticks)
+				return 0;
+
+			return TicksToFrame(reference_ticks + delta);
+		}
+
+		// Start time of frame n in nanoseconds since the epoch
+		int64_t FrameToNs(uint64_t frame_index) const
+		{
+			return (int64_t)RationalDetail::MulDiv(frame_index, m_ns_numerator, m_ns_denominator);
+		}
+
+		// Index of the frame in progress at the given time since the epoch
+		uint64_t NsToFrame(int64_t ns) const
+		{
+			uint64_t frame_index = RationalDetail::MulDiv((uint64_t)ns, m_ns_denominator, m_ns_numerator);
+			if (FrameToNs(frame_index + 1) <= ns)
+				frame_index++;
+
+			return frame_index;
+		}
+
+	private:
+		Rational m_framerate = Rational(1, 1);
+		uint32_t m_clock_rate = 90000;
+
+		uint64_t m_ticks_numerator = 90000;
+		uint64_t m_ticks_per_frame = 90000;
+		bool m_integer_ticks = true;
+
+		uint64_t m_ns_numerator = 1000000000;
+		uint64_t m_ns_denominator = 1;
+	};
+
+
+	/// <summary>
+	/// RtpClock: RTP timestamps of a stream against TAI time, the PTP
+	///			  timescale, for an RTP clock rate and the "a=mediaclk:"
+	///			  direct offset and rate. The RTP timestamp at TAI time t
+	///			  (ns since the PTP epoch) is
+	///			  offset + floor(t * clock_rate * rate / 10^9) mod 2^32
+	///			  (2110-10:2022 8.2, RFC 7273 5.2). The ratio is reduced
+	///			  once, so conversions are one 128 bit multiply and divide.
+	/// </summary>
+	class RtpClock
+	{
+	public:
+		RtpClock() = default;
+
+		RtpClock(uint32_t clock_rate, uint32_t offset = 0, Rational rate = Rational(1, 1))
+		{
+			if (clock_rate == 0 || !rate.IsValid())
+				throw std::runtime_error("RtpClock: Clock rate and media clock rate must be positive");
+
+			m_clock_rate = clock_rate;
+			m_offset = offset;
+			m_rate = rate;
+
+			// Ticks per nanosecond as a reduced fraction
+			uint64_t ticks_numerator = (uint64_t)clock_rate * (uint64_t)rate.num;
+			uint64_t ns_denominator = 1000000000ull * (uint64_t)rate.den;
+			uint64_t divisor = std::gcd(ticks_numerator, ns_denominator);
+			m_ticks_numerator = ticks_numerator / divisor;
+			m_ns_denominator = ns_denominator / divisor;
+		}
+
+		uint32_t GetClockRate() const { return m_clock_rate; }
+		uint32_t GetOffset() const { return m_offset; }
+		Rational GetRate() const { return m_rate; }
+
+		// Media clock ticks at a TAI time, unwrapped and without the offset
+		uint64_t NsToTicks(int64_t tai_ns) const
+		{
+			return RationalDetail::MulDiv((uint64_t)tai_ns, m_ticks_numerator, m_ns_denominator);
+		}
+
+		// First TAI time at which the media clock reaches the given
+		// unwrapped tick count. Exact inverse of NsToTicks().
+		int64_t TicksToNs(uint64_t ticks) const
+		{
+			uint64_t ns = RationalDetail::MulDiv(ticks, m_ns_denominator, m_ticks_numerator);
+			if (NsToTicks((int64_t)ns) < ticks)
+				ns++;
+
+			return (int64_t)ns;
+		}
+
+		// 32 bit RTP timestamp of a sample taken at a TAI time
+		uint32_t TaiToRtp(int64_t tai_ns) const { return (uint32_t)(NsToTicks(tai_ns) + m_offset); }
+
+		// TAI time of a wrapped RTP timestamp, unwrapped relative to a
+		// nearby TAI time such as the receive time (within +/- 2^31 ticks,
+		// 6.6 hours at 90 kHz). TaiToRtp() of the result gives the
+		// timestamp back.
+		int64_t RtpToTai(uint32_t rtp_timestamp, int64_t reference_tai_ns) const
+		{
+			uint64_t reference_ticks = NsToTicks(reference_tai_ns);
+			int32_t delta = (int32_t)(rtp_timestamp - (uint32_t)(reference_ticks + m_offset));
+			if (delta < 0 && (uint64_t)(-(int64_t)delta) > reference_ticks)
+				return 0;
+
+			return TicksToNs(reference_ticks + delta);
+		}
+
+	private:
+		uint32_t m_clock_rate = 90000;
+		uint32_t m_offset = 0;
+		Rational m_rate = Rational(1, 1);
+
+		uint64_t m_ticks_numerator = 9;
+		uint64_t m_ns_denominator = 100000;
+	};
+}
@@ -0,0 +1,257 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	namespace StreamGeometryDetail
+	{
+		// RTP fixed header (RFC 3550)
+		constexpr uint32_t RTP_HEADER_OCTETS = 12;
+
+		// 2110-20 payload header: extended sequence number, then one sample
+		// row data (SRD) header per line segment (2110-20:2022 6.2)
+		constexpr uint32_t EXTENDED_SEQUENCE_OCTETS = 2;
+		constexpr uint32_t SRD_HEADER_OCTETS = 6;
+
+		// UDP + IPv4 headers without options
+		constexpr uint32_t UDP_IPV4_OCTETS = 8 + 20;
+
+		// Ethernet header, FCS, preamble/SFD and inter-frame gap
+		constexpr uint32_t ETHERNET_OCTETS = 14 + 4 + 8 + 12;
+
+		// BPM packets carry seven 180 octet blocks of video data, except the
+		// last of a field or frame (2110-20:2022 6.3.3)
+		constexpr uint32_t BPM_BLOCK_OCTETS = 180;
+		constexpr uint32_t BPM_PAYLOAD_OCTETS = 7 * BPM_BLOCK_OCTETS;
+	}
+
+
+	/// <summary>
+	/// VideoStreamGeometry: Sizes and rates of a 2110-20 stream, used to size
+	///						 receive buffers and sockets. Derived from the 
+	///						 VideoFormat of a video description.
+	/// <para>
+	///	GPM (2110-20:2022 6.3.2) is laid out the way senders commonly do: 
+	///	packets hold as many whole pgroups of one line as fit in MAXUDP. BPM
+	///	(6.3.3) packets hold 1260 octets of video data and continue across 
+	///	lines. Interlaced streams are packed per field. </para>
+	/// </summary>
+	struct VideoStreamGeometry
+	{
+	public:
+		// pgroup (2110-20:2022 Table 1 through 3)
+		uint32_t pgroup_octets = 0;
+		uint32_t pgroup_pixels = 0;
+
+		// Payload octets of video data
+		uint32_t line_octets = 0;	// per pgroup row (two lines for 4:2:0)
+		uint32_t field_octets = 0;	// per field, equal to frame_octets if progressive
+		uint32_t frame_octets = 0;
+
+		// Video data octets in a full packet
+		uint32_t packet_data_octets = 0;
+
+		// Largest RTP packet (UDP payload) and most SRD headers in one 
+		// packet
+		uint32_t max_packet_octets = 0;
+		uint32_t max_srds_per_packet = 0;
+
+		// Most packets carrying data of one pgroup row
+		uint32_t packets_per_line = 0;
+		uint32_t packets_per_field = 0;
+		uint32_t packets_per_frame = 0;
+
+		// Rates per second
+		double frame_rate = 0;
+		double packet_rate = 0;
+		double payload_bitrate = 0;		// video data only
+		double ip_bitrate = 0;			// RTP, UDP and IPv4 headers included
+		double ethernet_bitrate = 0;	// Ethernet framing, preamble and gap included
+
+		VideoStreamGeometry() = default;
+
+		explicit VideoStreamGeometry(const SDP::VideoDescription& video_description)
+			: VideoStreamGeometry(VideoFormat(video_description))
+		{
+		}
+
+		explicit VideoStreamGeometry(const VideoFormat& format)
+		{
+			using namespace StreamGeometryDetail;
+
+			if (!format.framerate.IsValid() || format.pgroup_octets == 0)
+				throw std::runtime_error("VideoStreamGeometry: Video format has no frame rate or pgroup");
+
+			uint32_t fields = format.IsInterlaced() ? 2 : 1;
+			uint32_t rows_per_field = format.rows_per_frame / fields;
+
+			pgroup_octets = format.pgroup_octets;
+			pgroup_pixels = format.pgroup_pixels;
+			line_octets = format.line_octets;
+			field_octets = line_octets * rows_per_field;
+			frame_octets = field_octets * fields;
+
+			uint32_t header_octets = RTP_HEADER_OCTETS + EXTENDED_SEQUENCE_OCTETS;
+			uint64_t field_srds = 0;
+
+			if (format.GetPackingMode() == SDPPackingMode::BPM)
+			{
+				// Blocks hold whole pgroups
+				if (BPM_BLOCK_OCTETS % pgroup_octets != 0)
+					throw std::runtime_error("VideoStreamGeometry: BPM needs a pgroup that divides 180 octets");
+
+				packet_data_octets = BPM_PAYLOAD_OCTETS;
+				packets_per_field = (field_octets + packet_data_octets - 1) / packet_data_octets;
+
+				// One SRD per row a packet touches
+				for (uint32_t packet = 0; packet < packets_per_field; packet++)
+				{
+					uint32_t first_row = packet * packet_data_octets / line_octets;
+					uint32_t last_row = (std::min(field_octets, (packet + 1) * packet_data_octets) - 1) / line_octets;
+					max_srds_per_packet = std::max(max_srds_per_packet, last_row - first_row + 1);
+					field_srds += last_row - first_row + 1;
+				}
+
+				for (uint32_t row = 0; row < rows_per_field; row++)
+				{
+					uint32_t first_packet = row * line_octets / packet_data_octets;
+					uint32_t last_packet = ((row + 1) * line_octets - 1) / packet_data_octets;
+					packets_per_line = std::max(packets_per_line, last_packet - first_packet + 1);
+				}
+
+				max_packet_octets = header_octets + SRD_HEADER_OCTETS * max_srds_per_packet + packet_data_octets;
+			}
+			else
+			{
+				// Whole pgroups of one line per packet
+				uint32_t overhead = header_octets + SRD_HEADER_OCTETS;
+				if (format.max_udp <= overhead + pgroup_octets)
+					throw std::runtime_error("VideoStreamGeometry: MAXUDP is too small for one pgroup");
+
+				packet_data_octets = (format.max_udp - overhead) / pgroup_octets * pgroup_octets;
+				packet_data_octets = std::min(packet_data_octets, line_octets);
+
+				packets_per_line = (line_octets + packet_data_octets - 1) / packet_data_octets;
+				packets_per_field = packets_per_line * rows_per_field;
+				max_srds_per_packet = 1;
+				field_srds = packets_per_field;
+
+				max_packet_octets = overhead + packet_data_octets;
+			}
+
+			if (max_packet_octets > format.max_udp)
+				throw std::runtime_error("VideoStreamGeometry: Packets exceed the MAXUDP of the video format");
+
+			packets_per_frame = packets_per_field * fields;
+
+			// Octets on the wire for one field, per layer
+			uint64_t rtp_octets = (uint64_t)field_octets + (uint64_t)header_octets * packets_per_field + SRD_HEADER_OCTETS * field_srds;
+			uint64_t ip_octets = rtp_octets + (uint64_t)UDP_IPV4_OCTETS * packets_per_field;
+			uint64_t ethernet_octets = ip_octets + (uint64_t)ETHERNET_OCTETS * packets_per_field;
+
+			frame_rate = format.framerate.ToDouble();
+			packet_rate = packets_per_frame * frame_rate;
+			payload_bitrate = frame_octets * 8.0 * frame_rate;
+			ip_bitrate = ip_octets * fields * 8.0 * frame_rate;
+			ethernet_bitrate = ethernet_octets * fields * 8.0 * frame_rate;
+		}
+	};
+
+
+	/// <summary>
+	/// AudioStreamGeometry: Sizes and rates of a 2110-30/-31 stream, derived
+	///						 from the rtpmap encoding, sample rate, channel
+	///						 count, and ptime of an audio description.
+	/// </summary>
+	struct AudioStreamGeometry
+	{
+	public:
+		uint32_t bytes_per_sample = 0;	// per channel: L16 = 2, L24 = 3, AM824 = 4
+		uint32_t channels = 0;
+		uint32_t sample_rate = 0;
+
+		double packet_time_ms = 0;
+		uint32_t samples_per_packet = 0;
+
+		// Audio data octets per packet and RTP packet size (UDP payload)
+		uint32_t packet_data_octets = 0;
+		uint32_t packet_octets = 0;
+
+		// Rates per second
+		double packet_rate = 0;
+		double payload_bitrate = 0;
+		double ip_bitrate = 0;
+		double ethernet_bitrate = 0;
+
+		AudioStreamGeometry() = default;
+
+		/// <summary>
+		/// AudioStreamGeometry: ptime defaults to 1 ms (2110-30:2017 6.2.1)
+		///						 when the description has none.
+		/// </summary>
+		explicit AudioStreamGeometry(const SDP::AudioDescription& audio_description)
+		{
+			using namespace StreamGeometryDetail;
+
+			if (audio_description.attributes.rtp_map.empty())
+				throw std::runtime_error("AudioStreamGeometry: Audio description has no rtpmap");
+
+			const SDP::Attributes::RTP& rtp = audio_description.attributes.rtp_map[0];
+			if (rtp.codec == "L16")
+				bytes_per_sample = 2;
+			else if (rtp.codec == "L24")
+				bytes_per_sample = 3;
+			else if (rtp.codec == "AM824")
+				bytes_per_sample = 4;
+			else
+				throw std::runtime_error("AudioStreamGeometry: Audio encoding \"" + std::string(rtp.codec) + "\" is not a 2110-30/-31 encoding");
+
+			// Channels from the rtpmap encoding parameters, else channel-order
+			std::string_view encoding = rtp.encoding;
+			if (std::from_chars(encoding.data(), encoding.data() + encoding.size(), channels).ec != std::errc())
+				channels = (uint32_t)audio_description.channel_count;
+			if (channels == 0)
+				channels = 1;
+
+			if (rtp.rate <= 0)
+				throw std::runtime_error("AudioStreamGeometry: Audio description has no sample rate");
+
+			sample_rate = (uint32_t)rtp.rate;
+			packet_time_ms = audio_description.attributes.ptime > 0 ? audio_description.attributes.ptime : 1.0;
+			samples_per_packet = (uint32_t)std::lround(sample_rate * packet_time_ms / 1000.0);
+			if (samples_per_packet == 0)
+				throw std::runtime_error("AudioStreamGeometry: ptime is shorter than one sample");
+
+			packet_data_octets = samples_per_packet * channels * bytes_per_sample;
+			packet_octets = RTP_HEADER_OCTETS + packet_data_octets;
+
+			packet_rate = (double)sample_rate / samples_per_packet;
+			payload_bitrate = packet_data_octets * 8.0 * packet_rate;
+			ip_bitrate = (packet_octets + UDP_IPV4_OCTETS) * 8.0 * packet_rate;
+			ethernet_bitrate = (packet_octets + UDP_IPV4_OCTETS + ETHERNET_OCTETS) * 8.0 * packet_rate;
+		}
+	};
+}
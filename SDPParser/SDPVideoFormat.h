@@ -0,0 +1,225 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	// Chroma structure of an SDPSampling
+	enum class SDPChroma : uint8_t
+	{
+		C444,	// 4:4:4 (RGB, XYZ and 4:4:4 colour difference)
+		C422,
+		C420,
+		KEY		// Single component key (alpha) signal
+	};
+
+	constexpr SDPChroma SDPSamplingChroma(SDPSampling sampling)
+	{
+		switch (sampling)
+		{
+		case SDPSampling::YCBCR_422:
+		case SDPSampling::CLYCBCR_422:
+		case SDPSampling::ICTCP_422:
+			return SDPChroma::C422;
+		case SDPSampling::YCBCR_420:
+		case SDPSampling::CLYCBCR_420:
+		case SDPSampling::ICTCP_420:
+			return SDPChroma::C420;
+		case SDPSampling::KEY:
+			return SDPChroma::KEY;
+		default:
+			return SDPChroma::C444;
+		}
+	}
+
+
+	/// <summary>
+	/// SDPPgroup: Pixel group of a sampling and depth (2110-20:2022 Table 1
+	///			   through 3). A pgroup is the smallest number of pixels
+	///			   that fill a whole number of octets. For 4:2:0 it spans
+	///			   two lines.
+	/// </summary>
+	struct SDPPgroup
+	{
+		uint8_t octets = 0;
+		uint8_t pixels = 0;
+		uint8_t width = 0;	// pixels along one line
+		uint8_t lines = 0;	// lines covered (2 for 4:2:0)
+
+		constexpr bool IsValid() const { return octets != 0; }
+	};
+
+	constexpr SDPPgroup SDPPgroupSize(SDPSampling sampling, SDPDepth depth)
+	{
+		switch (SDPSamplingChroma(sampling))
+		{
+		case SDPChroma::C444:
+			switch (SDPDepthBits(depth))
+			{
+			case 8: return { 3, 1, 1, 1 };
+			case 10: return { 15, 4, 4, 1 };
+			case 12: return { 9, 2, 2, 1 };
+			case 16: return { 6, 1, 1, 1 };
+			}
+			break;
+		case SDPChroma::C422:
+			switch (SDPDepthBits(depth))
+			{
+			case 8: return { 4, 2, 2, 1 };
+			case 10: return { 5, 2, 2, 1 };
+			case 12: return { 6, 2, 2, 1 };
+			case 16: return { 8, 2, 2, 1 };
+			}
+			break;
+		case SDPChroma::C420:
+			switch (SDPDepthBits(depth))
+			{
+			case 8: return { 6, 4, 2, 2 };
+			case 10: return { 15, 8, 4, 2 };
+			case 12: return { 9, 4, 2, 2 };
+			case 16: return { 12, 4, 2, 2 };
+			}
+			break;
+		case SDPChroma::KEY:
+			break;
+		}
+
+		return {};
+	}
+
+
+	/// <summary>
+	/// VideoFormat: Compact, trivially copyable copy of the per-packet
+	///				 relevant parts of an uncompressed VideoDescription,
+	///				 plus derived pgroup and line sizes. Build it once when a
+	///				 receiver or sender is activated; it fits one cache line.
+	///				 VideoDescription stays the control-plane model.
+	/// </summary>
+	struct alignas(64) VideoFormat
+	{
+	public:
+		static constexpr uint8_t INTERLACED = 0x1;
+		static constexpr uint8_t SEGMENTED = 0x2;
+
+		// Active picture size in pixels
+		uint32_t width = 0;
+		uint32_t height = 0;
+
+		// Lines per field (interlaced) or per frame (progressive/PsF)
+		uint32_t field_height = 0;
+
+		// Payload layout. A pgroup row is one line, or two for 4:2:0.
+		uint32_t pgroups_per_line = 0;
+		uint32_t line_octets = 0;		// octets of one pgroup row
+		uint32_t rows_per_frame = 0;	// pgroup rows per frame
+		uint32_t frame_octets = 0;		// payload octets per frame
+
+		Rational framerate;
+
+		// Largest RTP payload, from MAXUDP
+		uint16_t max_udp = 1460;
+
+		uint8_t pgroup_octets = 0;
+		uint8_t pgroup_pixels = 0;
+		uint8_t pgroup_width = 0;
+		uint8_t pgroup_lines = 0;
+		uint8_t depth_bits = 0;
+
+		uint8_t sampling = 0;
+		uint8_t depth = 0;
+		uint8_t packing_mode = 0;
+		uint8_t colorimetry = 0;
+		uint8_t tcs = 0;
+		uint8_t range = 0;
+		uint8_t flags = 0;
+
+		VideoFormat() = default;
+
+		/// <summary>
+		/// VideoFormat: Derives the format of an uncompressed video
+		///				 description. Throws for compressed video and for
+		///				 sampling/depth combinations without a pgroup.
+		/// </summary>
+		explicit VideoFormat(const SDP::VideoDescription& video_description)
+		{
+			if (video_description.standard != SDPStandard::UNCOMPRESSED)
+				throw std::runtime_error("VideoFormat: Only uncompressed (ST 2110-20) video has a pgroup format");
+
+			SDPPgroup pgroup = SDPPgroupSize(video_description.sampling, video_description.depth);
+			if (!pgroup.IsValid())
+				throw std::runtime_error("VideoFormat: Sampling and depth of the video description have no ST 2110-20 pgroup");
+
+			if (video_description.width <= 0 || video_description.height <= 0 || video_description.height % pgroup.lines != 0)
+				throw std::runtime_error("VideoFormat: Video description has an invalid picture size");
+
+			if (video_description.max_udp <= 0 || video_description.max_udp > UINT16_MAX)
+				throw std::runtime_error("VideoFormat: Video description has an invalid MAXUDP");
+
+			width = (uint32_t)video_description.width;
+			height = (uint32_t)video_description.height;
+			field_height = video_description.interlaced ? height / 2 : height;
+
+			pgroups_per_line = (width + pgroup.width - 1) / pgroup.width;
+			line_octets = pgroups_per_line * pgroup.octets;
+			rows_per_frame = height / pgroup.lines;
+			frame_octets = line_octets * rows_per_frame;
+
+			framerate = video_description.framerate;
+			max_udp = (uint16_t)video_description.max_udp;
+
+			pgroup_octets = pgroup.octets;
+			pgroup_pixels = pgroup.pixels;
+			pgroup_width = pgroup.width;
+			pgroup_lines = pgroup.lines;
+			depth_bits = (uint8_t)SDPDepthBits(video_description.depth);
+
+			sampling = (uint8_t)video_description.sampling;
+			depth = (uint8_t)video_description.depth;
+			packing_mode = (uint8_t)video_description.packing_mode;
+			colorimetry = (uint8_t)video_description.colorimetry;
+			tcs = (uint8_t)video_description.tcs;
+			range = (uint8_t)video_description.range;
+			flags = (video_description.interlaced ? INTERLACED : 0) | (video_description.segmented ? SEGMENTED : 0);
+		}
+
+		SDPSampling GetSampling() const { return (SDPSampling)sampling; }
+		SDPChroma GetChroma() const { return SDPSamplingChroma((SDPSampling)sampling); }
+		SDPDepth GetDepth() const { return (SDPDepth)depth; }
+		SDPPackingMode GetPackingMode() const { return (SDPPackingMode)packing_mode; }
+		SDPColorimetry GetColorimetry() const { return (SDPColorimetry)colorimetry; }
+		SDPTransferCharacteristicSystem GetTCS() const { return (SDPTransferCharacteristicSystem)tcs; }
+		SDPRange GetRange() const { return (SDPRange)range; }
+
+		bool IsInterlaced() const { return (flags & INTERLACED) != 0; }
+		bool IsSegmented() const { return (flags & SEGMENTED) != 0; }
+
+		// Octet offset of a pixel within its pgroup row. Pixel must start a
+		// pgroup.
+		uint32_t GetPixelOffset(uint32_t x) const { return x / pgroup_width * pgroup_octets; }
+	};
+
+	static_assert(sizeof(VideoFormat) == 64, "VideoFormat must fit one cache line");
+	static_assert(std::is_trivially_copyable_v<VideoFormat>, "VideoFormat must be trivially copyable");
+}
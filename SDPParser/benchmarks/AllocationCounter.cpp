@@ -0,0 +1,104 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.h"
+
+// The replacements live in their own translation unit so the compiler
+// never sees a new-expression and this free() together, and never inlines
+// them into the code they count.
+
+std::atomic<uint64_t> g_allocation_count = 0;
+std::atomic<uint64_t> g_allocated_bytes = 0;
+
+namespace
+{
+	void* Allocate(std::size_t size)
+	{
+		g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+		g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+		return std::malloc(size == 0 ? 1 : size);
+	}
+
+	void* AllocateAligned(std::size_t size, std::align_val_t alignment)
+	{
+		g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+		g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+		// aligned_alloc() wants a multiple of the alignment
+		std::size_t align = (std::size_t)alignment;
+		std::size_t octets = ((size == 0 ? 1 : size) + align - 1) / align * align;
+#ifdef _MSC_VER
+		return _aligned_malloc(octets, align);
+#else
+		return std::aligned_alloc(align, octets);
+#endif
+	}
+
+	void FreeAligned(void* ptr)
+	{
+#ifdef _MSC_VER
+		_aligned_free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
+
+	void* Checked(void* ptr)
+	{
+		if (ptr == nullptr)
+			throw std::bad_alloc();
+
+		return ptr;
+	}
+}
+
+// Every form is replaced, the library's defaults need not forward to the
+// plain one (sanitizers, for one, replace them all)
+void* operator new(std::size_t size) { return Checked(Allocate(size)); }
+void* operator new[](std::size_t size) { return Checked(Allocate(size)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return Checked(AllocateAligned(size, alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return Checked(AllocateAligned(size, alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(ptr); }
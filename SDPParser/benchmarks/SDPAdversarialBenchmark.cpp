@@ -0,0 +1,216 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "sdp_adapter.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+
+namespace
+{
+	const char* SDP_HEAD =
+		"v=0\r\n"
+		"o=- 1443716955 1443716955 IN IP4 192.168.1.230\r\n"
+		"s=adversarial\r\n"
+		"t=0 0\r\n"
+		"m=video 20000 RTP/AVP 96\r\n"
+		"c=IN IP4 239.100.9.10/32\r\n"
+		"a=rtpmap:96 raw/90000\r\n";
+
+	// Lines of about the given length that make the regex rules work hard:
+	// a prefix, a unit repeated, and a tail that keeps the rule from
+	// matching where one is given
+	struct Family
+	{
+		const char* name;
+		const char* prefix;
+		const char* unit;
+		const char* tail;
+	};
+
+	const Family FAMILIES[] =
+	{
+		{ "unknown attribute", "a=x-vendor:", "a", "" },
+		{ "imageattr sets", "a=imageattr:97 send", " [x=1920,y=1080]", " recv !" },
+		{ "imageattr unclosed", "a=imageattr:97 send [", "x=1,", "" },
+		{ "candidate", "a=candidate:", "1 ", "" },
+		{ "simulcast", "a=simulcast:send ", "recv", "!" },
+		{ "x-google-flag", "a=", "y", "x-google-flag:z" },
+		{ "fmtp", "a=fmtp:96 ", "a=1;", "" },
+		{ "source-filter", "a=source-filter: incl IN IP4 239.100.9.10", " 10.0.0.1", "" },
+		{ "ssrc", "a=ssrc:1 cname:", "c", "" },
+	};
+
+	// Line lengths: typical, the default bounded limit, and past it
+	const size_t LINE_OCTETS[] = { 256, 2048, 8192 };
+
+	// Octets of adversarial lines per SDP
+	constexpr size_t SDP_OCTETS = 256 * 1024;
+
+	std::string MakeLine(const Family& family, size_t octets)
+	{
+		std::string line = family.prefix;
+		while (line.size() + std::strlen(family.unit) + std::strlen(family.tail) + 2 <= octets)
+			line += family.unit;
+		return line + family.tail + "\r\n";
+	}
+
+	std::string MakeSDP(const Family& family, size_t line_octets, size_t sdp_octets)
+	{
+		std::string line = MakeLine(family, line_octets);
+		std::string sdp = SDP_HEAD;
+		for (size_t octets = 0; octets < sdp_octets; octets += line.size())
+			sdp += line;
+		return sdp;
+	}
+
+	// Seconds per call, in doubling batches until one takes min_seconds.
+	// A call that throws is timed the same; the message is kept.
+	template<typename Function>
+	double Measure(double min_seconds, std::string* error, Function function)
+	{
+		auto run = [&]()
+		{
+			try
+			{
+				function();
+			}
+			catch (const std::exception& e)
+			{
+				*error = e.what();
+			}
+		};
+
+		run();
+
+		for (uint64_t iterations = 1;; iterations *= 2)
+		{
+			auto start = std::chrono::steady_clock::now();
+			for (uint64_t i = 0; i < iterations; i++)
+				run();
+
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (seconds >= min_seconds)
+				return seconds / iterations;
+		}
+	}
+}
+
+
+/// <summary>
+/// SDPAdversarialBenchmark: Times sdptransform::parse() and the bounded
+///							 parse with default ParseLimits on SDPs made
+///							 of hostile lines: attributes no rule
+///							 matches, long imageattr, candidate,
+///							 simulcast, fmtp, source-filter and ssrc
+///							 lines, and an x-google-flag deep in a line,
+///							 each at a typical length, at the default
+///							 line limit and past it. Reports the rate of
+///							 each, then the bounded parse's time per
+///							 octet as the SDP grows to the size limit,
+///							 which stays flat. Fails if the bounded
+///							 parse differs from parse() on an SDP within
+///							 its limits. Lines stay short enough for
+///							 parse() not to overflow an 8 MiB stack;
+///							 past about 25,000 octets it does.
+/// </summary>
+int main(int argc, char** argv)
+{
+	double min_seconds = argc > 1 ? std::atof(argv[1]) : 0.2;
+	if (argc > 2 || min_seconds <= 0)
+	{
+		std::cerr << "usage: " << argv[0] << " [min_seconds]" << std::endl;
+		return 2;
+	}
+
+	sdptransform::ParseLimits limits;
+	bool matched = true;
+
+	for (const Family& family : FAMILIES)
+	{
+		for (size_t line_octets : LINE_OCTETS)
+		{
+			std::string sdp = MakeSDP(family, line_octets, SDP_OCTETS);
+
+			std::string error;
+			double seconds = Measure(min_seconds, &error, [&]()
+			{
+				json session = sdptransform::parse(sdp);
+			});
+
+			std::string bounded_error;
+			double bounded_seconds = Measure(min_seconds, &bounded_error, [&]()
+			{
+				json session = sdptransform::parse(sdp, limits);
+			});
+
+			// Over-long lines are dropped, or reject the SDP when their loss
+			// changes its meaning, so only SDPs within the limits read the same
+			std::string outcome = "parsed";
+			if (!bounded_error.empty())
+			{
+				outcome = "rejected";
+			}
+			else if (line_octets > limits.maxLineOctets)
+			{
+				outcome = "lines skipped";
+			}
+			else if (sdptransform::parse(sdp, limits) != sdptransform::parse(sdp))
+			{
+				outcome = "DIFFERS";
+				matched = false;
+			}
+
+			std::cout << std::left << std::setw(20) << family.name << std::right << std::setw(6) << line_octets << " octet lines"
+				<< std::fixed << std::setprecision(1)
+				<< std::setw(10) << sdp.size() / seconds / 1e6 << " MB/s parse"
+				<< std::setw(10) << sdp.size() / bounded_seconds / 1e6 << " MB/s bounded"
+				<< std::setw(8) << seconds / bounded_seconds << "x"
+				<< "  " << outcome << std::endl;
+		}
+	}
+
+	// Worst case of the bounded parse: every line at the line limit and
+	// matching no rule, up to the SDP size limit
+	std::cout << std::endl;
+	for (size_t sdp_octets = 64 * 1024; sdp_octets <= limits.maxOctets; sdp_octets *= 2)
+	{
+		std::string sdp = MakeSDP(FAMILIES[0], limits.maxLineOctets, sdp_octets - limits.maxLineOctets);
+
+		std::string error;
+		json session;
+		double seconds = Measure(min_seconds, &error, [&]()
+		{
+			session = sdptransform::parse(sdp, limits);
+		});
+
+		std::cout << std::left << std::setw(20) << FAMILIES[0].name << std::right << std::setw(8) << sdp.size() << " octet SDP"
+			<< std::fixed << std::setprecision(2) << std::setw(10) << seconds * 1e9 / sdp.size() << " ns/octet bounded"
+			<< std::setprecision(1) << std::setw(10) << seconds * 1e3 << " ms"
+			<< "  " << (error.empty() ? std::to_string(session["media"][0]["invalid"].size()) + " lines read" : "rejected: " + error) << std::endl;
+	}
+
+	return matched ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "sdp_adapter.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <sstream>
+
+#include "AllocationCounter.h"
+
+#ifndef SDP_ADAPTER_CORPUS_DIR
+#define SDP_ADAPTER_CORPUS_DIR "corpus"
+#endif
+
+namespace
+{
+	struct Measurement
+	{
+		double ns_per_op = 0;
+		double allocations_per_op = 0;
+		double bytes_per_op = 0;
+
+		// What the operation threw, if it did; the throwing path is what
+		// gets timed then
+		std::string error;
+	};
+
+	// Runs the operation in doubling batches until one batch takes at least
+	// min_seconds, and reports that batch
+	template<typename Function>
+	Measurement Measure(double min_seconds, Function function)
+	{
+		Measurement measurement;
+		auto run = [&]()
+		{
+			try
+			{
+				function();
+			}
+			catch (const std::exception& e)
+			{
+				if (measurement.error.empty())
+					measurement.error = e.what();
+			}
+		};
+
+		// Warm up
+		run();
+
+		for (uint64_t iterations = 1;; iterations *= 2)
+		{
+			uint64_t allocation_count = g_allocation_count.load();
+			uint64_t allocated_bytes = g_allocated_bytes.load();
+			auto start = std::chrono::steady_clock::now();
+
+			for (uint64_t i = 0; i < iterations; i++)
+				run();
+
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (seconds >= min_seconds)
+			{
+				measurement.ns_per_op = seconds * 1e9 / iterations;
+				measurement.allocations_per_op = (double)(g_allocation_count.load() - allocation_count) / iterations;
+				measurement.bytes_per_op = (double)(g_allocated_bytes.load() - allocated_bytes) / iterations;
+				return measurement;
+			}
+		}
+	}
+
+	void Print(const std::string& file, const char* operation, size_t sdp_octets, const Measurement& measurement)
+	{
+		std::cout << std::left << std::setw(36) << file << std::setw(18) << operation << std::right << std::fixed << std::setprecision(0)
+			<< std::setw(12) << measurement.ns_per_op << " ns"
+			<< std::setprecision(1) << std::setw(10) << sdp_octets * 1e3 / measurement.ns_per_op << " MB/s"
+			<< std::setw(10) << measurement.allocations_per_op << " allocs"
+			<< std::setprecision(0) << std::setw(10) << measurement.bytes_per_op << " bytes";
+
+		if (!measurement.error.empty())
+			std::cout << "  (throws: " << measurement.error << ")";
+		std::cout << std::endl;
+	}
+}
+
+
+/// <summary>
+/// SDPCorpusBenchmark: Reports time, throughput, heap allocations and
+///						bytes allocated per operation for every SDP of a
+///						corpus directory (the checked-in one by default):
+///						sdptransform::parse() and its bounded form,
+///						sdptransform::write() of the parsed session,
+///						parseParams() of all its fmtp configs, and
+///						Cf::SDPParser both new per SDP and reused. The
+///						baseline any parser change is judged against.
+/// </summary>
+int main(int argc, char** argv)
+{
+	std::filesystem::path corpus = argc > 1 ? argv[1] : SDP_ADAPTER_CORPUS_DIR;
+	double min_seconds = argc > 2 ? std::atof(argv[2]) : 0.2;
+	if (!std::filesystem::is_directory(corpus) || min_seconds <= 0)
+	{
+		std::cerr << "usage: " << argv[0] << " [corpus_directory [min_seconds]]" << std::endl;
+		return 2;
+	}
+
+	std::vector<std::filesystem::path> files;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(corpus))
+	{
+		if (entry.is_regular_file() && entry.path().extension() == ".sdp")
+			files.push_back(entry.path());
+	}
+	std::sort(files.begin(), files.end());
+
+	Cf::SDPParser reused_parser;
+	for (const std::filesystem::path& path : files)
+	{
+		std::ifstream file(path, std::ios::binary);
+		std::stringstream stream;
+		stream << file.rdbuf();
+		std::string sdp = stream.str();
+		std::string name = path.filename().string();
+
+		Print(name, "parse", sdp.size(), Measure(min_seconds, [&]()
+		{
+			json session = sdptransform::parse(sdp);
+		}));
+
+		Print(name, "parse bounded", sdp.size(), Measure(min_seconds, [&]()
+		{
+			json session = sdptransform::parse(sdp, sdptransform::ParseLimits());
+		}));
+
+		json session = sdptransform::parse(sdp);
+		Print(name, "write", sdp.size(), Measure(min_seconds, [&]()
+		{
+			std::string written = sdptransform::write(session);
+		}));
+
+		std::vector<std::string> configs;
+		for (const json& media : session.value("media", json::array()))
+		{
+			for (const json& fmtp : media.value("fmtp", json::array()))
+				configs.push_back(fmtp.value("config", ""));
+		}
+		if (!configs.empty())
+		{
+			size_t config_octets = 0;
+			for (const std::string& config : configs)
+				config_octets += config.size();
+
+			Print(name, "parseParams", config_octets, Measure(min_seconds, [&]()
+			{
+				for (const std::string& config : configs)
+					json params = sdptransform::parseParams(config);
+			}));
+		}
+
+		Print(name, "SDPParser", sdp.size(), Measure(min_seconds, [&]()
+		{
+			Cf::SDPParser sdp_parser(sdp);
+		}));
+
+		Print(name, "SDPParser reused", sdp.size(), Measure(min_seconds, [&]()
+		{
+			reused_parser.Parse(sdp);
+		}));
+	}
+
+	return 0;
+}
@@ -0,0 +1,602 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "sdp_adapter.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+
+namespace
+{
+	/// <summary>
+	/// Random: Seeded source of the generator's choices. Bounded values
+	///			come from the mt19937_64 output directly, which the
+	///			standard fixes, so a seed gives the same SDPs with every
+	///			standard library.
+	/// </summary>
+	class Random
+	{
+	public:
+		explicit Random(uint64_t seed) : m_engine(seed) {}
+
+		// Uniform enough in [0, n) for n far below 2^64
+		uint64_t Below(uint64_t n) { return m_engine() % n; }
+		bool Chance(uint32_t percent) { return Below(100) < percent; }
+
+		template<typename T, size_t N>
+		const T& Pick(const T (&values)[N]) { return values[Below(N)]; }
+
+		std::string Token(size_t octets)
+		{
+			static const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+			std::string token(octets, 'x');
+			for (char& c : token)
+				c = ALPHABET[Below(sizeof(ALPHABET) - 1)];
+			return token;
+		}
+
+		std::string Ip4(uint32_t first_octet)
+		{
+			return std::to_string(first_octet) + "." + std::to_string(Below(256)) + "." + std::to_string(Below(256)) + "." + std::to_string(1 + Below(254));
+		}
+
+		std::string Hex(size_t octets, char separator)
+		{
+			static const char DIGITS[] = "0123456789ABCDEF";
+			std::string hex;
+			for (size_t i = 0; i < octets; i++)
+			{
+				if (i != 0)
+					hex += separator;
+				uint64_t octet = Below(256);
+				hex += DIGITS[octet >> 4];
+				hex += DIGITS[octet & 15];
+			}
+			return hex;
+		}
+
+	private:
+		std::mt19937_64 m_engine;
+	};
+
+
+	struct Shape
+	{
+		uint64_t seed = 1;
+		uint32_t media = 4;
+		uint32_t attributes = 8;			// extra "a=" lines per section
+		uint32_t fmtp_params = 10;
+		uint32_t candidates = 4;
+		uint32_t sources = 1;				// source-filter source addresses
+		uint32_t pathological = 0;			// per section
+		uint32_t pathological_octets = 4096;
+	};
+
+	// A null value leaves an optional field out, so both forms of a rule's
+	// formatFunc are written
+	using FieldGenerator = std::function<json(Random&)>;
+
+	// Values by "<rule>.<field>", or by "<rule>" for a rule with a single
+	// unnamed value. <rule> is the rule's name, its push, or "media" for
+	// the "m=" rule. Every value matches the rule's regex and reads back
+	// as written.
+	const std::map<std::string, FieldGenerator>& GetFieldGenerators()
+	{
+		static const char* DIRECTIONS[] = { "sendrecv", "recvonly", "sendonly", "inactive" };
+		static const std::map<std::string, FieldGenerator> GENERATORS =
+		{
+			{ "version", [](Random&) { return json(0); } },
+			{ "origin.username", [](Random&) { return json("-"); } },
+			{ "origin.sessionId", [](Random& r) { return json(r.Below(1ull << 62)); } },
+			{ "origin.sessionVersion", [](Random& r) { return json(r.Below(1000)); } },
+			{ "origin.netType", [](Random&) { return json("IN"); } },
+			{ "origin.ipVer", [](Random&) { return json(4); } },
+			{ "origin.address", [](Random& r) { return json(r.Ip4(192)); } },
+			{ "name", [](Random& r) { return json("synthetic " + r.Token(8)); } },
+			{ "description", [](Random& r) { return json("generated section " + r.Token(12)); } },
+			{ "uri", [](Random& r) { return json("https://example.com/" + r.Token(10)); } },
+			{ "email", [](Random& r) { return json(r.Token(6) + "@example.com"); } },
+			{ "phone", [](Random& r) { return json("+1 555 0" + std::to_string(100 + r.Below(100))); } },
+			{ "timezones", [](Random&) { return json("2882844526 -1h 2898848070 0"); } },
+			{ "repeats", [](Random&) { return json("604800 3600 0 90000"); } },
+			{ "timing.start", [](Random&) { return json(0); } },
+			{ "timing.stop", [](Random&) { return json(0); } },
+			{ "connection.version", [](Random&) { return json(4); } },
+			{ "connection.ip", [](Random& r) { return json(r.Ip4(239)); } },
+			{ "connection.ttl", [](Random& r) { return r.Chance(70) ? json(r.Pick({ 32, 64, 127 })) : json(); } },
+			{ "bandwidth.type", [](Random& r) { return json(r.Pick({ "AS", "TIAS", "CT" })); } },
+			{ "bandwidth.limit", [](Random& r) { return json(1 + r.Below(1000000)); } },
+			{ "media.type", [](Random& r) { return json(r.Pick({ "video", "audio" })); } },
+			{ "media.port", [](Random& r) { return json(1024 + 2 * r.Below(30000)); } },
+			{ "media.numPorts", [](Random& r) { return r.Chance(10) ? json(2) : json(); } },
+			{ "media.protocol", [](Random& r) { return json(r.Pick({ "RTP/AVP", "UDP/TLS/RTP/SAVPF" })); } },
+			{ "rtp.codec", [](Random& r) { return json(r.Pick({ "raw", "jxsv", "smpte291", "L24", "L16", "opus", "VP8", "H264", "rtx" })); } },
+			{ "rtp.rate", [](Random& r) { return json(r.Pick({ 90000, 48000, 96000 })); } },
+			{ "rtp.encoding", [](Random& r) { return r.Chance(30) ? json(std::to_string(1 + r.Below(16))) : json(); } },
+			{ "control", [](Random& r) { return json("streamid=" + std::to_string(r.Below(16))); } },
+			{ "rtcp.port", [](Random& r) { return json(1025 + 2 * r.Below(30000)); } },
+			{ "rtcp.netType", [](Random&) { return json("IN"); } },
+			{ "rtcp.ipVer", [](Random&) { return json(4); } },
+			{ "rtcp.address", [](Random& r) { return json(r.Ip4(10)); } },
+			{ "rtcpFbTrrInt.payload", [](Random& r) { return json(std::to_string(96 + r.Below(32))); } },
+			{ "rtcpFbTrrInt.value", [](Random& r) { return json(r.Below(1000)); } },
+			{ "rtcpFb.payload", [](Random& r) { return r.Chance(10) ? json("*") : json(std::to_string(96 + r.Below(32))); } },
+			{ "rtcpFb.type", [](Random& r) { return json(r.Pick({ "nack", "ccm", "goog-remb", "transport-cc" })); } },
+			{ "rtcpFb.subtype", [](Random& r) { return r.Chance(40) ? json(r.Pick({ "pli", "fir", "rpsi" })) : json(); } },
+			{ "ext.value", [](Random& r) { return json(1 + r.Below(14)); } },
+			{ "ext.direction", [&](Random& r) { return r.Chance(20) ? json(r.Pick(DIRECTIONS)) : json(); } },
+			{ "ext.encrypt-uri", [](Random& r) { return r.Chance(10) ? json("urn:ietf:params:rtp-hdrext:encrypt") : json(); } },
+			{ "ext.uri", [](Random& r) { return json(r.Pick({ "urn:ietf:params:rtp-hdrext:ssrc-audio-level", "urn:ietf:params:rtp-hdrext:sdes:mid",
+				"http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time", "urn:ietf:params:rtp-hdrext:smpte-tc" })); } },
+			{ "ext.config", [](Random& r) { return r.Chance(10) ? json("25@600/24") : json(); } },
+			{ "extmapAllowMixed", [](Random&) { return json("extmap-allow-mixed"); } },
+			{ "crypto.id", [](Random& r) { return json(1 + r.Below(9)); } },
+			{ "crypto.suite", [](Random& r) { return json(r.Pick({ "AES_CM_128_HMAC_SHA1_80", "AES_CM_128_HMAC_SHA1_32" })); } },
+			{ "crypto.config", [](Random& r) { return json("inline:" + r.Token(40) + "|2^20|1:32"); } },
+			{ "crypto.sessionConfig", [](Random& r) { return r.Chance(20) ? json("KDR=1") : json(); } },
+			{ "setup", [](Random& r) { return json(r.Pick({ "actpass", "active", "passive" })); } },
+			{ "mid", [](Random& r) { return json(r.Token(4)); } },
+			{ "msid", [](Random& r) { return json(r.Token(16) + " " + r.Token(16)); } },
+			{ "ptime", [](Random& r) { return r.Pick({ json(0.125), json(1), json(20) }); } },
+			{ "maxptime", [](Random& r) { return r.Pick({ json(0.125), json(1), json(60), json(120) }); } },
+			{ "direction", [&](Random& r) { return json(r.Pick(DIRECTIONS)); } },
+			{ "icelite", [](Random&) { return json("ice-lite"); } },
+			{ "iceUfrag", [](Random& r) { return json(r.Token(4)); } },
+			{ "icePwd", [](Random& r) { return json(r.Token(24)); } },
+			{ "fingerprint.type", [](Random&) { return json("sha-256"); } },
+			{ "fingerprint.hash", [](Random& r) { return json(r.Hex(32, ':')); } },
+			{ "candidates.foundation", [](Random& r) { return json(std::to_string(r.Below(4000000000ull))); } },
+			{ "candidates.component", [](Random& r) { return json(1 + r.Below(2)); } },
+			{ "candidates.transport", [](Random& r) { return json(r.Pick({ "udp", "tcp" })); } },
+			{ "candidates.priority", [](Random& r) { return json(r.Below(2130706431)); } },
+			{ "candidates.ip", [](Random& r) { return json(r.Ip4(192)); } },
+			{ "candidates.port", [](Random& r) { return json(1024 + r.Below(60000)); } },
+			{ "candidates.type", [](Random& r) { return json(r.Pick({ "host", "srflx", "relay" })); } },
+			{ "candidates.raddr", [](Random& r) { return json(r.Ip4(10)); } },
+			{ "candidates.rport", [](Random& r) { return json(1024 + r.Below(60000)); } },
+			{ "candidates.tcptype", [](Random& r) { return json(r.Pick({ "active", "passive", "so" })); } },
+			{ "candidates.generation", [](Random&) { return json(0); } },
+			{ "candidates.network-id", [](Random& r) { return json(1 + r.Below(4)); } },
+			{ "candidates.network-cost", [](Random& r) { return r.Chance(50) ? json(r.Pick({ 10, 50 })) : json(); } },
+			{ "endOfCandidates", [](Random&) { return json("end-of-candidates"); } },
+			{ "remoteCandidates", [](Random& r) { return json("1 " + r.Ip4(203) + " 54400 2 " + r.Ip4(203) + " 54401"); } },
+			{ "iceOptions", [](Random& r) { return json(r.Pick({ "trickle", "google-ice", "renomination" })); } },
+			{ "ssrcs.id", [](Random& r) { return json(r.Below(4294967296ull)); } },
+			{ "ssrcs.attribute", [](Random& r) { return json(r.Pick({ "cname", "msid", "label" })); } },
+			{ "ssrcs.value", [](Random& r) { return json(r.Token(16)); } },
+			{ "ssrcGroups.semantics", [](Random& r) { return json(r.Pick({ "FID", "FEC-FR", "SIM" })); } },
+			{ "ssrcGroups.ssrcs", [](Random& r) { return json(std::to_string(r.Below(4294967296ull)) + " " + std::to_string(r.Below(4294967296ull))); } },
+			{ "msidSemantic.semantic", [](Random&) { return json("WMS"); } },
+			{ "msidSemantic.token", [](Random& r) { return json(r.Token(36)); } },
+			{ "groups.type", [](Random& r) { return json(r.Pick({ "BUNDLE", "DUP", "LS" })); } },
+			{ "groups.mids", [](Random& r) { return json(r.Token(4) + " " + r.Token(4)); } },
+			{ "rtcpMux", [](Random&) { return json("rtcp-mux"); } },
+			{ "rtcpRsize", [](Random&) { return json("rtcp-rsize"); } },
+			{ "sctpmap.sctpmapNumber", [](Random&) { return json(5000); } },
+			{ "sctpmap.app", [](Random&) { return json("webrtc-datachannel"); } },
+			{ "sctpmap.maxMessageSize", [](Random& r) { return r.Chance(50) ? json(1024) : json(); } },
+			{ "xGoogleFlag", [](Random&) { return json("conference"); } },
+			{ "rids.id", [](Random& r) { return json(r.Token(2)); } },
+			{ "rids.direction", [](Random& r) { return json(r.Pick({ "send", "recv" })); } },
+			{ "rids.params", [](Random& r) { return r.Chance(70) ? json("max-width=" + std::to_string(320 + r.Below(3520)) + ";max-fps=30") : json(); } },
+			{ "imageattrs.pt", [](Random& r) { return json(std::to_string(96 + r.Below(32))); } },
+			{ "imageattrs.dir1", [](Random&) { return json("send"); } },
+			{ "imageattrs.attrs1", [](Random& r) { return json("[x=" + std::to_string(320 + r.Below(1600)) + ",y=" + std::to_string(240 + r.Below(900)) + "]"); } },
+			{ "imageattrs.dir2", [](Random& r) { return r.Chance(50) ? json("recv") : json(); } },
+			{ "imageattrs.attrs2", [](Random&) { return json("*"); } },
+			{ "simulcast.dir1", [](Random&) { return json("send"); } },
+			{ "simulcast.list1", [](Random&) { return json("1;2;~3"); } },
+			{ "simulcast.dir2", [](Random& r) { return r.Chance(50) ? json("recv") : json(); } },
+			{ "simulcast.list2", [](Random&) { return json("4,5"); } },
+			{ "simulcast_03.value", [](Random&) { return json("send rid=5;6;7 paused=6,7"); } },
+			{ "framerate", [](Random& r) { return json(r.Pick({ 25.0, 29.97, 50.0, 59.94 })); } },
+			{ "sourceFilter.filterMode", [](Random& r) { return json(r.Chance(90) ? "incl" : "excl"); } },
+			{ "sourceFilter.netType", [](Random&) { return json("IN"); } },
+			{ "sourceFilter.addressTypes", [](Random&) { return json("IP4"); } },
+			{ "sourceFilter.destAddress", [](Random& r) { return json(r.Ip4(239)); } },
+			{ "sourceFilter.srcList", [](Random& r) { return json(r.Ip4(10)); } },
+			{ "tsRefclks.value", [](Random& r) { return json("ptp=IEEE1588-2008:" + r.Hex(8, '-') + ":" + std::to_string(r.Below(128))); } },
+			{ "mediaclk", [](Random& r) { return json("direct=" + std::to_string(r.Below(1000))); } },
+			{ "invalid.value", [](Random& r) { return json("x-unknown-" + r.Token(8)); } },
+		};
+		return GENERATORS;
+	}
+
+	std::string GetRuleKey(const sdptransform::grammar::Rule& rule)
+	{
+		return !rule.name.empty() ? rule.name : !rule.push.empty() ? rule.push : "media";
+	}
+
+	const sdptransform::grammar::Rule& FindRule(char type, const std::string& key)
+	{
+		for (const sdptransform::grammar::Rule& rule : sdptransform::grammar::rulesMap.at(type))
+		{
+			if (GetRuleKey(rule) == key)
+				return rule;
+		}
+		throw std::runtime_error("SDPCorpusGenerator: No rule " + key + " for " + type + "=");
+	}
+
+	// The fields of a rule with a name and names, or of one push element
+	json MakeFields(const sdptransform::grammar::Rule& rule, Random& random)
+	{
+		const std::map<std::string, FieldGenerator>& generators = GetFieldGenerators();
+		std::string key = GetRuleKey(rule);
+		if (rule.names.empty())
+			return generators.at(key)(random);
+
+		json fields = json::object();
+		for (const std::string& name : rule.names)
+		{
+			auto iter = generators.find(key + "." + name);
+			if (iter == generators.end())
+				continue;
+
+			json value = iter->second(random);
+			if (!value.is_null())
+				fields[name] = std::move(value);
+		}
+		return fields;
+	}
+
+	// Adds a line of the rule to a session or media section
+	void AddLine(const sdptransform::grammar::Rule& rule, json& location, json fields)
+	{
+		if (!rule.push.empty())
+			location[rule.push].push_back(std::move(fields));
+		else
+			location[rule.name] = std::move(fields);
+	}
+
+	void AddLine(char type, const std::string& key, json& location, Random& random)
+	{
+		const sdptransform::grammar::Rule& rule = FindRule(type, key);
+		AddLine(rule, location, MakeFields(rule, random));
+	}
+
+	/// <summary>
+	/// ReportUncovered: Names the rules of grammar::rulesMap that have no
+	///					 generator for a field, so a rule added to the
+	///					 grammar is not silently left out.
+	/// </summary>
+	void ReportUncovered()
+	{
+		const std::map<std::string, FieldGenerator>& generators = GetFieldGenerators();
+		for (const auto& [type, rules] : sdptransform::grammar::rulesMap)
+		{
+			for (const sdptransform::grammar::Rule& rule : rules)
+			{
+				std::string key = GetRuleKey(rule);
+				std::vector<std::string> names = rule.names;
+				if (names.empty())
+					names.push_back("");
+
+				for (const std::string& name : names)
+				{
+					// The m= payloads and rtpmap/fmtp payloads are set per section
+					std::string field = name.empty() ? key : key + "." + name;
+					if (!generators.contains(field) && field != "media.payloads" && field != "rtp.payload" && field != "fmtp.payload" && field != "fmtp.config")
+						std::cerr << "no generator for " << type << "=" << field << std::endl;
+				}
+			}
+		}
+	}
+
+	// "a=" rules drawn for the extra attributes of a section: everything
+	// but the ones a section gets by its shape
+	std::vector<const sdptransform::grammar::Rule*> GetExtraAttributeRules()
+	{
+		static const std::set<std::string> SHAPED = { "rtp", "fmtp", "candidates", "sourceFilter", "mid", "invalid" };
+
+		std::vector<const sdptransform::grammar::Rule*> rules;
+		for (const sdptransform::grammar::Rule& rule : sdptransform::grammar::rulesMap.at('a'))
+		{
+			if (!SHAPED.contains(GetRuleKey(rule)))
+				rules.push_back(&rule);
+		}
+		return rules;
+	}
+
+	void AddExtraAttributes(json& location, uint32_t count, Random& random)
+	{
+		static const std::vector<const sdptransform::grammar::Rule*> RULES = GetExtraAttributeRules();
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			// A named rule writes one line per section; once it has, draw
+			// until a push rule, which writes as many as it gets
+			const sdptransform::grammar::Rule* rule = RULES[random.Below(RULES.size())];
+			while (!rule->name.empty() && location.contains(rule->name))
+				rule = RULES[random.Below(RULES.size())];
+
+			AddLine(*rule, location, MakeFields(*rule, random));
+		}
+	}
+
+	std::string MakeFmtpConfig(uint32_t params, Random& random)
+	{
+		static const char* KNOWN[] = { "sampling=YCbCr-4:2:2", "width=1920", "height=1080", "exactframerate=30000/1001", "depth=10", "TCS=SDR",
+			"colorimetry=BT709", "PM=2110GPM", "SSN=ST2110-20:2017", "TP=2110TPN" };
+
+		std::string config;
+		for (uint32_t i = 0; i < params; i++)
+		{
+			if (i != 0)
+				config += "; ";
+			config += i < std::size(KNOWN) ? std::string(KNOWN[i]) : "x-param-" + std::to_string(i) + "=" + random.Token(6);
+		}
+		return config.empty() ? "x-none=0" : config;
+	}
+
+	/// <summary>
+	/// AddPathologicalLine: Adds one of the lines known to be costly for
+	///						 the regex rules, pathological_octets long and
+	///						 still written and read back by its rule: a
+	///						 long imageattr list, simulcast list, ICE
+	///						 candidate foundation, fmtp config, rid
+	///						 parameter list, ssrc cname, or an unknown
+	///						 attribute that every rule is tried on.
+	/// </summary>
+	void AddPathologicalLine(json& section, uint32_t kind, uint32_t octets, Random& random)
+	{
+		auto repeat = [octets](const std::string& unit, const std::string& separator)
+		{
+			std::string text = unit;
+			while (text.size() + separator.size() + unit.size() <= octets)
+				text += separator + unit;
+			return text;
+		};
+
+		switch (kind % 7)
+		{
+		case 0:
+		{
+			json fields = MakeFields(FindRule('a', "imageattrs"), random);
+			fields["attrs1"] = repeat("[x=1920,y=1080]", " ");
+			AddLine(FindRule('a', "imageattrs"), section, std::move(fields));
+			break;
+		}
+		case 1:
+		{
+			json fields = MakeFields(FindRule('a', "simulcast"), random);
+			fields["list1"] = repeat("~a", ";");
+			AddLine(FindRule('a', "simulcast"), section, std::move(fields));
+			break;
+		}
+		case 2:
+		{
+			json fields = MakeFields(FindRule('a', "candidates"), random);
+			fields["foundation"] = random.Token(octets);
+			AddLine(FindRule('a', "candidates"), section, std::move(fields));
+			break;
+		}
+		case 3:
+			AddLine(FindRule('a', "fmtp"), section, { { "payload", 96 }, { "config", repeat("a=1", ";") } });
+			break;
+		case 4:
+		{
+			json fields = MakeFields(FindRule('a', "rids"), random);
+			fields["params"] = repeat("max-width=1", ";");
+			AddLine(FindRule('a', "rids"), section, std::move(fields));
+			break;
+		}
+		case 5:
+		{
+			json fields = MakeFields(FindRule('a', "ssrcs"), random);
+			fields["value"] = random.Token(octets);
+			AddLine(FindRule('a', "ssrcs"), section, std::move(fields));
+			break;
+		}
+		default:
+			AddLine(FindRule('a', "invalid"), section, { { "value", "x-unknown-" + random.Token(octets) } });
+			break;
+		}
+	}
+
+	json MakeMedia(const Shape& shape, Random& random)
+	{
+		json media = MakeFields(FindRule('m', "media"), random);
+
+		// One to four payloads, each with an rtpmap and an fmtp
+		uint32_t payload_count = 1 + (uint32_t)random.Below(4);
+		std::string payloads;
+		for (uint32_t i = 0; i < payload_count; i++)
+		{
+			int32_t payload = 96 + (int32_t)i;
+			payloads += (i != 0 ? " " : "") + std::to_string(payload);
+
+			json rtp = MakeFields(FindRule('a', "rtp"), random);
+			rtp["payload"] = payload;
+			AddLine(FindRule('a', "rtp"), media, std::move(rtp));
+			AddLine(FindRule('a', "fmtp"), media, { { "payload", payload }, { "config", MakeFmtpConfig(shape.fmtp_params, random) } });
+		}
+		media["payloads"] = payloads;
+
+		if (random.Chance(30))
+			AddLine('i', "description", media, random);
+		AddLine('c', "connection", media, random);
+		if (random.Chance(50))
+			AddLine('b', "bandwidth", media, random);
+		AddLine('a', "mid", media, random);
+
+		for (uint32_t i = 0; i < shape.candidates; i++)
+			AddLine('a', "candidates", media, random);
+
+		if (shape.sources > 0)
+		{
+			json filter = MakeFields(FindRule('a', "sourceFilter"), random);
+			std::string sources = filter["srcList"];
+			for (uint32_t i = 1; i < shape.sources; i++)
+				sources += " " + random.Ip4(10);
+			filter["srcList"] = sources;
+			AddLine(FindRule('a', "sourceFilter"), media, std::move(filter));
+		}
+
+		AddExtraAttributes(media, shape.attributes, random);
+
+		for (uint32_t i = 0; i < shape.pathological; i++)
+			AddPathologicalLine(media, (uint32_t)random.Below(7), shape.pathological_octets, random);
+
+		return media;
+	}
+
+	std::string Generate(const Shape& shape, Random& random)
+	{
+		json session = json::object();
+		for (const char* key : { "version", "origin", "name", "timing" })
+		{
+			const auto& [type, rules] = *std::find_if(sdptransform::grammar::rulesMap.begin(), sdptransform::grammar::rulesMap.end(), [key](const auto& entry)
+			{
+				return std::any_of(entry.second.begin(), entry.second.end(), [key](const sdptransform::grammar::Rule& rule) { return GetRuleKey(rule) == key; });
+			});
+			AddLine(type, key, session, random);
+		}
+
+		// The optional session lines, each now and then
+		for (const auto& [type, key] : std::initializer_list<std::pair<char, const char*>>{ { 'i', "description" }, { 'u', "uri" }, { 'e', "email" },
+			{ 'p', "phone" }, { 'c', "connection" }, { 'b', "bandwidth" }, { 'r', "repeats" }, { 'z', "timezones" } })
+		{
+			if (random.Chance(30))
+				AddLine(type, key, session, random);
+		}
+
+		AddExtraAttributes(session, shape.attributes, random);
+
+		session["media"] = json::array();
+		for (uint32_t i = 0; i < shape.media; i++)
+			session["media"].push_back(MakeMedia(shape, random));
+
+		return sdptransform::write(session);
+	}
+
+	// Whether the SDP parses back into a session that writes it again, that
+	// is every line was read by the rule that wrote it
+	bool Verify(const std::string& sdp, const std::string& label)
+	{
+		json session = sdptransform::parse(sdp);
+		std::string written = sdptransform::write(session);
+		if (written == sdp)
+			return true;
+
+		size_t line_start = 0;
+		for (size_t i = 0; i < std::min(sdp.size(), written.size()); i++)
+		{
+			if (sdp[i] != written[i])
+				break;
+			if (sdp[i] == '\n')
+				line_start = i + 1;
+		}
+		std::cerr << label << ": does not read back as written, from line \"" << sdp.substr(line_start, std::min<size_t>(sdp.find('\r', line_start) - line_start, 120)) << "\"" << std::endl;
+		return false;
+	}
+
+	void PrintUsage(const char* program)
+	{
+		std::cerr << "usage: " << program << " [--seed n] [--media n] [--attributes n] [--fmtp-params n] [--candidates n] [--sources n]"
+			" [--pathological n] [--pathological-octets n] [--count n --output directory] [--verify]" << std::endl;
+	}
+}
+
+
+/// <summary>
+/// SDPCorpusGenerator: Writes synthetic SDPs of a chosen shape for scale
+///						and stress runs of the parser, e.g. through
+///						sdp_adapter_corpus_benchmark: m-line count (1 to
+///						10,000), extra attributes per section, fmtp
+///						parameters, ICE candidates, source-filter sources
+///						and pathological lines per section. Every line is
+///						built from a grammar::rulesMap rule's fields and
+///						written by sdptransform::write() with that rule's
+///						format, so a line always exercises a real rule;
+///						--verify checks that each SDP parses back as
+///						written. One SDP goes to stdout, or --count of them
+///						to numbered files; the same seed and shape give the
+///						same SDPs.
+/// </summary>
+int main(int argc, char** argv)
+{
+	Shape shape;
+	uint32_t count = 1;
+	std::filesystem::path output;
+	bool verify = false;
+
+	std::map<std::string, uint32_t*> options = { { "--media", &shape.media }, { "--attributes", &shape.attributes },
+		{ "--fmtp-params", &shape.fmtp_params }, { "--candidates", &shape.candidates }, { "--sources", &shape.sources },
+		{ "--pathological", &shape.pathological }, { "--pathological-octets", &shape.pathological_octets }, { "--count", &count } };
+
+	for (int32_t i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		bool has_value = i + 1 < argc;
+		if (argument == "--seed" && has_value)
+			shape.seed = std::strtoull(argv[++i], nullptr, 10);
+		else if (options.contains(argument) && has_value)
+			*options[argument] = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+		else if (argument == "--output" && has_value)
+			output = argv[++i];
+		else if (argument == "--verify")
+			verify = true;
+		else
+		{
+			PrintUsage(argv[0]);
+			return 2;
+		}
+	}
+
+	if (shape.media < 1 || shape.media > 10000 || count == 0 || (count > 1 && output.empty()) || shape.pathological_octets < 16)
+	{
+		PrintUsage(argv[0]);
+		return 2;
+	}
+
+	ReportUncovered();
+
+	if (!output.empty())
+		std::filesystem::create_directories(output);
+
+	Random random(shape.seed);
+	bool verified = true;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		std::string sdp = Generate(shape, random);
+		std::string name = "synthetic_" + std::to_string(shape.seed) + "_" + std::to_string(i) + ".sdp";
+		if (verify)
+			verified = Verify(sdp, name) && verified;
+
+		if (output.empty())
+		{
+			std::cout << sdp;
+		}
+		else
+		{
+			std::ofstream file(output / name, std::ios::binary);
+			file << sdp;
+		}
+	}
+
+	return verified ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "sdp_adapter.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.h"
+
+
+namespace
+{
+	// Typical 2110 SDP: one -20 video and one -30 audio stream
+	const char* SDP_2110 =
+		"v=0\r\n"
+		"o=- 1443716955 1443716955 IN IP4 192.168.1.230\r\n"
+		"s=st2110 stream\r\n"
+		"t=0 0\r\n"
+		"a=recvonly\r\n"
+		"a=group:DUP primary\r\n"
+		"m=video 20000 RTP/AVP 96\r\n"
+		"c=IN IP4 239.100.9.10/32\r\n"
+		"a=source-filter: incl IN IP4 239.100.9.10 192.168.100.2\r\n"
+		"a=rtpmap:96 raw/90000\r\n"
+		"a=fmtp:96 sampling=YCbCr-4:2:2; width=1920; height=1080; exactframerate=30000/1001; depth=10; TCS=SDR; colorimetry=BT709; PM=2110GPM; SSN=ST2110-20:2017; TP=2110TPN; \r\n"
+		"a=mediaclk:direct=0\r\n"
+		"a=ts-refclk:ptp=IEEE1588-2008:39-A7-94-FF-FE-07-CB-D0:37\r\n"
+		"a=mid:primary\r\n"
+		"m=audio 20002 RTP/AVP 97\r\n"
+		"c=IN IP4 239.100.9.11/32\r\n"
+		"a=source-filter: incl IN IP4 239.100.9.11 192.168.100.2\r\n"
+		"a=rtpmap:97 L24/48000/8\r\n"
+		"a=fmtp:97 channel-order=SMPTE2110.(ST,51)\r\n"
+		"a=ptime:1\r\n"
+		"a=mediaclk:direct=0\r\n"
+		"a=ts-refclk:ptp=IEEE1588-2008:39-A7-94-FF-FE-07-CB-D0:37\r\n";
+
+	struct Measurement
+	{
+		double allocations_per_parse;
+		double bytes_per_parse;
+		double ns_per_parse;
+	};
+
+	template<typename Function>
+	Measurement Measure(int32_t iterations, Function function)
+	{
+		// Warm up
+		function();
+
+		uint64_t allocation_count = g_allocation_count.load();
+		uint64_t allocated_bytes = g_allocated_bytes.load();
+		auto start = std::chrono::steady_clock::now();
+
+		for (int32_t i = 0; i < iterations; i++)
+			function();
+
+		auto stop = std::chrono::steady_clock::now();
+
+		Measurement measurement;
+		measurement.allocations_per_parse = (double)(g_allocation_count.load() - allocation_count) / iterations;
+		measurement.bytes_per_parse = (double)(g_allocated_bytes.load() - allocated_bytes) / iterations;
+		measurement.ns_per_parse = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / iterations;
+		return measurement;
+	}
+
+	void Print(const char* name, const Measurement& measurement)
+	{
+		std::cout << name
+			<< "\tallocations/parse: " << measurement.allocations_per_parse
+			<< "\tbytes/parse: " << measurement.bytes_per_parse
+			<< "\tns/parse: " << measurement.ns_per_parse << std::endl;
+	}
+}
+
+
+/// <summary>
+/// SDPParserAllocationBenchmark: Reports heap allocations and time per parse
+///								  for sdptransform::parse() alone and for the
+///								  full Cf::SDPParser. The difference is the
+///								  cost of the SDPParser traversal itself.
+///								  "reused" parses with one long-lived 
+///								  parser, as a worker thread would.
+/// </summary>
+int main(int argc, char** argv)
+{
+	int32_t iterations = argc > 1 ? std::atoi(argv[1]) : 10000;
+	if (iterations <= 0)
+		iterations = 10000;
+
+	std::string sdp = SDP_2110;
+
+	Measurement transform = Measure(iterations, [&]()
+	{
+		json session = sdptransform::parse(sdp);
+	});
+
+	Measurement parser = Measure(iterations, [&]()
+	{
+		Cf::SDPParser sdp_parser(sdp);
+	});
+
+	Cf::SDPParser reused_parser;
+	Measurement reused = Measure(iterations, [&]()
+	{
+		reused_parser.Parse(sdp);
+	});
+
+	Print("sdptransform::parse", transform);
+	Print("Cf::SDPParser      ", parser);
+	Print("Cf::SDPParser reused", reused);
+
+	Measurement traversal;
+	traversal.allocations_per_parse = parser.allocations_per_parse - transform.allocations_per_parse;
+	traversal.bytes_per_parse = parser.bytes_per_parse - transform.bytes_per_parse;
+	traversal.ns_per_parse = parser.ns_per_parse - transform.ns_per_parse;
+	Print("SDPParser traversal", traversal);
+
+	traversal.allocations_per_parse = reused.allocations_per_parse - transform.allocations_per_parse;
+	traversal.bytes_per_parse = reused.bytes_per_parse - transform.bytes_per_parse;
+	traversal.ns_per_parse = reused.ns_per_parse - transform.ns_per_parse;
+	Print("SDPParser traversal reused", traversal);
+
+	return 0;
+}
@@ -23,13 +23,48 @@ namespace sdptransform
 			std::vector<char> types;
 			std::string format;
 			std::function<const std::string(const json&)> formatFunc;
+			// Linear time stand-in for reg, used by the bounded parse() for
+			// rules whose regex backtracks or recurses deeply on long lines.
+			// Fills one capture per name (one for a rule without names),
+			// empty for a group that did not match.
+			std::function<bool(const std::string&, std::vector<std::string>&)> linearMatch;
 		};
 
 		extern const std::map<char, std::vector<Rule>> rulesMap;
 	}
 
+	// Limits of the bounded parse(), which takes time linear in the SDP
+	// size and stack bounded by the line length
+	struct ParseLimits
+	{
+		// Longer SDPs are rejected.
+		size_t maxOctets = 1 << 20;
+
+		// Longer lines are skipped like lines no rule matches, unless
+		// skipping one changes what the SDP describes: a longer m=, c=,
+		// rtpmap, fmtp, mid, group, source-filter, ts-refclk or mediaclk
+		// line rejects the SDP (a skipped m= line would move its
+		// attributes to the media before it). std::regex recurses per
+		// character matched, a few hundred octets of stack each with
+		// libstdc++, so this also bounds the stack a line takes: the
+		// default fits a 1 MiB thread stack.
+		size_t maxLineOctets = 2048;
+
+		// Octets of lines handed to rule matchers, summed over every rule
+		// tried. An SDP that needs more is rejected. Typical SDPs take 5
+		// to 25 times their size; an a= line no rule matches about 40
+		// times its own.
+		size_t maxWork = 64 << 20;
+	};
+
 	json parse(const std::string& sdp);
 
+	// Bounded parse for SDPs from untrusted sources. A rule's regex is
+	// only tried at the start of the line, and rules with a linearMatch
+	// use that instead; within the limits the result is that of parse().
+	// Throws std::runtime_error when a limit rejects the SDP.
+	json parse(const std::string& sdp, const ParseLimits& limits);
+
 	json parseParams(const std::string& str);
 
 	std::vector<int> parsePayloads(const std::string& str);
@@ -1,4 +1,6 @@
 #include "sdptransform.hpp"
+#include <cctype>  // std::isspace()
+#include <cstring> // std::strlen()
 
 namespace sdptransform
 {
@@ -6,6 +8,14 @@ namespace sdptransform
 	{
 		bool hasValue(const json& o, const std::string& key);
 
+		bool matchCandidate(const std::string& content, std::vector<std::string>& captures);
+
+		bool matchGoogleFlag(const std::string& content, std::vector<std::string>& captures);
+
+		bool matchImageAttributes(const std::string& content, std::vector<std::string>& captures);
+
+		bool matchSimulcast(const std::string& content, std::vector<std::string>& captures);
+
 		const std::map<char, std::vector<Rule>> rulesMap =
 		{
 			{
@@ -531,33 +541,35 @@ namespace sdptransform
 					},
 
 					// a=ptime:20
+					// a=ptime:0.125
 					{
 						// name:
 						"ptime",
 						// push:
 						"",
 						// reg:
-						std::regex("^ptime:(\\d*)"),
+						std::regex("^ptime:(\\d+(?:\\.\\d+)?)"),
 						// names:
 						{ },
 						// types:
-						{ 'd' },
+						{ 'f' },
 						// format:
 						"ptime:%d"
 					},
 
 					// a=maxptime:60
+					// a=maxptime:0.125
 					{
 						// name:
 						"maxptime",
 						// push:
 						"",
 						// reg:
-						std::regex("^maxptime:(\\d*)"),
+						std::regex("^maxptime:(\\d+(?:\\.\\d+)?)"),
 						// names:
 						{ },
 						// types:
-						{ 'd' },
+						{ 'f' },
 						// format:
 						"maxptime:%d"
 					},
@@ -678,7 +690,9 @@ namespace sdptransform
 							str += hasValue(o, "network-cost") ? " network-cost %d" : "%v";
 
 							return str;
-						}
+						},
+						// linearMatch:
+						matchCandidate
 					},
 
 					// a=end-of-candidates
@@ -877,7 +891,11 @@ namespace sdptransform
 						// types:
 						{ 's' },
 						// format:
-						"x-google-flag:%s"
+						"x-google-flag:%s",
+						// formatFunc:
+						nullptr,
+						// linearMatch:
+						matchGoogleFlag
 					},
 
 					// a=rid:1 send max-width=1280;max-height=720;max-fps=30;depend=0
@@ -934,7 +952,9 @@ namespace sdptransform
 						{
 							return std::string("imageattr:%s %s %s") +
 								(hasValue(o, "dir2") ? " %s %s" : "");
-						}
+						},
+						// linearMatch:
+						matchImageAttributes
 					},
 
 					// a=simulcast:send 1,2,3;~4,~5 recv 6;~7,~8
@@ -967,7 +987,9 @@ namespace sdptransform
 						{
 							return std::string("simulcast:%s %s") +
 								(hasValue(o, "dir2") ? " %s %s" : "");
-						}
+						},
+						// linearMatch:
+						matchSimulcast
 					},
 
 					// Old simulcast draft 03 (implemented by Firefox).
@@ -1023,15 +1045,16 @@ namespace sdptransform
 					},
 
 					// a=ts-refclk:ptp=IEEE1588-2008:00-50-C2-FF-FE-90-04-37:0
+					// a=ts-refclk:localmac=7C-E9-D3-1B-9A-AF
 					{
 						// name:
-						"tsRefclk",
-						// push:
 						"",
+						// push:
+						"tsRefclks",
 						// reg:
 						std::regex("^ts-refclk:(.*)"),
 						// names:
-						{ },
+						{ "value" },
 						// types:
 						{ 's' },
 						// format:
@@ -1093,5 +1116,327 @@ namespace sdptransform
 				return false;
 			}
 		}
+
+		// Character classes as std::regex has them in the classic locale.
+		bool isSpace(char c)
+		{
+			return std::isspace(static_cast<unsigned char>(c)) != 0;
+		}
+
+		bool isNotSpace(char c)
+		{
+			return !isSpace(c);
+		}
+
+		bool isDigit(char c)
+		{
+			return c >= '0' && c <= '9';
+		}
+
+		// [a-zA-Z0-9\-_~;,]
+		bool isSimulcastListChar(char c)
+		{
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || isDigit(c) ||
+				c == '-' || c == '_' || c == '~' || c == ';' || c == ',';
+		}
+
+		// Moves pos past the longest run of characters accepted by the
+		// predicate and returns the run's length. A greedy class quantifier
+		// followed by a character outside the class never gives back, so
+		// this is what the regex matches.
+		size_t skipWhile(const std::string& str, size_t& pos, bool (*predicate)(char))
+		{
+			size_t start = pos;
+
+			while (pos < str.size() && predicate(str[pos]))
+				++pos;
+
+			return pos - start;
+		}
+
+		bool skipLiteral(const std::string& str, size_t& pos, const char* literal)
+		{
+			size_t length = std::strlen(literal);
+
+			if (str.compare(pos, length, literal) != 0)
+				return false;
+
+			pos += length;
+
+			return true;
+		}
+
+		// Stores the run the predicate accepts at pos as a capture.
+		void captureWhile(
+			const std::string& str, size_t& pos, bool (*predicate)(char), std::string& capture)
+		{
+			size_t start = pos;
+
+			skipWhile(str, pos, predicate);
+			capture.assign(str, start, pos - start);
+		}
+
+		void clearCaptures(std::vector<std::string>& captures, size_t count)
+		{
+			captures.resize(count);
+
+			for (auto& capture : captures)
+			{
+				capture.clear();
+			}
+		}
+
+		// One "[\S+]" of an image attribute list: \S+ takes the whole
+		// non-space run after "[" first and gives back to its last "]".
+		bool skipImageAttributeSet(const std::string& str, size_t& pos)
+		{
+			if (pos >= str.size() || str[pos] != '[')
+				return false;
+
+			size_t end = pos + 1;
+
+			skipWhile(str, end, isNotSpace);
+
+			for (size_t close = end; close-- > pos + 2;)
+			{
+				if (str[close] == ']')
+				{
+					pos = close + 1;
+
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// (\*|\[\S+\](?:[\s\t]+\[\S+\])*)
+		bool captureImageAttributeList(const std::string& str, size_t& pos, std::string& capture)
+		{
+			size_t start = pos;
+
+			if (skipLiteral(str, pos, "*"))
+			{
+				capture = "*";
+
+				return true;
+			}
+
+			if (!skipImageAttributeSet(str, pos))
+				return false;
+
+			for (;;)
+			{
+				size_t next = pos;
+
+				if (skipWhile(str, next, isSpace) == 0 || !skipImageAttributeSet(str, next))
+					break;
+
+				pos = next;
+			}
+
+			capture.assign(str, start, pos - start);
+
+			return true;
+		}
+
+		// (send|recv) or (recv|send); only one can match.
+		bool captureDirection(const std::string& str, size_t& pos, std::string& capture)
+		{
+			size_t start = pos;
+
+			if (!skipLiteral(str, pos, "send") && !skipLiteral(str, pos, "recv"))
+				return false;
+
+			capture.assign(str, start, pos - start);
+
+			return true;
+		}
+
+		// ^candidate:(\S*) (\d*) (\S*) (\d*) (\S*) (\d*) typ (\S*)
+		// (?: raddr (\S*) rport (\d*))?(?: tcptype (\S*))?(?: generation (\d*))?
+		// (?: network-id (\d*))?(?: network-cost (\d*))?
+		bool matchCandidate(const std::string& content, std::vector<std::string>& captures)
+		{
+			static bool (*const fields[])(char) =
+				{ isNotSpace, isDigit, isNotSpace, isDigit, isNotSpace, isDigit };
+
+			clearCaptures(captures, 13);
+
+			size_t pos = 0;
+
+			if (!skipLiteral(content, pos, "candidate:"))
+				return false;
+
+			for (size_t i = 0; i < 6; ++i)
+			{
+				captureWhile(content, pos, fields[i], captures[i]);
+
+				if (!skipLiteral(content, pos, " "))
+					return false;
+			}
+
+			if (!skipLiteral(content, pos, "typ "))
+				return false;
+
+			captureWhile(content, pos, isNotSpace, captures[6]);
+
+			// Each optional group either matches as a whole or leaves pos and
+			// its captures alone.
+			size_t next = pos;
+
+			if (skipLiteral(content, next, " raddr "))
+			{
+				size_t raddr = next;
+
+				skipWhile(content, next, isNotSpace);
+
+				size_t raddrEnd = next;
+
+				if (skipLiteral(content, next, " rport "))
+				{
+					captures[7].assign(content, raddr, raddrEnd - raddr);
+					captureWhile(content, next, isDigit, captures[8]);
+					pos = next;
+				}
+			}
+
+			static const struct
+			{
+				const char* literal;
+				bool (*predicate)(char);
+				size_t capture;
+			} optionals[] =
+			{
+				{ " tcptype ",      isNotSpace, 9  },
+				{ " generation ",   isDigit,    10 },
+				{ " network-id ",   isDigit,    11 },
+				{ " network-cost ", isDigit,    12 }
+			};
+
+			for (const auto& optional : optionals)
+			{
+				if (skipLiteral(content, pos, optional.literal))
+					captureWhile(content, pos, optional.predicate, captures[optional.capture]);
+			}
+
+			return true;
+		}
+
+		// x-google-flag:([^\s]*), anywhere in the line.
+		bool matchGoogleFlag(const std::string& content, std::vector<std::string>& captures)
+		{
+			clearCaptures(captures, 1);
+
+			size_t pos = content.find("x-google-flag:");
+
+			if (pos == std::string::npos)
+				return false;
+
+			pos += std::strlen("x-google-flag:");
+			captureWhile(content, pos, isNotSpace, captures[0]);
+
+			return true;
+		}
+
+		// ^imageattr:(\d+|\*)[\s\t]+(send|recv)[\s\t]+(<list>)
+		// (?:[\s\t]+(recv|send)[\s\t]+(<list>))?
+		bool matchImageAttributes(const std::string& content, std::vector<std::string>& captures)
+		{
+			clearCaptures(captures, 5);
+
+			size_t pos = 0;
+
+			if (!skipLiteral(content, pos, "imageattr:"))
+				return false;
+
+			captureWhile(content, pos, isDigit, captures[0]);
+
+			if (captures[0].empty())
+			{
+				if (!skipLiteral(content, pos, "*"))
+					return false;
+
+				captures[0] = "*";
+			}
+
+			if (skipWhile(content, pos, isSpace) == 0 || !captureDirection(content, pos, captures[1]))
+				return false;
+
+			if (skipWhile(content, pos, isSpace) == 0 || !captureImageAttributeList(content, pos, captures[2]))
+				return false;
+
+			size_t next = pos;
+
+			if (
+				skipWhile(content, next, isSpace) == 0 ||
+				!captureDirection(content, next, captures[3]) ||
+				skipWhile(content, next, isSpace) == 0 ||
+				!captureImageAttributeList(content, next, captures[4])
+			)
+			{
+				captures[3].clear();
+				captures[4].clear();
+			}
+
+			return true;
+		}
+
+		// ^simulcast:(send|recv) ([a-zA-Z0-9\-_~;,]+)
+		// (?:\s?(send|recv) ([a-zA-Z0-9\-_~;,]+))?$
+		//
+		// The second direction follows the whole first list and a whitespace
+		// character, or is given back by a first list that ends with it and a
+		// space: "send 1;2recv 3".
+		bool matchSimulcast(const std::string& content, std::vector<std::string>& captures)
+		{
+			clearCaptures(captures, 4);
+
+			size_t pos = 0;
+
+			if (
+				!skipLiteral(content, pos, "simulcast:") ||
+				!captureDirection(content, pos, captures[0]) ||
+				!skipLiteral(content, pos, " ")
+			)
+			{
+				return false;
+			}
+
+			captureWhile(content, pos, isSimulcastListChar, captures[1]);
+
+			if (captures[1].empty())
+				return false;
+
+			if (pos == content.size())
+				return true;
+
+			auto matchSecond = [&](size_t next)
+			{
+				if (
+					!captureDirection(content, next, captures[2]) ||
+					!skipLiteral(content, next, " ")
+				)
+				{
+					return false;
+				}
+
+				captureWhile(content, next, isSimulcastListChar, captures[3]);
+
+				return !captures[3].empty() && next == content.size();
+			};
+
+			if (isSpace(content[pos]) && matchSecond(pos + 1))
+				return true;
+
+			if (captures[1].size() > 4 && matchSecond(pos - 4))
+			{
+				captures[1].resize(captures[1].size() - 4);
+
+				return true;
+			}
+
+			return false;
+		}
 	}
 }
@@ -7,13 +7,28 @@
 #include <algorithm> // std::find_if()
 #include <cctype>    // std::isspace()
 #include <cstdint>   // std::uint64_t
+#include <stdexcept> // std::runtime_error
 
 namespace sdptransform
 {
-	void parseReg(const grammar::Rule& rule, json& location, const std::string& content);
+	json parseLines(const std::string& sdp, const ParseLimits* limits);
+
+	bool isValidLine(const std::string& line);
+
+	bool isEssentialLine(const std::string& line);
+
+	bool matchRule(
+		const grammar::Rule& rule,
+		const std::string& content,
+		bool bounded,
+		std::smatch& match,
+		std::vector<std::string>& captures
+	);
+
+	void parseReg(const grammar::Rule& rule, json& location, const std::vector<std::string>& captures);
 
 	void attachProperties(
-		const std::smatch& match,
+		const std::vector<std::string>& captures,
 		json& location,
 		const std::vector<std::string>& names,
 		const std::string& rawName,
@@ -34,13 +49,30 @@ namespace sdptransform
 
 	json parse(const std::string& sdp)
 	{
-		static const std::regex ValidLineRegex("^([a-z])=(.*)");
+		return parseLines(sdp, nullptr);
+	}
 
+	json parse(const std::string& sdp, const ParseLimits& limits)
+	{
+		if (sdp.size() > limits.maxOctets)
+		{
+			throw std::runtime_error(
+				"sdptransform::parse: SDP of " + std::to_string(sdp.size()) + " octets is over the limit");
+		}
+
+		return parseLines(sdp, std::addressof(limits));
+	}
+
+	json parseLines(const std::string& sdp, const ParseLimits* limits)
+	{
 		json session = json::object();
 		std::stringstream sdpstream(sdp);
 		std::string line;
 		json media = json::array();
 		json* location = std::addressof(session);
+		std::smatch match;
+		std::vector<std::string> captures;
+		size_t work = 0;
 
 		while (std::getline(sdpstream, line, '\n'))
 		{
@@ -49,10 +81,26 @@ namespace sdptransform
 				line.pop_back();
 
 			// Ensure it's a valid SDP line.
-			if (!std::regex_search(line, ValidLineRegex))
+			if (!isValidLine(line))
 				continue;
 
 			char type = line[0];
+
+			if (limits && line.size() > limits->maxLineOctets)
+			{
+				if (isEssentialLine(line))
+				{
+					// "m=", "c=", or the attribute name of an "a=" line
+					std::string name = line.substr(0, type == 'a' ? line.find(':') : 2);
+
+					throw std::runtime_error(
+						"sdptransform::parse: " + name + " line of " + std::to_string(line.size()) +
+						" octets is over the limit");
+				}
+
+				continue;
+			}
+
 			std::string content = line.substr(2);
 
 			if (type == 'm')
@@ -79,9 +127,17 @@ namespace sdptransform
 			{
 				auto& rule = rules[j];
 
-				if (std::regex_search(content, rule.reg))
+				if (limits)
+				{
+					work += content.size();
+
+					if (work > limits->maxWork)
+						throw std::runtime_error("sdptransform::parse: SDP is over the work limit");
+				}
+
+				if (matchRule(rule, content, limits != nullptr, match, captures))
 				{
-					parseReg(rule, *location, content);
+					parseReg(rule, *location, captures);
 
 					break;
 				}
@@ -207,7 +263,64 @@ namespace sdptransform
 		return arr;
 	}
 
-	void parseReg(const grammar::Rule& rule, json& location, const std::string& content)
+	// Same as matching "^([a-z])=", without running a regex over every line.
+	bool isValidLine(const std::string& line)
+	{
+		return line.size() >= 2 && line[0] >= 'a' && line[0] <= 'z' && line[1] == '=';
+	}
+
+	// Lines the bounded parse may not skip: media sections, addresses and
+	// the attributes that say how to receive and decode a stream
+	bool isEssentialLine(const std::string& line)
+	{
+		static const std::vector<std::string> EssentialAttributes =
+			{ "rtpmap:", "fmtp:", "mid:", "group:", "source-filter:", "ts-refclk:", "mediaclk:" };
+
+		if (line[0] == 'm' || line[0] == 'c')
+			return true;
+
+		if (line[0] != 'a')
+			return false;
+
+		return std::any_of(
+			EssentialAttributes.begin(),
+			EssentialAttributes.end(),
+			[&line](const std::string& attribute) { return line.compare(2, attribute.size(), attribute) == 0; });
+	}
+
+	// Bounded matching anchors every regex at the start of the content, so a
+	// rule that does not match fails on its first characters rather than
+	// being retried at each position. The rules that are not anchored with
+	// "^" either match at the start anyway ("(.*)") or have a linearMatch.
+	bool matchRule(
+		const grammar::Rule& rule,
+		const std::string& content,
+		bool bounded,
+		std::smatch& match,
+		std::vector<std::string>& captures
+	)
+	{
+		if (bounded && rule.linearMatch)
+			return rule.linearMatch(content, captures);
+
+		auto flags = bounded
+			? std::regex_constants::match_continuous
+			: std::regex_constants::match_default;
+
+		if (!std::regex_search(content, match, rule.reg, flags))
+			return false;
+
+		captures.resize(match.size() - 1);
+
+		for (size_t i = 1; i < match.size(); ++i)
+		{
+			captures[i - 1].assign(match[i].first, match[i].second);
+		}
+
+		return true;
+	}
+
+	void parseReg(const grammar::Rule& rule, json& location, const std::vector<std::string>& captures)
 	{
 		bool needsBlank = !rule.name.empty() && !rule.names.empty();
 
@@ -220,10 +333,6 @@ namespace sdptransform
 			location[rule.name] = json::object();
 		}
 
-		std::smatch match;
-
-		std::regex_search(content, match, rule.reg);
-
 		json object = json::object();
 		json& keyLocation = !rule.push.empty()
 			// Blank object that will be pushed.
@@ -233,14 +342,14 @@ namespace sdptransform
 				? location[rule.name]
 				: location;
 
-		attachProperties(match, keyLocation, rule.names, rule.name, rule.types);
+		attachProperties(captures, keyLocation, rule.names, rule.name, rule.types);
 
 		if (!rule.push.empty())
 			location[rule.push].push_back(keyLocation);
 	}
 
 	void attachProperties(
-		const std::smatch& match,
+		const std::vector<std::string>& captures,
 		json& location,
 		const std::vector<std::string>& names,
 		const std::string& rawName,
@@ -249,15 +358,15 @@ namespace sdptransform
 	{
 		if (!rawName.empty() && names.empty())
 		{
-			location[rawName] = toType(match[1].str(), types[0]);
+			location[rawName] = toType(captures.empty() ? std::string() : captures[0], types[0]);
 		}
 		else
 		{
 			for (size_t i = 0; i < names.size(); ++i)
 			{
-				if (i + 1 < match.size() && !match[i + 1].str().empty())
+				if (i < captures.size() && !captures[i].empty())
 				{
-					location[names[i]] = toType(match[i + 1].str(), types[i]);
+					location[names[i]] = toType(captures[i], types[i]);
 				}
 			}
 		}
@@ -1,4 +1,5 @@
 #include "sdptransform.hpp"
+#include <cmath>     // std::floor
 #include <cstddef>   // size_t
 #include <sstream>   // std::stringstream
 #include <stdexcept>
@@ -12,6 +13,8 @@ namespace sdptransform
 		const json& location
 	);
 
+	bool isWholeNumber(const json& value);
+
 	std::string write(json& session)
 	{
 		// RFC specified order.
@@ -194,6 +197,10 @@ namespace sdptransform
 				{
 					if (arg.is_string())
 						linestream << arg.get<std::string>();
+					// Decimal rules such as ptime parse into doubles, write
+					// their whole numbers back without a fraction.
+					else if (str == "%d" && isWholeNumber(arg))
+						linestream << arg.get<std::int64_t>();
 					else
 						linestream << arg;
 				}
@@ -208,4 +215,14 @@ namespace sdptransform
 
 		sdpstream << linestream.str();
 	}
+
+	bool isWholeNumber(const json& value)
+	{
+		if (!value.is_number_float())
+			return false;
+
+		double number = value.get<double>();
+
+		return std::floor(number) == number && std::abs(number) < 9.0e18;
+	}
 }
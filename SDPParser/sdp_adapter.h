@@ -28,6 +28,29 @@ By using the Code, Licensee agrees to these terms.
 #include <iostream>
 #include <string>
 #include <regex>
+#include <variant>
+#include <unordered_map>
+#include <string_view>
+#include <array>
+#include <optional>
+#include <bit>
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <charconv>
+#include <memory>
+#include <cstring>
+#include <cmath>
+
+// socket address types for resolved endpoints
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#endif
 
 
 // common includes
@@ -35,7 +58,13 @@ By using the Code, Licensee agrees to these terms.
 #include "mainconcept_adapter.h"
 #include "sdptransform.hpp"
 #include "SDPEnums.h"
+#include "SDPEnumTables.h"
+#include "SDPRational.h"
+#include "SDPContainers.h"
 #include "SDP.h"
+#include "SDPVideoFormat.h"
+#include "SDPStreamGeometry.h"
+#include "SDPPacing.h"
 #include "SDPParser.h"
 
 using namespace sdptransform;
\ No newline at end of file
@@ -0,0 +1,272 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "sdp_adapter.h"
+
+#include <iostream>
+
+namespace
+{
+	int32_t g_failures = 0;
+
+	void Check(bool condition, const std::string& what)
+	{
+		if (!condition)
+		{
+			std::cerr << "  FAILED: " << what << std::endl;
+			g_failures++;
+		}
+	}
+
+	std::string MakeAudioSDP(const std::string& origin_address, const std::string& connection_address, const std::string& ptime = "1")
+	{
+		return
+			"v=0\r\n"
+			"o=- 1443716955 1443716955 IN IP4 " + origin_address + "\r\n"
+			"s=st2110 audio\r\n"
+			"t=0 0\r\n"
+			"m=audio 20000 RTP/AVP 97\r\n"
+			"c=IN IP4 " + connection_address + "/32\r\n"
+			"a=rtpmap:97 L24/48000/2\r\n"
+			"a=ptime:" + ptime + "\r\n";
+	}
+
+	std::string MakeVideoSDP(const std::string& encoding, const std::string& fmtp)
+	{
+		return
+			"v=0\r\n"
+			"o=- 1443716955 1443716955 IN IP4 10.0.0.1\r\n"
+			"s=st2110 video\r\n"
+			"t=0 0\r\n"
+			"m=video 20000 RTP/AVP 96\r\n"
+			"c=IN IP4 239.100.9.10/32\r\n"
+			"a=rtpmap:96 " + encoding + "/90000\r\n"
+			"a=fmtp:96 " + fmtp + "\r\n";
+	}
+
+	// RFC 8866 5.7 allows any FQDN, up to 253 characters, where an
+	// address goes; it must not reject the SDP
+	void LongHostNames()
+	{
+		std::string label(63, 'a');
+		std::string fqdn = label + "." + label + "." + label + "." + std::string(61, 'b');
+		std::string origin = "origin." + label + ".example.com";
+		Check(fqdn.size() == 253, "the FQDN is 253 characters");
+
+		Cf::SDPParser parser(MakeAudioSDP(origin, fqdn));
+		const Cf::SDP& sdp = parser.GetSDP();
+		Check(sdp.origin.unicast_address == origin, "o= keeps a long unicast address");
+		Check(sdp.GetAudio(0).connection_information.connection_address == fqdn, "c= keeps a 253 character FQDN");
+
+		// Copies and moves keep the heap allocated address
+		Cf::SDP copy = sdp;
+		Check(copy.GetAudio(0).connection_information.connection_address == fqdn, "a copy keeps the FQDN");
+		Cf::SDP moved = std::move(copy);
+		Check(moved.GetAudio(0).connection_information.connection_address == fqdn, "a move keeps the FQDN");
+
+		// A reused parser goes back to a short address
+		parser.Parse(MakeAudioSDP("10.0.0.1", "239.100.9.11"));
+		Check(parser.GetSDP().origin.unicast_address == "10.0.0.1", "a reparse replaces the long unicast address");
+		Check(parser.GetSDP().GetAudio(0).connection_information.connection_address == "239.100.9.11", "a reparse replaces the FQDN");
+	}
+
+	void SessionDescription()
+	{
+		Cf::SDPParser parser(MakeAudioSDP("10.0.0.1", "239.100.9.11"));
+		const Cf::SDP& sdp = parser.GetSDP();
+		Check(sdp.protocol_version == 0 && sdp.session_name == "st2110 audio", "v= and s= are read");
+		Check(sdp.origin.sess_id == 1443716955 && sdp.origin.net_type == "IN" && sdp.origin.addr_type == 4, "o= is read");
+
+		bool rejected = false;
+		try
+		{
+			std::string sdp_text = MakeAudioSDP("10.0.0.1", "239.100.9.11");
+			parser.Parse(sdp_text.erase(sdp_text.find("s="), sdp_text.find("t=") - sdp_text.find("s=")));
+		}
+		catch (const std::exception&)
+		{
+			rejected = true;
+		}
+		Check(rejected, "an SDP without s= is rejected");
+	}
+
+	// The media type parameters of 2110-20 and 2110-22 video
+	void VideoParameters()
+	{
+		Cf::SDPParser parser(MakeVideoSDP("raw", "sampling=YCbCr-4:2:2; width=1920; height=1080; exactframerate=30000/1001; depth=10; "
+			"TCS=HLG; colorimetry=BT2100; RANGE=FULL; PM=2110BPM; SSN=ST2110-20:2017; TP=2110TPW; interlace; segmented; PAR=12:11; MAXUDP=8960"));
+		const Cf::SDP::VideoDescription* video = parser.GetSDP().GetFirstVideo();
+		Check(video->standard == Cf::SDPStandard::UNCOMPRESSED && video->width == 1920 && video->height == 1080, "SSN, width and height are read");
+		Check(video->sampling == Cf::SDPSampling::YCBCR_422 && video->depth == Cf::SDPDepth::INT_10, "sampling and depth are read");
+		Check(video->framerate == Cf::Rational(30000, 1001), "exactframerate is read");
+		Check(video->interlaced && video->segmented, "interlace and segmented flags are read");
+		Check(video->tcs == Cf::SDPTransferCharacteristicSystem::HLG && video->range == Cf::SDPRange::FULL, "TCS and RANGE are read");
+		Check(video->tp == Cf::SDP_TP::WIDE && video->max_udp == 8960, "TP and MAXUDP are read");
+		Check(video->par_width == 12 && video->par_height == 11, "PAR is read");
+
+		parser.Parse(MakeVideoSDP("jxsv", "packetmode=0; depth=10; width=3840; height=2160; exactframerate=50; sampling=YCbCr-4:2:2; "
+			"colorimetry=BT709; SSN=ST2110-22:2019; TP=2110TPN; CMAX=4"));
+		video = parser.GetSDP().GetFirstVideo();
+		Check(video->standard == Cf::SDPStandard::JPEGXS && video->width == 3840 && video->height == 2160, "2110-22 SSN, width and height are read");
+		Check(video->tp == Cf::SDP_TP::NARROW && video->cmax == 4, "2110-22 TP and CMAX are read");
+
+		bool rejected = false;
+		try
+		{
+			parser.Parse(MakeVideoSDP("raw", "sampling=YCbCr-4:2:2; height=1080; exactframerate=50; depth=10; colorimetry=BT709; PM=2110GPM; SSN=ST2110-20:2017"));
+		}
+		catch (const std::exception&)
+		{
+			rejected = true;
+		}
+		Check(rejected, "uncompressed video without width is rejected");
+	}
+
+	// Parameters the SDP omits read the same from a reused parser as from
+	// a new one
+	void ReusedDefaults()
+	{
+		std::string minimal = MakeVideoSDP("raw", "sampling=YCbCr-4:2:2; width=1280; height=720; exactframerate=50; depth=8; colorimetry=BT709; PM=2110GPM; SSN=ST2110-20:2017");
+
+		Cf::SDPParser reused(MakeVideoSDP("raw", "sampling=YCbCr-4:4:4; width=1920; height=1080; exactframerate=25; depth=12; "
+			"TCS=PQ; colorimetry=BT2100; RANGE=FULL; PM=2110BPM; SSN=ST2110-20:2017; TP=2110TPW; interlace; PAR=12:11; MAXUDP=8960"));
+		const Cf::SDP::VideoDescription& a = *reused.Parse(minimal).GetFirstVideo();
+
+		Cf::SDPParser fresh(minimal);
+		const Cf::SDP::VideoDescription& b = *fresh.GetSDP().GetFirstVideo();
+
+		Check(a.width == b.width && a.height == b.height && a.standard == b.standard, "size and standard match");
+		Check(a.tp == b.tp && a.cmax == b.cmax && a.interlaced == b.interlaced && a.segmented == b.segmented, "TP, CMAX and scan match");
+		Check(a.tcs == b.tcs && a.range == b.range && a.max_udp == b.max_udp, "TCS, RANGE and MAXUDP match");
+		Check(a.par_width == b.par_width && a.par_height == b.par_height, "PAR matches");
+	}
+
+	void FixedStrings()
+	{
+		Cf::FixedString<15> text = "short";
+		Check(text.IsInline() && text == "short", "a short value stays inline");
+
+		std::string long_text(40, 'x');
+		text = long_text;
+		Check(!text.IsInline() && text == long_text, "a long value moves to the heap");
+
+		// Assigning part of itself
+		text = text.view().substr(1, 20);
+		Check(text == long_text.substr(1, 20), "a value can be assigned from itself");
+
+		Cf::FixedString<15> moved = std::move(text);
+		Check(moved == long_text.substr(1, 20) && text.empty() && text.IsInline(), "a move takes the heap buffer");
+	}
+
+	// Decimal ptime/maxptime parse into doubles and must write back as
+	// they were written
+	void PacketTimes()
+	{
+		const char* LINES[] = { "a=ptime:1", "a=ptime:20", "a=ptime:0.125", "a=maxptime:60", "a=maxptime:0.125" };
+
+		for (const char* line : LINES)
+		{
+			std::string sdp = std::string("v=0\r\ns=-\r\nm=audio 20000 RTP/AVP 97\r\n") + line + "\r\n";
+			json session = sdptransform::parse(sdp);
+			std::string written = sdptransform::write(session);
+			Check(written.find(std::string(line) + "\r\n") != std::string::npos, std::string(line) + " writes back unchanged, not as in " + written);
+		}
+
+		Cf::SDPParser parser(MakeAudioSDP("10.0.0.1", "239.100.9.11", "0.125"));
+		Check(parser.GetSDP().GetAudio(0).attributes.ptime == 0.125, "a=ptime:0.125 keeps its fraction");
+	}
+
+	// A bounded parse may skip an over-long line only when its loss
+	// leaves the meaning of the SDP unchanged
+	void OverLongLines()
+	{
+		sdptransform::ParseLimits limits;
+		std::string padding(limits.maxLineOctets, '1');
+		std::string sdp = MakeAudioSDP("10.0.0.1", "239.100.9.11");
+
+		const std::string ESSENTIAL[] =
+		{
+			"a=fmtp:97 x=" + padding,
+			"a=source-filter: incl IN IP4 239.100.9.11 10.0.0." + padding,
+			"a=rtpmap:97 L24/48000/" + padding,
+			"a=mid:" + padding,
+			"a=group:DUP " + padding,
+		};
+		for (const std::string& line : ESSENTIAL)
+		{
+			bool rejected = false;
+			try
+			{
+				sdptransform::parse(sdp + line + "\r\n", limits);
+			}
+			catch (const std::exception&)
+			{
+				rejected = true;
+			}
+			Check(rejected, "over-long " + line.substr(0, line.find(':')) + " line rejects the SDP");
+		}
+
+		json session = sdptransform::parse(sdp + "a=x-vendor:" + padding + "\r\n", limits);
+		Check(session == sdptransform::parse(sdp), "over-long unknown attribute is skipped");
+	}
+
+	struct Test
+	{
+		const char* name;
+		void (*run)();
+	};
+
+	const Test TESTS[] =
+	{
+		{ "long host names", LongHostNames },
+		{ "session description", SessionDescription },
+		{ "video parameters", VideoParameters },
+		{ "reused defaults", ReusedDefaults },
+		{ "fixed strings", FixedStrings },
+		{ "packet times", PacketTimes },
+		{ "over-long lines", OverLongLines },
+	};
+}
+
+
+int main()
+{
+	for (const Test& test : TESTS)
+	{
+		int32_t failures = g_failures;
+		try
+		{
+			test.run();
+		}
+		catch (const std::exception& exception)
+		{
+			std::cerr << "  FAILED: threw " << exception.what() << std::endl;
+			g_failures++;
+		}
+
+		std::cout << (g_failures == failures ? "PASS " : "FAIL ") << test.name << std::endl;
+	}
+
+	return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,149 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	// Sample type of decoded audio. INT32 samples are MSB aligned (an L24
+	// sample is shifted left by 8, L16 by 16); FLOAT32 samples are the
+	// INT32 value scaled to [-1, 1).
+	enum class SampleFormat : uint8_t
+	{
+		INT32,
+		FLOAT32
+	};
+
+	constexpr const char* SampleFormatName(SampleFormat sample_format)
+	{
+		return sample_format == SampleFormat::FLOAT32 ? "float32" : "int32";
+	}
+
+	// Order of decoded audio in memory
+	enum class SampleLayout : uint8_t
+	{
+		INTERLEAVED,	// sample frames of all selected channels in turn
+		PLANAR			// one plane per selected channel
+	};
+
+	constexpr const char* SampleLayoutName(SampleLayout sample_layout)
+	{
+		return sample_layout == SampleLayout::PLANAR ? "planar" : "interleaved";
+	}
+
+
+	/// <summary>
+	/// AudioBuffer: Decoded audio of the selected channels, 4 bytes per
+	///				 sample. Interleaved sample i of channel c is at
+	///				 data[i * channels + c]; planar, at
+	///				 data[c * channel_stride + i].
+	/// </summary>
+	struct AudioBuffer
+	{
+		void* data = nullptr;
+		uint32_t channel_stride = 0;	// samples between planes
+	};
+
+
+	/// <summary>
+	/// AudioFormat: Compact copy of the per-packet relevant parts of an
+	///				 L16 or L24 (ST 2110-30 / AES67) audio description, from
+	///				 the rtpmap encoding, sample rate, channel count and
+	///				 ptime. Throws for other encodings, such as AM824.
+	/// </summary>
+	struct AudioFormat
+	{
+	public:
+		uint32_t channels = 0;
+		uint32_t sample_rate = 0;
+		uint32_t samples_per_packet = 0;
+		uint32_t bytes_per_sample = 0;	// 2 for L16, 3 for L24
+		uint32_t frame_octets = 0;		// one sample of every channel
+		uint32_t packet_data_octets = 0;
+
+		AudioFormat() = default;
+
+		explicit AudioFormat(const SDP::AudioDescription& audio_description)
+		{
+			AudioStreamGeometry geometry(audio_description);
+			if (geometry.bytes_per_sample != 2 && geometry.bytes_per_sample != 3)
+				throw std::runtime_error("AudioFormat: Only L16 and L24 audio is linear PCM");
+
+			channels = geometry.channels;
+			sample_rate = geometry.sample_rate;
+			samples_per_packet = geometry.samples_per_packet;
+			bytes_per_sample = geometry.bytes_per_sample;
+			frame_octets = channels * bytes_per_sample;
+			packet_data_octets = geometry.packet_data_octets;
+		}
+	};
+
+
+	/// <summary>
+	/// ChannelRange: Consecutive channels of a stream to decode or encode.
+	///				  A count of 0 runs to the last channel. FromGroup()
+	///				  selects a channel group of the structured channel
+	///				  order, e.g. the second stereo pair of
+	///				  "SMPTE2110.(ST,ST,51)".
+	/// </summary>
+	struct ChannelRange
+	{
+	public:
+		uint32_t first = 0;
+		uint32_t count = 0;
+
+		// Group n of the channel order
+		static ChannelRange FromGroup(const SDP::AudioDescription& audio_description, size_t group_index)
+		{
+			if (group_index >= audio_description.channel_groups.size())
+				throw std::runtime_error("ChannelRange: Channel order has no group " + std::to_string(group_index));
+
+			const SDP::AudioDescription::ChannelGroup& group = audio_description.channel_groups[group_index];
+			return { (uint32_t)group.first_channel, (uint32_t)group.channel_count };
+		}
+
+		// The nth group with a grouping symbol, e.g. the first 5.1 group
+		static ChannelRange FromGroup(const SDP::AudioDescription& audio_description, SDPChannelGroup symbol, size_t n = 0)
+		{
+			for (size_t i = 0; i < audio_description.channel_groups.size(); i++)
+			{
+				if (audio_description.channel_groups[i].symbol == symbol && n-- == 0)
+					return FromGroup(audio_description, i);
+			}
+
+			throw std::runtime_error(std::string("ChannelRange: Channel order has no such ") + std::string(SDPEnumToString(symbol)) + " group");
+		}
+
+		// This range with count resolved, checked against the format
+		ChannelRange Resolve(const AudioFormat& format) const
+		{
+			ChannelRange range = { first, count ? count : format.channels - std::min(first, format.channels) };
+			if (range.count == 0 || range.first + range.count > format.channels)
+				throw std::runtime_error("ChannelRange: Channels " + std::to_string(first) + "+" + std::to_string(count)
+					+ " are not in a stream of " + std::to_string(format.channels) + " channels");
+
+			return range;
+		}
+	};
+}
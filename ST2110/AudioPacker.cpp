@@ -0,0 +1,280 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+namespace Cf
+{
+	namespace
+	{
+		// Planar samples staged on the stack before encoding
+		constexpr uint32_t SCRATCH_SAMPLES = 1024;
+
+		// A channel range is encoded one sample frame at a time. Runs shorter
+		// than this never reach the SIMD loops, so they go to the scalar kernel.
+		constexpr uint32_t SIMD_MIN_RUN = 16;
+
+		// FLOAT32 to payload samples: scale to the payload depth, clip, and
+		// round to nearest even. The clip is written as the SSE max/min so
+		// that NaN becomes the lowest sample in every kernel.
+		template<uint32_t Bytes>
+		constexpr float FLOAT_SCALE = Bytes == 3 ? 8388608.0f : 32768.0f;
+
+		template<uint32_t Bytes>
+		uint32_t FloatToSample(float value)
+		{
+			constexpr float low = -FLOAT_SCALE<Bytes>;
+			constexpr float high = FLOAT_SCALE<Bytes> - 1.0f;
+
+			float scaled = value * FLOAT_SCALE<Bytes>;
+			scaled = scaled > low ? scaled : low;
+			scaled = scaled < high ? scaled : high;
+
+			return (uint32_t)(int32_t)std::nearbyint(scaled) << (Bytes == 3 ? 8 : 16);
+		}
+
+
+		/// Scalar kernels
+
+		template<uint32_t Bytes, SampleFormat Format>
+		void EncodeScalar(const void* input, uint32_t samples, uint8_t* payload)
+		{
+			for (uint32_t i = 0; i < samples; i++)
+			{
+				uint32_t value;
+				if constexpr (Format == SampleFormat::FLOAT32)
+					value = FloatToSample<Bytes>(((const float*)input)[i]);
+				else
+					value = ((const uint32_t*)input)[i];
+
+				uint8_t* sample = payload + Bytes * i;
+				sample[0] = (uint8_t)(value >> 24);
+				sample[1] = (uint8_t)(value >> 16);
+				if constexpr (Bytes == 3)
+					sample[2] = (uint8_t)(value >> 8);
+			}
+		}
+
+
+#ifdef ST2110_X86
+		/// The top bytes of each 32 bit lane are written out in reverse,
+		/// packed together.
+
+		constexpr int8_t L24_SHUFFLE[16] = { 3, 2, 1, 7, 6, 5, 11, 10, 9, 15, 14, 13, -1, -1, -1, -1 };
+		constexpr int8_t L16_SHUFFLE[16] = { 3, 2, 7, 6, 11, 10, 15, 14, -1, -1, -1, -1, -1, -1, -1, -1 };
+
+		template<uint32_t Bytes, SampleFormat Format>
+		ST2110_TARGET_SSE41 __m128i LoadSamples(const void* input)
+		{
+			if constexpr (Format == SampleFormat::FLOAT32)
+			{
+				__m128 scaled = _mm_mul_ps(_mm_loadu_ps((const float*)input), _mm_set1_ps(FLOAT_SCALE<Bytes>));
+				scaled = _mm_max_ps(scaled, _mm_set1_ps(-FLOAT_SCALE<Bytes>));
+				scaled = _mm_min_ps(scaled, _mm_set1_ps(FLOAT_SCALE<Bytes> - 1.0f));
+				return _mm_slli_epi32(_mm_cvtps_epi32(scaled), Bytes == 3 ? 8 : 16);
+			}
+			else
+				return _mm_loadu_si128((const __m128i*)input);
+		}
+
+		template<uint32_t Bytes, SampleFormat Format>
+		ST2110_TARGET_AVX2 __m256i LoadSamples8(const void* input)
+		{
+			if constexpr (Format == SampleFormat::FLOAT32)
+			{
+				__m256 scaled = _mm256_mul_ps(_mm256_loadu_ps((const float*)input), _mm256_set1_ps(FLOAT_SCALE<Bytes>));
+				scaled = _mm256_max_ps(scaled, _mm256_set1_ps(-FLOAT_SCALE<Bytes>));
+				scaled = _mm256_min_ps(scaled, _mm256_set1_ps(FLOAT_SCALE<Bytes> - 1.0f));
+				return _mm256_slli_epi32(_mm256_cvtps_epi32(scaled), Bytes == 3 ? 8 : 16);
+			}
+			else
+				return _mm256_loadu_si256((const __m256i*)input);
+		}
+
+		template<uint32_t Bytes, SampleFormat Format>
+		ST2110_TARGET_SSE41 void EncodeSSE41(const void* input, uint32_t samples, uint8_t* payload)
+		{
+			const uint32_t* in = (const uint32_t*)input;
+			uint32_t i = 0;
+
+			if constexpr (Bytes == 3)
+			{
+				const __m128i shuffle = _mm_loadu_si128((const __m128i*)L24_SHUFFLE);
+
+				// 4 samples per iteration, writing 16 bytes for 12; the next
+				// store overwrites the rest
+				for (; i + 6 <= samples; i += 4)
+					_mm_storeu_si128((__m128i*)(payload + 3 * i), _mm_shuffle_epi8(LoadSamples<Bytes, Format>(in + i), shuffle));
+			}
+			else
+			{
+				const __m128i shuffle = _mm_loadu_si128((const __m128i*)L16_SHUFFLE);
+
+				// 8 samples per iteration
+				for (; i + 8 <= samples; i += 8)
+				{
+					__m128i low = _mm_shuffle_epi8(LoadSamples<Bytes, Format>(in + i), shuffle);
+					__m128i high = _mm_shuffle_epi8(LoadSamples<Bytes, Format>(in + i + 4), shuffle);
+					_mm_storeu_si128((__m128i*)(payload + 2 * i), _mm_unpacklo_epi64(low, high));
+				}
+			}
+
+			if (i < samples)
+				EncodeScalar<Bytes, Format>(in + i, samples - i, payload + Bytes * i);
+		}
+
+		template<uint32_t Bytes, SampleFormat Format>
+		ST2110_TARGET_AVX2 void EncodeAVX2(const void* input, uint32_t samples, uint8_t* payload)
+		{
+			const uint32_t* in = (const uint32_t*)input;
+			uint32_t i = 0;
+
+			if constexpr (Bytes == 3)
+			{
+				const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)L24_SHUFFLE));
+
+				// 8 samples per iteration, writing 16 bytes at offsets 0 and 12
+				for (; i + 10 <= samples; i += 8)
+				{
+					__m256i bytes = _mm256_shuffle_epi8(LoadSamples8<Bytes, Format>(in + i), shuffle);
+					_mm_storeu_si128((__m128i*)(payload + 3 * i), _mm256_castsi256_si128(bytes));
+					_mm_storeu_si128((__m128i*)(payload + 3 * i + 12), _mm256_extracti128_si256(bytes, 1));
+				}
+			}
+			else
+			{
+				const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)L16_SHUFFLE));
+
+				// 16 samples per iteration. Each lane packs 4 samples into its
+				// low 8 bytes; the lanes are then put back in sample order.
+				for (; i + 16 <= samples; i += 16)
+				{
+					__m256i low = _mm256_shuffle_epi8(LoadSamples8<Bytes, Format>(in + i), shuffle);
+					__m256i high = _mm256_shuffle_epi8(LoadSamples8<Bytes, Format>(in + i + 8), shuffle);
+					__m256i bytes = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(low, high), _MM_SHUFFLE(3, 1, 2, 0));
+					_mm256_storeu_si256((__m256i*)(payload + 2 * i), bytes);
+				}
+			}
+
+			// The SSE4.1 tail must not run with dirty upper AVX state
+			_mm256_zeroupper();
+
+			if (i < samples)
+				EncodeSSE41<Bytes, Format>(in + i, samples - i, payload + Bytes * i);
+		}
+#endif
+
+
+		template<uint32_t Bytes, SampleFormat Format>
+		AudioEncodeKernel SelectKernel(SimdLevel* simd_level_ptr)
+		{
+#ifdef ST2110_X86
+			if (*simd_level_ptr == SimdLevel::AVX2)
+				return EncodeAVX2<Bytes, Format>;
+
+			if (*simd_level_ptr == SimdLevel::SSE41)
+				return EncodeSSE41<Bytes, Format>;
+#endif
+
+			*simd_level_ptr = SimdLevel::SCALAR;
+			return EncodeScalar<Bytes, Format>;
+		}
+	}
+
+
+	AudioPacker::AudioPacker(const AudioFormat& format, SampleFormat sample_format, SampleLayout sample_layout, ChannelRange channel_range, SimdLevel max_simd_level)
+		: m_format(format), m_channel_range(channel_range.Resolve(format)), m_sample_format(sample_format), m_sample_layout(sample_layout)
+	{
+		if (m_sample_layout == SampleLayout::PLANAR && m_channel_range.count > SCRATCH_SAMPLES)
+			throw std::runtime_error("AudioPacker: Too many channels for planar input");
+
+		m_simd_level = std::min(DetectSimdLevel(), max_simd_level);
+		if (m_channel_range.count < m_format.channels && m_channel_range.count < SIMD_MIN_RUN)
+			m_simd_level = SimdLevel::SCALAR;
+
+		bool l24 = m_format.bytes_per_sample == 3;
+		if (sample_format == SampleFormat::FLOAT32)
+			m_kernel = l24 ? SelectKernel<3, SampleFormat::FLOAT32>(&m_simd_level) : SelectKernel<2, SampleFormat::FLOAT32>(&m_simd_level);
+		else
+			m_kernel = l24 ? SelectKernel<3, SampleFormat::INT32>(&m_simd_level) : SelectKernel<2, SampleFormat::INT32>(&m_simd_level);
+
+		PLOG_INFO << "AudioPacker: " << SampleLayoutName(sample_layout) << " " << SampleFormatName(sample_format) << " to " << (l24 ? "L24" : "L16")
+			<< " channels " << m_channel_range.first << "-" << m_channel_range.first + m_channel_range.count - 1 << " of " << m_format.channels
+			<< " using " << SimdLevelName(m_simd_level) << " kernel";
+	}
+
+	AudioPacker::AudioPacker(const SDP::AudioDescription& audio_description, SampleFormat sample_format, SampleLayout sample_layout, ChannelRange channel_range)
+		: AudioPacker(AudioFormat(audio_description), sample_format, sample_layout, channel_range)
+	{
+	}
+
+	uint32_t AudioPacker::Pack(const AudioBuffer& input, uint32_t offset, uint32_t samples, uint8_t* payload) const
+	{
+		uint32_t channels = m_channel_range.count;
+		bool all_channels = channels == m_format.channels;
+
+		uint8_t* first = payload + m_channel_range.first * m_format.bytes_per_sample;
+
+		if (m_sample_layout == SampleLayout::INTERLEAVED)
+		{
+			const uint32_t* in = (const uint32_t*)input.data + (size_t)offset * channels;
+
+			if (all_channels)
+				m_kernel(in, samples * channels, payload);
+			else
+			{
+				for (uint32_t i = 0; i < samples; i++)
+					m_kernel(in + i * channels, channels, first + i * m_format.frame_octets);
+			}
+
+			return samples * m_format.frame_octets;
+		}
+
+		// Planar: gather blocks of sample frames interleaved, then encode
+		uint32_t scratch[SCRATCH_SAMPLES];
+		uint32_t block = SCRATCH_SAMPLES / channels;
+
+		for (uint32_t i = 0; i < samples; i += block)
+		{
+			uint32_t count = std::min(block, samples - i);
+
+			for (uint32_t c = 0; c < channels; c++)
+			{
+				const uint32_t* plane = (const uint32_t*)input.data + (size_t)c * input.channel_stride + offset + i;
+				for (uint32_t j = 0; j < count; j++)
+					scratch[j * channels + c] = plane[j];
+			}
+
+			if (all_channels)
+				m_kernel(scratch, count * channels, payload + i * m_format.frame_octets);
+			else
+			{
+				for (uint32_t j = 0; j < count; j++)
+					m_kernel(scratch + j * channels, channels, first + (i + j) * m_format.frame_octets);
+			}
+		}
+
+		return samples * m_format.frame_octets;
+	}
+}
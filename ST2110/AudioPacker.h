@@ -0,0 +1,69 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	// Encodes `samples` consecutive 4 byte INT32 or FLOAT32 samples into big
+	// endian payload samples
+	using AudioEncodeKernel = void (*)(const void* input, uint32_t samples, uint8_t* payload);
+
+
+	/// <summary>
+	/// AudioPacker: Converts interleaved or planar INT32 or FLOAT32 audio
+	///				 into L16/L24 RTP payloads (ST 2110-30, AES67), the
+	///				 reverse of AudioUnpacker. INT32 samples are truncated to
+	///				 the payload depth; FLOAT32 samples are rounded and
+	///				 clipped to it. Only the channel range is written, so
+	///				 several packers can fill one payload.
+	/// </summary>
+	class AudioPacker
+	{
+	public:
+		AudioPacker(const AudioFormat& format, SampleFormat sample_format, SampleLayout sample_layout, ChannelRange channel_range = {}, SimdLevel max_simd_level = SimdLevel::AVX2);
+		AudioPacker(const SDP::AudioDescription& audio_description, SampleFormat sample_format, SampleLayout sample_layout, ChannelRange channel_range = {});
+
+		/// <summary>
+		/// Pack: Encodes `samples` sample frames of the input, starting at
+		///		  sample `offset` of each selected channel, into a payload
+		///		  of samples * frame_octets octets. Returns the octets.
+		/// </summary>
+		uint32_t Pack(const AudioBuffer& input, uint32_t offset, uint32_t samples, uint8_t* payload) const;
+
+		const AudioFormat& GetFormat() const { return m_format; }
+		ChannelRange GetChannelRange() const { return m_channel_range; }
+		SampleFormat GetSampleFormat() const { return m_sample_format; }
+		SampleLayout GetSampleLayout() const { return m_sample_layout; }
+		SimdLevel GetSimdLevel() const { return m_simd_level; }
+
+	private:
+		AudioFormat m_format;
+		ChannelRange m_channel_range;
+		AudioEncodeKernel m_kernel = nullptr;
+		SampleFormat m_sample_format = SampleFormat::INT32;
+		SampleLayout m_sample_layout = SampleLayout::INTERLEAVED;
+		SimdLevel m_simd_level = SimdLevel::SCALAR;
+	};
+}
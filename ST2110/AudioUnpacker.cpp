@@ -0,0 +1,261 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+namespace Cf
+{
+	namespace
+	{
+		// Decoded samples staged on the stack before planar output
+		constexpr uint32_t SCRATCH_SAMPLES = 1024;
+
+		// A channel range is decoded one sample frame at a time. Runs shorter
+		// than this never reach the SIMD loops, so they go to the scalar kernel.
+		constexpr uint32_t SIMD_MIN_RUN = 16;
+
+		constexpr float INT32_TO_FLOAT = 1.0f / 2147483648.0f;
+
+
+		/// Scalar kernels
+
+		template<uint32_t Bytes, SampleFormat Format>
+		void DecodeScalar(const uint8_t* payload, uint32_t samples, void* output)
+		{
+			for (uint32_t i = 0; i < samples; i++)
+			{
+				const uint8_t* sample = payload + Bytes * i;
+
+				uint32_t value = ((uint32_t)sample[0] << 24) | ((uint32_t)sample[1] << 16);
+				if constexpr (Bytes == 3)
+					value |= (uint32_t)sample[2] << 8;
+
+				if constexpr (Format == SampleFormat::FLOAT32)
+					((float*)output)[i] = (float)(int32_t)value * INT32_TO_FLOAT;
+				else
+					((int32_t*)output)[i] = (int32_t)value;
+			}
+		}
+
+
+#ifdef ST2110_X86
+		/// Each 32 bit lane takes the big endian sample bytes in reverse,
+		/// into its top bytes, with zeros below.
+
+		constexpr int8_t L24_SHUFFLE[16] = { -1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9 };
+		constexpr int8_t L16_LOW_SHUFFLE[16] = { -1, -1, 1, 0, -1, -1, 3, 2, -1, -1, 5, 4, -1, -1, 7, 6 };
+		constexpr int8_t L16_HIGH_SHUFFLE[16] = { -1, -1, 9, 8, -1, -1, 11, 10, -1, -1, 13, 12, -1, -1, 15, 14 };
+
+		// After _mm256_cvtepu16_epi32 each lane holds its sample in the low
+		// two bytes
+		constexpr int8_t L16_WIDE_SHUFFLE[16] = { -1, -1, 1, 0, -1, -1, 5, 4, -1, -1, 9, 8, -1, -1, 13, 12 };
+
+		template<SampleFormat Format>
+		ST2110_TARGET_SSE41 void StoreSamples(void* output, __m128i samples)
+		{
+			if constexpr (Format == SampleFormat::FLOAT32)
+				_mm_storeu_ps((float*)output, _mm_mul_ps(_mm_cvtepi32_ps(samples), _mm_set1_ps(INT32_TO_FLOAT)));
+			else
+				_mm_storeu_si128((__m128i*)output, samples);
+		}
+
+		template<SampleFormat Format>
+		ST2110_TARGET_AVX2 void StoreSamples(void* output, __m256i samples)
+		{
+			if constexpr (Format == SampleFormat::FLOAT32)
+				_mm256_storeu_ps((float*)output, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), _mm256_set1_ps(INT32_TO_FLOAT)));
+			else
+				_mm256_storeu_si256((__m256i*)output, samples);
+		}
+
+		template<uint32_t Bytes, SampleFormat Format>
+		ST2110_TARGET_SSE41 void DecodeSSE41(const uint8_t* payload, uint32_t samples, void* output)
+		{
+			int32_t* out = (int32_t*)output;
+			uint32_t i = 0;
+
+			if constexpr (Bytes == 3)
+			{
+				const __m128i shuffle = _mm_loadu_si128((const __m128i*)L24_SHUFFLE);
+
+				// 4 samples per iteration, reading 16 bytes for 12
+				for (; i + 6 <= samples; i += 4)
+					StoreSamples<Format>(out + i, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(payload + 3 * i)), shuffle));
+			}
+			else
+			{
+				const __m128i low = _mm_loadu_si128((const __m128i*)L16_LOW_SHUFFLE);
+				const __m128i high = _mm_loadu_si128((const __m128i*)L16_HIGH_SHUFFLE);
+
+				// 8 samples per iteration
+				for (; i + 8 <= samples; i += 8)
+				{
+					__m128i bytes = _mm_loadu_si128((const __m128i*)(payload + 2 * i));
+					StoreSamples<Format>(out + i, _mm_shuffle_epi8(bytes, low));
+					StoreSamples<Format>(out + i + 4, _mm_shuffle_epi8(bytes, high));
+				}
+			}
+
+			if (i < samples)
+				DecodeScalar<Bytes, Format>(payload + Bytes * i, samples - i, out + i);
+		}
+
+		template<uint32_t Bytes, SampleFormat Format>
+		ST2110_TARGET_AVX2 void DecodeAVX2(const uint8_t* payload, uint32_t samples, void* output)
+		{
+			int32_t* out = (int32_t*)output;
+			uint32_t i = 0;
+
+			if constexpr (Bytes == 3)
+			{
+				const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)L24_SHUFFLE));
+
+				// 8 samples per iteration, reading 16 bytes at offsets 0 and 12
+				for (; i + 10 <= samples; i += 8)
+				{
+					const uint8_t* source = payload + 3 * i;
+					__m256i bytes = _mm256_inserti128_si256(
+						_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)source)),
+						_mm_loadu_si128((const __m128i*)(source + 12)), 1);
+
+					StoreSamples<Format>(out + i, _mm256_shuffle_epi8(bytes, shuffle));
+				}
+			}
+			else
+			{
+				const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)L16_WIDE_SHUFFLE));
+
+				// 8 samples per iteration
+				for (; i + 8 <= samples; i += 8)
+				{
+					__m256i words = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(payload + 2 * i)));
+					StoreSamples<Format>(out + i, _mm256_shuffle_epi8(words, shuffle));
+				}
+			}
+
+			// The SSE4.1 tail must not run with dirty upper AVX state
+			_mm256_zeroupper();
+
+			if (i < samples)
+				DecodeSSE41<Bytes, Format>(payload + Bytes * i, samples - i, out + i);
+		}
+#endif
+
+
+		template<uint32_t Bytes, SampleFormat Format>
+		AudioDecodeKernel SelectKernel(SimdLevel* simd_level_ptr)
+		{
+#ifdef ST2110_X86
+			if (*simd_level_ptr == SimdLevel::AVX2)
+				return DecodeAVX2<Bytes, Format>;
+
+			if (*simd_level_ptr == SimdLevel::SSE41)
+				return DecodeSSE41<Bytes, Format>;
+#endif
+
+			*simd_level_ptr = SimdLevel::SCALAR;
+			return DecodeScalar<Bytes, Format>;
+		}
+	}
+
+
+	AudioUnpacker::AudioUnpacker(const AudioFormat& format, SampleFormat sample_format, SampleLayout sample_layout, ChannelRange channel_range, SimdLevel max_simd_level)
+		: m_format(format), m_channel_range(channel_range.Resolve(format)), m_sample_format(sample_format), m_sample_layout(sample_layout)
+	{
+		if (m_sample_layout == SampleLayout::PLANAR && m_channel_range.count > SCRATCH_SAMPLES)
+			throw std::runtime_error("AudioUnpacker: Too many channels for planar output");
+
+		m_simd_level = std::min(DetectSimdLevel(), max_simd_level);
+		if (m_channel_range.count < m_format.channels && m_channel_range.count < SIMD_MIN_RUN)
+			m_simd_level = SimdLevel::SCALAR;
+
+		bool l24 = m_format.bytes_per_sample == 3;
+		if (sample_format == SampleFormat::FLOAT32)
+			m_kernel = l24 ? SelectKernel<3, SampleFormat::FLOAT32>(&m_simd_level) : SelectKernel<2, SampleFormat::FLOAT32>(&m_simd_level);
+		else
+			m_kernel = l24 ? SelectKernel<3, SampleFormat::INT32>(&m_simd_level) : SelectKernel<2, SampleFormat::INT32>(&m_simd_level);
+
+		PLOG_INFO << "AudioUnpacker: " << (l24 ? "L24" : "L16") << " channels " << m_channel_range.first << "-" << m_channel_range.first + m_channel_range.count - 1
+			<< " of " << m_format.channels << " to " << SampleLayoutName(sample_layout) << " " << SampleFormatName(sample_format)
+			<< " using " << SimdLevelName(m_simd_level) << " kernel";
+	}
+
+	AudioUnpacker::AudioUnpacker(const SDP::AudioDescription& audio_description, SampleFormat sample_format, SampleLayout sample_layout, ChannelRange channel_range)
+		: AudioUnpacker(AudioFormat(audio_description), sample_format, sample_layout, channel_range)
+	{
+	}
+
+	uint32_t AudioUnpacker::Unpack(const uint8_t* payload, uint32_t payload_octets, const AudioBuffer& output, uint32_t offset) const
+	{
+		uint32_t samples = payload_octets / m_format.frame_octets;
+		uint32_t channels = m_channel_range.count;
+		bool all_channels = channels == m_format.channels;
+
+		const uint8_t* first = payload + m_channel_range.first * m_format.bytes_per_sample;
+
+		if (m_sample_layout == SampleLayout::INTERLEAVED)
+		{
+			uint32_t* out = (uint32_t*)output.data + (size_t)offset * channels;
+
+			// All channels are one run of samples; a range is one run per
+			// sample frame
+			if (all_channels)
+				m_kernel(payload, samples * channels, out);
+			else
+			{
+				for (uint32_t i = 0; i < samples; i++)
+					m_kernel(first + i * m_format.frame_octets, channels, out + i * channels);
+			}
+
+			return samples;
+		}
+
+		// Planar: decode blocks of sample frames interleaved, then scatter
+		// each channel to its plane
+		uint32_t scratch[SCRATCH_SAMPLES];
+		uint32_t block = SCRATCH_SAMPLES / channels;
+
+		for (uint32_t i = 0; i < samples; i += block)
+		{
+			uint32_t count = std::min(block, samples - i);
+
+			if (all_channels)
+				m_kernel(payload + i * m_format.frame_octets, count * channels, scratch);
+			else
+			{
+				for (uint32_t j = 0; j < count; j++)
+					m_kernel(first + (i + j) * m_format.frame_octets, channels, scratch + j * channels);
+			}
+
+			for (uint32_t c = 0; c < channels; c++)
+			{
+				uint32_t* plane = (uint32_t*)output.data + (size_t)c * output.channel_stride + offset + i;
+				for (uint32_t j = 0; j < count; j++)
+					plane[j] = scratch[j * channels + c];
+			}
+		}
+
+		return samples;
+	}
+}
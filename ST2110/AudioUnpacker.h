@@ -0,0 +1,68 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	// Decodes `samples` consecutive big endian payload samples into 4 byte
+	// INT32 or FLOAT32 samples
+	using AudioDecodeKernel = void (*)(const uint8_t* payload, uint32_t samples, void* output);
+
+
+	/// <summary>
+	/// AudioUnpacker: Converts L16/L24 RTP payloads (ST 2110-30, AES67) into
+	///				   interleaved or planar INT32 or FLOAT32 audio, for a
+	///				   range of the stream's channels. The byte swapping
+	///				   kernel is chosen once, at activation, for the encoding,
+	///				   sample format and SIMD level.
+	/// </summary>
+	class AudioUnpacker
+	{
+	public:
+		AudioUnpacker(const AudioFormat& format, SampleFormat sample_format, SampleLayout sample_layout, ChannelRange channel_range = {}, SimdLevel max_simd_level = SimdLevel::AVX2);
+		AudioUnpacker(const SDP::AudioDescription& audio_description, SampleFormat sample_format, SampleLayout sample_layout, ChannelRange channel_range = {});
+
+		/// <summary>
+		/// Unpack: Decodes the whole sample frames of a payload into the
+		///			output, starting at sample `offset` of each selected
+		///			channel. Returns the sample frames decoded.
+		/// </summary>
+		uint32_t Unpack(const uint8_t* payload, uint32_t payload_octets, const AudioBuffer& output, uint32_t offset) const;
+
+		const AudioFormat& GetFormat() const { return m_format; }
+		ChannelRange GetChannelRange() const { return m_channel_range; }
+		SampleFormat GetSampleFormat() const { return m_sample_format; }
+		SampleLayout GetSampleLayout() const { return m_sample_layout; }
+		SimdLevel GetSimdLevel() const { return m_simd_level; }
+
+	private:
+		AudioFormat m_format;
+		ChannelRange m_channel_range;
+		AudioDecodeKernel m_kernel = nullptr;
+		SampleFormat m_sample_format = SampleFormat::INT32;
+		SampleLayout m_sample_layout = SampleLayout::INTERLEAVED;
+		SimdLevel m_simd_level = SimdLevel::SCALAR;
+	};
+}
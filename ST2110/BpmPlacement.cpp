@@ -0,0 +1,115 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+namespace Cf
+{
+	BpmPlacement::BpmPlacement(const VideoFormat& format, const FrameLayout& layout)
+		: m_format(format), m_packet_data_octets(StreamGeometryDetail::BPM_PAYLOAD_OCTETS)
+	{
+		if (!IsSupported(format, layout.pixel_format))
+			throw std::runtime_error("BpmPlacement: Only BPM streams into PGROUP frames can be placed directly");
+
+		VideoStreamGeometry geometry(format);
+		uint32_t line_octets = geometry.line_octets;
+		uint32_t field_octets = geometry.field_octets;
+
+		// Field rows alternate in an interlaced frame
+		uint32_t row_stride = format.IsInterlaced() ? 2 * layout.strides[0] : layout.strides[0];
+		m_field_offset = format.IsInterlaced() ? layout.strides[0] : 0;
+
+		m_packets.reserve(geometry.packets_per_field);
+
+		// Same packet boundaries as PgroupPacker::BuildPacketPlan()
+		for (uint32_t position = 0; position < field_octets; )
+		{
+			Packet packet = { (uint32_t)m_copies.size(), 0, (uint32_t)m_rows.size(), 0, 0 };
+
+			uint32_t remaining = std::min(m_packet_data_octets, field_octets - position);
+			while (remaining > 0)
+			{
+				uint32_t row = position / line_octets;
+				uint32_t column = position % line_octets;
+				uint32_t length = std::min(remaining, line_octets - column);
+				uint32_t destination = row * row_stride + column;
+
+				// Rows with no padding between them take one copy
+				if (packet.copy_count > 0 && m_copies.back().destination + m_copies.back().octets == destination)
+				{
+					m_copies.back().octets += length;
+				}
+				else
+				{
+					m_copies.push_back({ destination, length });
+					packet.copy_count++;
+				}
+
+				m_rows.push_back({ row, length });
+				packet.row_count++;
+				packet.data_octets += length;
+
+				position += length;
+				remaining -= length;
+			}
+
+			m_packets.push_back(packet);
+		}
+
+		PLOG_INFO << "BpmPlacement: " << m_packets.size() << " packets per field in " << m_copies.size() << " copies";
+	}
+
+	const BpmPlacement::Packet* BpmPlacement::Find(const uint8_t* payload, uint32_t octets, uint32_t* field) const
+	{
+		if (octets < StreamGeometryDetail::EXTENDED_SEQUENCE_OCTETS + SampleRowData::OCTETS)
+			return nullptr;
+
+		const uint8_t* headers = payload + StreamGeometryDetail::EXTENDED_SEQUENCE_OCTETS;
+		SampleRowData srd;
+		srd.Read(headers);
+
+		if (srd.row >= m_format.field_height || srd.row % m_format.pgroup_lines != 0 || (srd.second_field && !m_format.IsInterlaced())
+			|| srd.offset % m_format.pgroup_width != 0 || srd.offset / m_format.pgroup_width >= m_format.pgroups_per_line)
+			return nullptr;
+
+		uint32_t position = srd.row / m_format.pgroup_lines * m_format.line_octets + m_format.GetPixelOffset(srd.offset);
+		if (position % m_packet_data_octets != 0 || position / m_packet_data_octets >= m_packets.size())
+			return nullptr;
+
+		const Packet& packet = m_packets[position / m_packet_data_octets];
+		if (octets != StreamGeometryDetail::EXTENDED_SEQUENCE_OCTETS + SampleRowData::OCTETS * packet.row_count + packet.data_octets)
+			return nullptr;
+
+		// Every SRD header but the last has the continuation bit
+		for (uint32_t i = 0; i < packet.row_count; i++)
+		{
+			bool continuation = (headers[SampleRowData::OCTETS * i + 4] & 0x80) != 0;
+			if (continuation != (i + 1 < packet.row_count))
+				return nullptr;
+		}
+
+		*field = srd.second_field ? 1 : 0;
+		return &packet;
+	}
+}
@@ -0,0 +1,116 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	/// <summary>
+	/// BpmPlacement: Where the data of each packet of a BPM stream goes in a
+	///				  PGROUP frame, worked out once at activation. BPM
+	///				  packets carry fixed 1260 octet runs of the field
+	///				  payload, so the row and offset of a packet's first SRD
+	///				  name the packet, and its entry holds the copies that
+	///				  place its data: one for a progressive frame, whose
+	///				  rows are back to back like the payload, one per row
+	///				  for interlaced frames, whose field rows alternate.
+	///				  Find() matches a packet against its entry without
+	///				  walking the SRDs; packets that do not match the plan
+	///				  go through the PgroupUnpacker instead.
+	/// </summary>
+	class BpmPlacement
+	{
+	public:
+		// One contiguous run of packet data
+		struct Copy
+		{
+			uint32_t destination;	// frame offset, in the first field
+			uint32_t octets;
+		};
+
+		// Octets a packet adds to one pgroup row of its field
+		struct RowOctets
+		{
+			uint32_t row;
+			uint32_t octets;
+		};
+
+		struct Packet
+		{
+			uint32_t first_copy;
+			uint32_t copy_count;
+			uint32_t first_row;
+			uint32_t row_count;		// also the SRD count
+			uint32_t data_octets;
+		};
+
+		BpmPlacement(const VideoFormat& format, const FrameLayout& layout);
+
+		// Whether packets of the format can be placed directly: BPM into
+		// PGROUP frames
+		static bool IsSupported(const VideoFormat& format, PixelFormat pixel_format)
+		{
+			return format.GetPackingMode() == SDPPackingMode::BPM && pixel_format == PixelFormat::PGROUP;
+		}
+
+		/// <summary>
+		/// Find: The plan of the packet with this 2110-20 payload, or null
+		///		  if its first SRD does not start a packet of the plan or
+		///		  its SRD count or size differ. `field` is set from the
+		///		  first SRD.
+		/// </summary>
+		const Packet* Find(const uint8_t* payload, uint32_t octets, uint32_t* field) const;
+
+		/// <summary>
+		/// Place: Copies the data of a packet found by Find() into a frame
+		///		   buffer of the layout.
+		/// </summary>
+		void Place(const Packet& packet, const uint8_t* payload, uint32_t field, uint8_t* frame) const
+		{
+			const uint8_t* data = payload + StreamGeometryDetail::EXTENDED_SEQUENCE_OCTETS + SampleRowData::OCTETS * packet.row_count;
+			uint8_t* field_frame = frame + (size_t)field * m_field_offset;
+
+			for (uint32_t i = packet.first_copy; i < packet.first_copy + packet.copy_count; i++)
+			{
+				std::memcpy(field_frame + m_copies[i].destination, data, m_copies[i].octets);
+				data += m_copies[i].octets;
+			}
+		}
+
+		const RowOctets* GetRows(const Packet& packet) const { return m_rows.data() + packet.first_row; }
+		uint32_t GetPacketCount() const { return (uint32_t)m_packets.size(); }
+
+	private:
+		VideoFormat m_format;
+		uint32_t m_packet_data_octets;
+
+		// Frame offset of the second field, the first row of which sits
+		// under the first row of the first field
+		uint32_t m_field_offset = 0;
+
+		std::vector<Packet> m_packets;
+		std::vector<Copy> m_copies;
+		std::vector<RowOctets> m_rows;
+	};
+}
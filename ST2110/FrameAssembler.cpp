@@ -0,0 +1,309 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+namespace Cf
+{
+	namespace
+	{
+		using namespace RuntimeDetail;
+
+		// RTP timestamps wrap; a is newer than b if it is less than half
+		// the range ahead
+		bool IsNewer(uint32_t a, uint32_t b)
+		{
+			return (int32_t)(a - b) > 0;
+		}
+	}
+
+
+	FrameAssembler::FrameAssembler(const SDP::VideoDescription& video_description, PixelFormat pixel_format, FrameHandler handler,
+		const FrameAssemblerSettings& settings)
+		: m_format(video_description), m_layout(m_format, pixel_format), m_unpacker(m_format, pixel_format, settings.max_simd_level),
+		  m_pool(m_format, m_layout, settings.frame_count), m_handler(std::move(handler)), m_max_open_frames(settings.max_open_frames)
+	{
+		if (m_max_open_frames == 0 || m_max_open_frames > settings.frame_count)
+			throw std::runtime_error("FrameAssembler: Open frames must be between one and the frame count");
+
+		if (!m_handler)
+			throw std::runtime_error("FrameAssembler: Frame handler must not be empty");
+
+		if (BpmPlacement::IsSupported(m_format, pixel_format))
+			m_placement = std::make_unique<BpmPlacement>(m_format, m_layout);
+
+		m_open_frames.reserve(m_max_open_frames);
+
+		PLOG_INFO << "FrameAssembler: " << settings.frame_count << " frames of " << m_layout.size << " octets, "
+			<< m_max_open_frames << " open at once";
+	}
+
+	void FrameAssembler::Push(const uint8_t* packet, uint32_t octets)
+	{
+		RelaxedAdd(m_statistics.packets, 1);
+
+		RtpHeader header;
+		uint32_t payload_offset = header.Read(packet, octets);
+		if (payload_offset == 0 || payload_offset + StreamGeometryDetail::EXTENDED_SEQUENCE_OCTETS + SampleRowData::OCTETS > octets)
+		{
+			RelaxedAdd(m_statistics.packets_invalid, 1);
+			return;
+		}
+
+		const uint8_t* payload = packet + payload_offset;
+		uint32_t payload_octets = octets - payload_offset;
+		if (!CountSequence(((uint32_t)RtpDetail::ReadBE16(payload) << 16) | header.sequence_number))
+			return;
+
+		size_t index = FindFrame(header.timestamp);
+		if (index == m_open_frames.size())
+		{
+			// Frames only start in timestamp order; anything older than
+			// the newest frame seen is too late to place
+			if (m_has_newest_timestamp && !IsNewer(header.timestamp, m_newest_timestamp))
+			{
+				RelaxedAdd(m_statistics.packets_late, 1);
+				return;
+			}
+
+			m_newest_timestamp = header.timestamp;
+			m_has_newest_timestamp = true;
+
+			index = OpenFrame(header.timestamp);
+			if (index == m_open_frames.size())
+				return;
+		}
+
+		Frame& frame = *m_open_frames[index];
+		if (!Place(frame, payload, payload_octets))
+			RelaxedAdd(m_statistics.packets_invalid, 1);
+		frame.m_packets++;
+
+		// The marker ends each field; the frame's last packet is the one
+		// ending the second field of an interlaced frame
+		if (header.marker)
+		{
+			SampleRowData srd;
+			srd.Read(payload + StreamGeometryDetail::EXTENDED_SEQUENCE_OCTETS);
+			frame.m_marker = frame.m_marker || !m_format.IsInterlaced() || srd.second_field;
+		}
+
+		if (frame.IsComplete())
+			Emit(index);
+	}
+
+	void FrameAssembler::Flush()
+	{
+		if (!m_open_frames.empty())
+			Emit(m_open_frames.size() - 1);
+	}
+
+	size_t FrameAssembler::FindFrame(uint32_t timestamp) const
+	{
+		size_t index = 0;
+		while (index < m_open_frames.size() && m_open_frames[index]->GetTimestamp() != timestamp)
+			index++;
+		return index;
+	}
+
+	size_t FrameAssembler::OpenFrame(uint32_t timestamp)
+	{
+		// A frame whose last marker arrived gets nothing more once a newer
+		// frame starts; hand it out with everything older
+		for (size_t i = m_open_frames.size(); i-- > 0;)
+		{
+			if (m_open_frames[i]->m_marker)
+			{
+				Emit(i);
+				break;
+			}
+		}
+
+		if (m_open_frames.size() >= m_max_open_frames)
+			Emit(m_open_frames.size() - m_max_open_frames);
+
+		// With the handler holding the other buffers, an open frame that
+		// never finishes would stall the stream; hand it out instead
+		FrameHandle frame = m_pool.Acquire(timestamp);
+		if (!frame && !m_open_frames.empty())
+		{
+			Emit(0);
+			frame = m_pool.Acquire(timestamp);
+		}
+
+		if (!frame)
+		{
+			// The handler holds every buffer. Drop this frame rather than
+			// wait, its remaining packets count as late.
+			RelaxedAdd(m_statistics.frames_dropped, 1);
+			RelaxedAdd(m_statistics.packets_late, 1);
+			return m_open_frames.size();
+		}
+
+		m_open_frames.push_back(std::move(frame));
+		return m_open_frames.size() - 1;
+	}
+
+	bool FrameAssembler::Place(Frame& frame, const uint8_t* payload, uint32_t octets)
+	{
+		// A packet where the BPM plan expects it is one lookup and a copy
+		uint32_t placed_field = 0;
+		const BpmPlacement::Packet* placed = m_placement ? m_placement->Find(payload, octets, &placed_field) : nullptr;
+		if (placed != nullptr)
+		{
+			m_placement->Place(*placed, payload, placed_field, frame.m_planes.data[0]);
+
+			const BpmPlacement::RowOctets* rows = m_placement->GetRows(*placed);
+			for (uint32_t i = 0; i < placed->row_count; i++)
+				frame.AddRowOctets(placed_field, rows[i].row, rows[i].octets);
+
+			RelaxedAdd(m_statistics.packets_placed, 1);
+			return true;
+		}
+
+		const uint8_t* end = payload + octets;
+		const uint8_t* headers = payload + StreamGeometryDetail::EXTENDED_SEQUENCE_OCTETS;
+
+		// All SRD headers come first, then their data in the same order
+		SampleRowData srd;
+		const uint8_t* data = headers;
+		do
+		{
+			if (data + SampleRowData::OCTETS > end)
+				return false;
+			srd.Read(data);
+			data += SampleRowData::OCTETS;
+		} while (srd.continuation);
+
+		const uint8_t* headers_end = data;
+		bool interlaced = m_format.IsInterlaced();
+		for (const uint8_t* header = headers; header < headers_end; header += SampleRowData::OCTETS)
+		{
+			srd.Read(header);
+
+			uint32_t field = srd.second_field ? 1 : 0;
+			if (data + srd.length > end || (field != 0 && !interlaced))
+				return false;
+
+			const FramePlanes& planes = interlaced ? frame.m_planes.GetField(field) : frame.m_planes;
+			if (!m_unpacker.Unpack(data, srd.length, srd.row, srd.offset, planes, m_format.field_height))
+				return false;
+
+			// CountSequence() dropped duplicates within SEQUENCE_WINDOW;
+			// older ones count twice. ST 2022-7 merging, where duplicates
+			// arise, happens before the assembler.
+			frame.AddRowOctets(field, srd.row / m_format.pgroup_lines, srd.length / m_format.pgroup_octets * m_format.pgroup_octets);
+			data += srd.length;
+		}
+
+		return true;
+	}
+
+	bool FrameAssembler::CountSequence(uint32_t sequence)
+	{
+		using FrameAssemblerDetail::SEQUENCE_WINDOW;
+
+		if (!m_has_sequence)
+		{
+			m_sequences_seen.fill(0);
+			SetSequenceSeen(sequence, true);
+			m_next_sequence = sequence + 1;
+			m_tracked_sequences = 1;
+			m_has_sequence = true;
+			return true;
+		}
+
+		int32_t gap = (int32_t)(sequence - m_next_sequence);
+		if (gap >= 0)
+		{
+			RelaxedAdd(m_statistics.packets_lost, (uint32_t)gap);
+
+			// Skipped sequence numbers enter the window unseen
+			if ((uint32_t)gap >= SEQUENCE_WINDOW)
+			{
+				m_sequences_seen.fill(0);
+			}
+			else
+			{
+				for (uint32_t skipped = m_next_sequence; skipped != sequence; skipped++)
+					SetSequenceSeen(skipped, false);
+			}
+
+			SetSequenceSeen(sequence, true);
+			m_next_sequence = sequence + 1;
+			m_tracked_sequences = (uint32_t)std::min<uint64_t>((uint64_t)m_tracked_sequences + (uint32_t)gap + 1, SEQUENCE_WINDOW);
+			return true;
+		}
+
+		// 1 for the newest sequence number
+		uint32_t age = m_next_sequence - sequence;
+		if (age > m_tracked_sequences)
+		{
+			// Too late to tell, or from before the first packet
+			RelaxedAdd(m_statistics.packets_reordered, 1);
+			return true;
+		}
+
+		if (IsSequenceSeen(sequence))
+		{
+			RelaxedAdd(m_statistics.packets_duplicate, 1);
+			return false;
+		}
+
+		// Counted as lost when the sequence skipped it
+		SetSequenceSeen(sequence, true);
+		RelaxedAdd(m_statistics.packets_reordered, 1);
+		RelaxedSubtract(m_statistics.packets_lost, 1);
+		return true;
+	}
+
+	bool FrameAssembler::IsSequenceSeen(uint32_t sequence) const
+	{
+		uint32_t bit = sequence % FrameAssemblerDetail::SEQUENCE_WINDOW;
+		return (m_sequences_seen[bit / 64] >> (bit % 64)) & 1;
+	}
+
+	void FrameAssembler::SetSequenceSeen(uint32_t sequence, bool seen)
+	{
+		uint32_t bit = sequence % FrameAssemblerDetail::SEQUENCE_WINDOW;
+		if (seen)
+			m_sequences_seen[bit / 64] |= 1ull << (bit % 64);
+		else
+			m_sequences_seen[bit / 64] &= ~(1ull << (bit % 64));
+	}
+
+	void FrameAssembler::Emit(size_t index)
+	{
+		for (size_t i = 0; i <= index; i++)
+		{
+			// Taken off the open list first, so a throwing handler leaves
+			// the assembler consistent
+			FrameHandle frame = std::move(m_open_frames.front());
+			m_open_frames.erase(m_open_frames.begin());
+
+			RelaxedAdd(frame->IsComplete() ? m_statistics.frames_complete : m_statistics.frames_incomplete, 1);
+			m_handler(std::move(frame));
+		}
+	}
+}
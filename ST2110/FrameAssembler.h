@@ -0,0 +1,183 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	namespace FrameAssemblerDetail
+	{
+		// Sequence numbers behind the newest one that are told apart as
+		// late or duplicate
+		constexpr uint32_t SEQUENCE_WINDOW = 1024;
+	}
+
+	// Called on the assembling thread with each frame, oldest first. The
+	// handler may keep the handle (and so the buffer) as long as it
+	// likes; the pool runs dry if it keeps frame_count of them.
+	using FrameHandler = std::function<void(FrameHandle frame)>;
+
+
+	/// <summary>
+	/// FrameAssemblerSettings: Pool size and reordering window of a
+	///							FrameAssembler.
+	/// </summary>
+	struct FrameAssemblerSettings
+	{
+	public:
+		// Frame buffers, allocated once. Frames being assembled and frames
+		// the handler still holds both come from here.
+		uint32_t frame_count = 4;
+
+		// Frames assembled at once. A packet for a newer frame beyond this
+		// hands out the oldest one, complete or not.
+		uint32_t max_open_frames = 2;
+
+		SimdLevel max_simd_level = SimdLevel::AVX2;
+	};
+
+
+	/// <summary>
+	/// FrameAssemblerStatistics: Counters of the assembling thread. Written
+	///							  only by it, readable from any thread.
+	/// </summary>
+	struct FrameAssemblerStatistics
+	{
+	public:
+		std::atomic<uint64_t> packets = 0;
+
+		// Copied straight into the frame by the BpmPlacement
+		std::atomic<uint64_t> packets_placed = 0;
+
+		// Not RTP, or with an SRD outside the frame
+		std::atomic<uint64_t> packets_invalid = 0;
+
+		// For a frame already handed out or older than the newest frame,
+		// or one that had no buffer
+		std::atomic<uint64_t> packets_late = 0;
+
+		// Extended sequence numbers skipped and not seen since, and those
+		// that arrived after a later one. A packet more than
+		// SEQUENCE_WINDOW sequence numbers late can not be told from a
+		// duplicate; it counts as reordered and leaves packets_lost as is.
+		std::atomic<uint64_t> packets_lost = 0;
+		std::atomic<uint64_t> packets_reordered = 0;
+
+		// Sequence numbers seen before within SEQUENCE_WINDOW, dropped
+		std::atomic<uint64_t> packets_duplicate = 0;
+
+		std::atomic<uint64_t> frames_complete = 0;
+		std::atomic<uint64_t> frames_incomplete = 0;
+
+		// Frames whose packets were dropped because the pool was empty
+		std::atomic<uint64_t> frames_dropped = 0;
+	};
+
+
+	/// <summary>
+	/// FrameAssembler: Builds ST 2110-20 frames from RTP packets. Each
+	///					packet goes to the frame of its RTP timestamp and
+	///					its SRD segments are unpacked straight into that
+	///					frame's buffer at their row and offset, with the
+	///					pgroup row's received octets counted so the frame
+	///					knows which lines are complete. A frame is handed
+	///					out as soon as every row is complete; when its last
+	///					field's marker arrived but rows are missing, it is
+	///					handed out incomplete once a newer frame starts.
+	///					Packets may arrive in any order within the open
+	///					frames; a frame that never gets a marker is handed
+	///					out when max_open_frames newer frames push it out,
+	///					or when it holds the last free buffer. BPM streams
+	///					assembled into PGROUP frames skip the unpack: each
+	///					packet is matched to its BpmPlacement entry and
+	///					copied.
+	///					Push() never blocks and, after construction, never
+	///					allocates. Not thread safe: one thread pushes.
+	/// </summary>
+	class FrameAssembler
+	{
+	public:
+		FrameAssembler(const SDP::VideoDescription& video_description, PixelFormat pixel_format, FrameHandler handler,
+			const FrameAssemblerSettings& settings = {});
+
+		FrameAssembler(const FrameAssembler&) = delete;
+		FrameAssembler& operator=(const FrameAssembler&) = delete;
+
+		/// <summary>
+		/// Push: Places one RTP packet (header included) in its frame and
+		///		  hands out any frames it finishes.
+		/// </summary>
+		void Push(const uint8_t* packet, uint32_t octets);
+
+		/// <summary>
+		/// Flush: Hands out every open frame, e.g. when the stream stops.
+		/// </summary>
+		void Flush();
+
+		const VideoFormat& GetFormat() const { return m_format; }
+		const FrameLayout& GetLayout() const { return m_layout; }
+		const FrameAssemblerStatistics& GetStatistics() const { return m_statistics; }
+
+	private:
+		VideoFormat m_format;
+		FrameLayout m_layout;
+		PgroupUnpacker m_unpacker;
+		std::unique_ptr<BpmPlacement> m_placement;
+		FramePool m_pool;
+		FrameHandler m_handler;
+		uint32_t m_max_open_frames;
+
+		// Frames being assembled, oldest first
+		std::vector<FrameHandle> m_open_frames;
+
+		// Newest frame started (or dropped), to recognise late packets
+		uint32_t m_newest_timestamp = 0;
+		bool m_has_newest_timestamp = false;
+
+		uint32_t m_next_sequence = 0;
+		bool m_has_sequence = false;
+
+		// Sequence numbers seen of the last SEQUENCE_WINDOW before
+		// m_next_sequence, one bit each, and how many of those the stream
+		// has had since its first packet
+		std::array<uint64_t, FrameAssemblerDetail::SEQUENCE_WINDOW / 64> m_sequences_seen = {};
+		uint32_t m_tracked_sequences = 0;
+
+		FrameAssemblerStatistics m_statistics;
+
+		// Index of an open frame, or the open frame count if none
+		size_t FindFrame(uint32_t timestamp) const;
+		size_t OpenFrame(uint32_t timestamp);
+
+		bool Place(Frame& frame, const uint8_t* payload, uint32_t octets);
+		// Counts lost, reordered and duplicate packets. False for a
+		// duplicate.
+		bool CountSequence(uint32_t sequence);
+		bool IsSequenceSeen(uint32_t sequence) const;
+		void SetSequenceSeen(uint32_t sequence, bool seen);
+
+		// Hands out the open frames up to and including index
+		void Emit(size_t index);
+	};
+}
@@ -0,0 +1,211 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	// Memory layout of an unpacked frame
+	enum class PixelFormat : uint8_t
+	{
+		// One plane per component. 8 bit samples for 8 bit video, else 16 bit
+		// little endian, LSB aligned. Y/Cb/Cr, R/G/B or X/Y/Z plane order.
+		PLANAR,
+		// 4:2:2 10 bit. 6 pixels in 4 little endian 32 bit words, lines
+		// padded to 128 bytes.
+		V210,
+		// Luma plane plus one interleaved CbCr plane, 16 bit MSB aligned.
+		// P010 for 4:2:0, P210 for 4:2:2.
+		P010,
+		// ST 2110-20 pgroups as sent: one plane, one pgroup row per line
+		// (two picture lines for 4:2:0) and no line padding, so the
+		// payload of a progressive frame is the frame byte for byte.
+		PGROUP
+	};
+
+	constexpr const char* PixelFormatName(PixelFormat pixel_format)
+	{
+		switch (pixel_format)
+		{
+		case PixelFormat::V210: return "v210";
+		case PixelFormat::P010: return "p010";
+		case PixelFormat::PGROUP: return "pgroup";
+		default: return "planar";
+		}
+	}
+
+	/// <summary>
+	/// PixelFormatHolds: V210 holds 4:2:2 10 bit, P010 holds 4:2:2 and
+	///					  4:2:0 at 10, 12 and 16 bit integer depths. PLANAR
+	///					  and PGROUP hold every format with a pgroup.
+	/// </summary>
+	constexpr bool PixelFormatHolds(SDPSampling sampling, SDPDepth depth, PixelFormat pixel_format)
+	{
+		if (!SDPPgroupSize(sampling, depth).IsValid())
+			return false;
+
+		SDPChroma chroma = SDPSamplingChroma(sampling);
+		switch (pixel_format)
+		{
+		case PixelFormat::PLANAR:
+		case PixelFormat::PGROUP:
+			return true;
+		case PixelFormat::V210:
+			return chroma == SDPChroma::C422 && depth == SDPDepth::INT_10;
+		case PixelFormat::P010:
+			return (chroma == SDPChroma::C422 || chroma == SDPChroma::C420)
+				&& SDPDepthBits(depth) >= 10 && depth != SDPDepth::FLOAT_16;
+		}
+
+		return false;
+	}
+
+
+	/// <summary>
+	/// FramePlanes: Plane pointers and line strides of one frame buffer.
+	/// </summary>
+	struct FramePlanes
+	{
+		uint8_t* data[3] = {};
+		uint32_t strides[3] = {};	// bytes per line
+
+		/// <summary>
+		/// GetField: View of one field of an interlaced frame, so field lines
+		///			  can be addressed as consecutive lines.
+		/// </summary>
+		FramePlanes GetField(uint32_t field) const
+		{
+			FramePlanes field_planes;
+			for (int32_t i = 0; i < 3; i++)
+			{
+				field_planes.data[i] = data[i] ? data[i] + (size_t)strides[i] * field : nullptr;
+				field_planes.strides[i] = strides[i] * 2;
+			}
+
+			return field_planes;
+		}
+	};
+
+
+	/// <summary>
+	/// FrameLayout: Plane sizes of a PixelFormat frame for a VideoFormat, with
+	///				 every plane in one allocation. Lines hold a whole number
+	///				 of pgroups, so kernels may write the padding pixels of
+	///				 the last pgroup.
+	/// </summary>
+	struct FrameLayout
+	{
+	public:
+		PixelFormat pixel_format = PixelFormat::PLANAR;
+		uint32_t plane_count = 0;
+		uint32_t line_bytes[3] = {};	// used bytes per line
+		uint32_t heights[3] = {};
+		uint32_t strides[3] = {};
+		size_t offsets[3] = {};
+		size_t size = 0;
+
+		FrameLayout() = default;
+
+		/// <summary>
+		/// FrameLayout: Throws if the pixel format cannot hold the video
+		///				 format (see IsSupported).
+		/// </summary>
+		FrameLayout(const VideoFormat& format, PixelFormat pixel_format_, uint32_t alignment = 64)
+		{
+			if (!IsSupported(format, pixel_format_))
+				throw std::runtime_error(std::string("FrameLayout: Pixel format ") + PixelFormatName(pixel_format_) + " cannot hold the video format");
+
+			if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+				throw std::runtime_error("FrameLayout: Alignment must be a power of two");
+
+			pixel_format = pixel_format_;
+
+			uint32_t width = format.pgroups_per_line * format.pgroup_width;
+			uint32_t sample_bytes = format.depth_bits == 8 && pixel_format == PixelFormat::PLANAR ? 1 : 2;
+			uint32_t chroma_height = format.GetChroma() == SDPChroma::C420 ? format.height / 2 : format.height;
+
+			switch (pixel_format)
+			{
+			case PixelFormat::PLANAR:
+				plane_count = 3;
+				line_bytes[0] = width * sample_bytes;
+				heights[0] = format.height;
+
+				if (format.GetChroma() == SDPChroma::C444)
+					line_bytes[1] = line_bytes[0];
+				else
+					line_bytes[1] = width / 2 * sample_bytes;
+
+				line_bytes[2] = line_bytes[1];
+				heights[1] = heights[2] = chroma_height;
+				break;
+			case PixelFormat::V210:
+				plane_count = 1;
+				line_bytes[0] = (width + 47) / 48 * 128;
+				heights[0] = format.height;
+				break;
+			case PixelFormat::P010:
+				plane_count = 2;
+				line_bytes[0] = width * 2;
+				line_bytes[1] = width * 2;
+				heights[0] = format.height;
+				heights[1] = chroma_height;
+				break;
+			case PixelFormat::PGROUP:
+				plane_count = 1;
+				line_bytes[0] = format.line_octets;
+				heights[0] = format.rows_per_frame;
+				break;
+			}
+
+			for (uint32_t i = 0; i < plane_count; i++)
+			{
+				// PGROUP lines stay back to back, like the payload
+				strides[i] = pixel_format == PixelFormat::PGROUP ? line_bytes[i] : (line_bytes[i] + alignment - 1) & ~(alignment - 1);
+				offsets[i] = size;
+				size += (size_t)strides[i] * heights[i];
+			}
+		}
+
+		// Whether the pixel format can hold the video format (see
+		// PixelFormatHolds)
+		static bool IsSupported(const VideoFormat& format, PixelFormat pixel_format)
+		{
+			return PixelFormatHolds(format.GetSampling(), format.GetDepth(), pixel_format);
+		}
+
+		// Planes of a frame buffer of at least size bytes
+		FramePlanes GetPlanes(uint8_t* buffer) const
+		{
+			FramePlanes planes;
+			for (uint32_t i = 0; i < plane_count; i++)
+			{
+				planes.data[i] = buffer + offsets[i];
+				planes.strides[i] = strides[i];
+			}
+
+			return planes;
+		}
+	};
+}
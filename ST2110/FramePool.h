@@ -0,0 +1,213 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	/// <summary>
+	/// Frame: One preallocated frame buffer of a FramePool, with the RTP
+	///		   timestamp it was assembled for and which of its pgroup rows
+	///		   arrived in full. Rows that did not arrive keep whatever an
+	///		   earlier frame left in them.
+	/// </summary>
+	class Frame
+	{
+	public:
+		Frame(const VideoFormat& format, const FrameLayout& layout)
+			: m_buffer(layout.size), m_planes(layout.GetPlanes(m_buffer.data())), m_line_octets(format.line_octets),
+			  m_rows_per_field(format.field_height / format.pgroup_lines), m_pgroup_lines(format.pgroup_lines),
+			  m_interlaced(format.IsInterlaced())
+		{
+			m_row_octets.resize((size_t)m_rows_per_field * (m_interlaced ? 2 : 1));
+		}
+
+		Frame(const Frame&) = delete;
+		Frame& operator=(const Frame&) = delete;
+
+		const FramePlanes& GetPlanes() const { return m_planes; }
+		uint32_t GetTimestamp() const { return m_timestamp; }
+
+		// Packets placed in the frame
+		uint32_t GetPackets() const { return m_packets; }
+
+		uint32_t GetRowCount() const { return (uint32_t)m_row_octets.size(); }
+		uint32_t GetCompleteRows() const { return m_complete_rows; }
+		bool IsComplete() const { return m_complete_rows == m_row_octets.size(); }
+
+		// Whether every pgroup of a picture line (below the height)
+		// arrived. Odd lines belong to the second field if interlaced.
+		bool IsLineComplete(uint32_t line) const
+		{
+			uint32_t field = m_interlaced ? line & 1 : 0;
+			uint32_t field_line = m_interlaced ? line >> 1 : line;
+			return m_row_octets[field * m_rows_per_field + field_line / m_pgroup_lines] >= m_line_octets;
+		}
+
+	private:
+		friend class FrameHandle;
+		friend class FramePool;
+		friend class FrameAssembler;
+
+		std::vector<uint8_t> m_buffer;
+		FramePlanes m_planes;
+
+		// Payload octets received per pgroup row, fields one after the other
+		std::vector<uint32_t> m_row_octets;
+		uint32_t m_line_octets;
+		uint32_t m_rows_per_field;
+		uint32_t m_pgroup_lines;
+		bool m_interlaced;
+
+		uint32_t m_timestamp = 0;
+		uint32_t m_packets = 0;
+		uint32_t m_complete_rows = 0;
+
+		// The marker of the last field arrived
+		bool m_marker = false;
+
+		// Handles referencing the frame. Zero while it is free.
+		std::atomic<uint32_t> m_references = 0;
+
+		void Reset(uint32_t timestamp)
+		{
+			std::fill(m_row_octets.begin(), m_row_octets.end(), 0);
+			m_timestamp = timestamp;
+			m_packets = 0;
+			m_complete_rows = 0;
+			m_marker = false;
+		}
+
+		// Adds the octets of one segment to a row. Returns true once the
+		// frame is complete.
+		bool AddRowOctets(uint32_t field, uint32_t row, uint32_t octets)
+		{
+			uint32_t& row_octets = m_row_octets[field * m_rows_per_field + row];
+			bool was_complete = row_octets >= m_line_octets;
+
+			row_octets += octets;
+			if (!was_complete && row_octets >= m_line_octets)
+				m_complete_rows++;
+
+			return IsComplete();
+		}
+	};
+
+
+	/// <summary>
+	/// FrameHandle: Reference counted handle to a pooled Frame. Copies share
+	///				 the frame; it goes back to its pool when the last handle
+	///				 is destroyed, on whichever thread that happens. Handles
+	///				 must not outlive the pool.
+	/// </summary>
+	class FrameHandle
+	{
+	public:
+		FrameHandle() = default;
+
+		explicit FrameHandle(Frame* frame) : m_frame(frame)
+		{
+			if (m_frame != nullptr)
+				m_frame->m_references.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		FrameHandle(const FrameHandle& other) : FrameHandle(other.m_frame) {}
+		FrameHandle(FrameHandle&& other) noexcept : m_frame(std::exchange(other.m_frame, nullptr)) {}
+
+		FrameHandle& operator=(FrameHandle other) noexcept
+		{
+			std::swap(m_frame, other.m_frame);
+			return *this;
+		}
+
+		~FrameHandle() { Reset(); }
+
+		void Reset()
+		{
+			// Release, so the frame's contents are done with before the
+			// pool hands it out again
+			if (m_frame != nullptr)
+				m_frame->m_references.fetch_sub(1, std::memory_order_acq_rel);
+			m_frame = nullptr;
+		}
+
+		Frame* Get() const { return m_frame; }
+		Frame* operator->() const { return m_frame; }
+		Frame& operator*() const { return *m_frame; }
+		explicit operator bool() const { return m_frame != nullptr; }
+
+	private:
+		Frame* m_frame = nullptr;
+	};
+
+
+	/// <summary>
+	/// FramePool: Fixed set of frame buffers, allocated once for a video
+	///			   format and pixel format. Only one thread acquires frames;
+	///			   any thread may release them.
+	/// </summary>
+	class FramePool
+	{
+	public:
+		FramePool(const VideoFormat& format, const FrameLayout& layout, uint32_t frame_count)
+		{
+			if (frame_count == 0)
+				throw std::runtime_error("FramePool: Frame count must not be zero");
+
+			m_frames.reserve(frame_count);
+			for (uint32_t i = 0; i < frame_count; i++)
+				m_frames.push_back(std::make_unique<Frame>(format, layout));
+		}
+
+		/// <summary>
+		/// Acquire: Returns a free frame, reset for the given RTP timestamp,
+		///			 or an empty handle if every frame is still referenced.
+		/// </summary>
+		FrameHandle Acquire(uint32_t timestamp)
+		{
+			for (uint32_t i = 0; i < m_frames.size(); i++)
+			{
+				Frame* frame = m_frames[m_next].get();
+				m_next = (m_next + 1) % (uint32_t)m_frames.size();
+
+				if (frame->m_references.load(std::memory_order_acquire) == 0)
+				{
+					frame->Reset(timestamp);
+					return FrameHandle(frame);
+				}
+			}
+
+			return FrameHandle();
+		}
+
+		uint32_t GetFrameCount() const { return (uint32_t)m_frames.size(); }
+
+	private:
+		std::vector<std::unique_ptr<Frame>> m_frames;
+
+		// Frames are handed out round robin, so a frame a consumer just
+		// released is reused last
+		uint32_t m_next = 0;
+	};
+}
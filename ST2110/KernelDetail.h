@@ -0,0 +1,158 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+// Per function instruction set targets for the SIMD kernels. MSVC allows
+// the intrinsics without them.
+#if defined(ST2110_X86) && !(defined(_MSC_VER) && !defined(__clang__))
+#define ST2110_TARGET_SSE41 __attribute__((target("ssse3,sse4.1")))
+#define ST2110_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ST2110_TARGET_SSE41
+#define ST2110_TARGET_AVX2
+#endif
+
+namespace Cf
+{
+	namespace KernelDetail
+	{
+		/// <summary>
+		/// BitReader: Reads big endian samples of up to 16 bits from a
+		///			   2110-20 payload. The sample size is a template
+		///			   argument so that the octet aligned depths read whole
+		///			   octets and the others unroll per pgroup.
+		/// </summary>
+		struct BitReader
+		{
+			const uint8_t* data;
+			uint32_t cache = 0;
+			int32_t cached_bits = 0;
+
+			explicit BitReader(const uint8_t* payload) : data(payload) {}
+
+			template<int32_t Bits>
+			uint32_t Read()
+			{
+				if constexpr (Bits == 8)
+					return *data++;
+				else if constexpr (Bits == 16)
+				{
+					uint32_t sample = ((uint32_t)data[0] << 8) | data[1];
+					data += 2;
+					return sample;
+				}
+				else
+				{
+					while (cached_bits < Bits)
+					{
+						cache = (cache << 8) | *data++;
+						cached_bits += 8;
+					}
+
+					cached_bits -= Bits;
+					return (cache >> cached_bits) & ((1u << Bits) - 1);
+				}
+			}
+		};
+
+		/// <summary>
+		/// BitWriter: Writes big endian samples of up to 16 bits to a
+		///			   2110-20 payload. pgroups end on an octet boundary, so
+		///			   nothing is left over after a whole number of them.
+		/// </summary>
+		struct BitWriter
+		{
+			uint8_t* data;
+			uint32_t cache = 0;
+			int32_t cached_bits = 0;
+
+			explicit BitWriter(uint8_t* payload) : data(payload) {}
+
+			template<int32_t Bits>
+			void Write(uint32_t sample)
+			{
+				if constexpr (Bits == 8)
+					*data++ = (uint8_t)sample;
+				else if constexpr (Bits == 16)
+				{
+					data[0] = (uint8_t)(sample >> 8);
+					data[1] = (uint8_t)sample;
+					data += 2;
+				}
+				else
+				{
+					cache = (cache << Bits) | (sample & ((1u << Bits) - 1));
+					cached_bits += Bits;
+
+					while (cached_bits >= 8)
+					{
+						cached_bits -= 8;
+						*data++ = (uint8_t)(cache >> cached_bits);
+					}
+				}
+			}
+		};
+
+		template<typename Sample>
+		Sample* LinePointer(const FramePlanes& frame, int32_t plane, uint32_t line)
+		{
+			return (Sample*)(frame.data[plane] + (size_t)frame.strides[plane] * line);
+		}
+
+		// Plane of each sample of a 4:4:4 pgroup. Colour difference formats
+		// send Cb, Y, Cr (or Ct, I, Cp); RGB and XYZ send their planes in order.
+		constexpr std::array<int32_t, 3> Planes444(SDPSampling sampling)
+		{
+			if (sampling == SDPSampling::RGB || sampling == SDPSampling::XYZ)
+				return { 0, 1, 2 };
+
+			return { 1, 0, 2 };
+		}
+
+#ifdef ST2110_X86
+		// Swaps the first and third 10 bit field of each 32 bit lane, which
+		// turns 30 payload bits into a v210 word and back
+		inline ST2110_TARGET_SSE41 __m128i ReverseV210Fields(__m128i fields)
+		{
+			const __m128i low = _mm_set1_epi32(0x3FF);
+			const __m128i middle = _mm_set1_epi32(0xFFC00);
+
+			__m128i words = _mm_and_si128(_mm_srli_epi32(fields, 20), low);
+			words = _mm_or_si128(words, _mm_and_si128(fields, middle));
+			return _mm_or_si128(words, _mm_slli_epi32(_mm_and_si128(fields, low), 20));
+		}
+
+		inline ST2110_TARGET_AVX2 __m256i ReverseV210Fields(__m256i fields)
+		{
+			const __m256i low = _mm256_set1_epi32(0x3FF);
+			const __m256i middle = _mm256_set1_epi32(0xFFC00);
+
+			__m256i words = _mm256_and_si256(_mm256_srli_epi32(fields, 20), low);
+			words = _mm256_or_si256(words, _mm256_and_si256(fields, middle));
+			return _mm256_or_si256(words, _mm256_slli_epi32(_mm256_and_si256(fields, low), 20));
+		}
+#endif
+	}
+}
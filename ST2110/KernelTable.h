@@ -0,0 +1,168 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	/// <summary>
+	/// IsKernelFormat: Whether ST 2110-20 allows a sampling, depth and
+	///					packing mode: the sampling and depth need a pgroup,
+	///					and BPM needs pgroups that tile its 180 octet blocks
+	///					(2110-20:2022 6.3.3), which 4:2:2 16 bit does not.
+	/// </summary>
+	constexpr bool IsKernelFormat(SDPSampling sampling, SDPDepth depth, SDPPackingMode packing_mode)
+	{
+		SDPPgroup pgroup = SDPPgroupSize(sampling, depth);
+		if (!pgroup.IsValid())
+			return false;
+
+		return packing_mode == SDPPackingMode::GPM || StreamGeometryDetail::BPM_BLOCK_OCTETS % pgroup.octets == 0;
+	}
+
+
+	/// <summary>
+	/// PgroupLayout: The part of a format a kernel's code depends on:
+	///				  chroma structure, sample bits and the plane order of
+	///				  4:4:4 components. Formats with the same layout, such as
+	///				  YCbCr and ICtCp 4:2:2, or GPM and BPM, share kernels.
+	/// </summary>
+	template<SDPChroma Chroma, int32_t Bits, bool InPlaneOrder>
+	struct PgroupLayout
+	{
+		static constexpr SDPChroma CHROMA = Chroma;
+		static constexpr int32_t BITS = Bits;
+
+		// Plane of each sample of a 4:4:4 pgroup (see Planes444)
+		static constexpr std::array<int32_t, 3> PLANES = InPlaneOrder ? std::array<int32_t, 3>{ 0, 1, 2 } : std::array<int32_t, 3>{ 1, 0, 2 };
+
+		// Planar sample type
+		using Sample = std::conditional_t<Bits == 8, uint8_t, uint16_t>;
+	};
+
+
+	/// <summary>
+	/// KernelFormat: Compile time key of a pack or unpack kernel. Only the
+	///				  combinations ST 2110-20 allows, with a pixel format
+	///				  that can hold them, instantiate; the others fail a
+	///				  static_assert instead of throwing at activation.
+	/// </summary>
+	template<SDPSampling Sampling, SDPDepth Depth, SDPPackingMode PackingMode, PixelFormat Pixel>
+	struct KernelFormat
+	{
+		static_assert(SDPPgroupSize(Sampling, Depth).IsValid(), "KernelFormat: Sampling and depth have no ST 2110-20 pgroup");
+		static_assert(IsKernelFormat(Sampling, Depth, PackingMode), "KernelFormat: BPM needs a pgroup that divides 180 octets");
+		static_assert(PixelFormatHolds(Sampling, Depth, Pixel), "KernelFormat: Pixel format cannot hold the video format");
+
+		static constexpr SDPSampling SAMPLING = Sampling;
+		static constexpr SDPDepth DEPTH = Depth;
+		static constexpr SDPPackingMode PACKING_MODE = PackingMode;
+		static constexpr PixelFormat PIXEL_FORMAT = Pixel;
+		static constexpr SDPPgroup PGROUP = SDPPgroupSize(Sampling, Depth);
+
+		using Layout = PgroupLayout<SDPSamplingChroma(Sampling), SDPDepthBits(Depth), KernelDetail::Planes444(Sampling)[0] == 0>;
+	};
+
+
+	// A kernel and the SIMD level it was built for
+	template<typename Kernel>
+	struct KernelEntry
+	{
+		Kernel kernel = nullptr;
+		SimdLevel simd_level = SimdLevel::SCALAR;
+	};
+
+
+	/// <summary>
+	/// KernelTable: Kernels of every valid (sampling, depth, packing mode,
+	///				 pixel format) and SIMD level, built at compile time.
+	///				 Select<KernelFormat, SimdLevel>::Get() returns the
+	///				 KernelEntry of one combination, falling back to a lower
+	///				 SIMD level where there is no faster kernel. Find()
+	///				 resolves a VideoFormat to its kernel once, at
+	///				 activation, so per pixel loops never branch on the
+	///				 format. Entries of invalid combinations are empty.
+	/// </summary>
+	template<typename Kernel, template<typename Format, SimdLevel Level> class Select>
+	class KernelTable
+	{
+	public:
+		static KernelEntry<Kernel> Find(const VideoFormat& format, PixelFormat pixel_format, SimdLevel max_simd_level)
+		{
+			int32_t depth = DepthIndex(format.GetDepth());
+			if (format.sampling >= SAMPLINGS || depth < 0 || format.packing_mode >= MODES)
+				return {};
+
+			size_t index = (((((size_t)format.sampling * DEPTHS + depth) * MODES + format.packing_mode) * PIXEL_FORMATS
+				+ (size_t)pixel_format) * LEVELS) + (size_t)max_simd_level;
+
+			return index < COUNT ? ENTRIES[index] : KernelEntry<Kernel>();
+		}
+
+	private:
+		static constexpr size_t SAMPLINGS = (size_t)SDPSampling::KEY + 1;
+		static constexpr size_t MODES = (size_t)SDPPackingMode::BPM + 1;
+		static constexpr size_t PIXEL_FORMATS = (size_t)PixelFormat::PGROUP + 1;
+		static constexpr size_t LEVELS = (size_t)SimdLevel::AVX2 + 1;
+
+		static constexpr SDPDepth DEPTH_VALUES[] = { SDPDepth::INT_8, SDPDepth::INT_10, SDPDepth::INT_12, SDPDepth::INT_16, SDPDepth::FLOAT_16 };
+		static constexpr size_t DEPTHS = std::size(DEPTH_VALUES);
+
+		static constexpr size_t COUNT = SAMPLINGS * DEPTHS * MODES * PIXEL_FORMATS * LEVELS;
+
+		static constexpr int32_t DepthIndex(SDPDepth depth)
+		{
+			for (size_t i = 0; i < DEPTHS; i++)
+			{
+				if (DEPTH_VALUES[i] == depth)
+					return (int32_t)i;
+			}
+
+			return -1;
+		}
+
+		template<size_t Index>
+		static constexpr KernelEntry<Kernel> MakeEntry()
+		{
+			constexpr SimdLevel level = (SimdLevel)(Index % LEVELS);
+			constexpr PixelFormat pixel_format = (PixelFormat)(Index / LEVELS % PIXEL_FORMATS);
+			constexpr SDPPackingMode packing_mode = (SDPPackingMode)(Index / (LEVELS * PIXEL_FORMATS) % MODES);
+			constexpr SDPDepth depth = DEPTH_VALUES[Index / (LEVELS * PIXEL_FORMATS * MODES) % DEPTHS];
+			constexpr SDPSampling sampling = (SDPSampling)(Index / (LEVELS * PIXEL_FORMATS * MODES * DEPTHS));
+
+			if constexpr (IsKernelFormat(sampling, depth, packing_mode) && PixelFormatHolds(sampling, depth, pixel_format))
+				return Select<KernelFormat<sampling, depth, packing_mode, pixel_format>, level>::Get();
+			else
+				return {};
+		}
+
+		template<size_t... Indices>
+		static constexpr std::array<KernelEntry<Kernel>, COUNT> MakeEntries(std::index_sequence<Indices...>)
+		{
+			return { MakeEntry<Indices>()... };
+		}
+
+		static constexpr std::array<KernelEntry<Kernel>, COUNT> ENTRIES = MakeEntries(std::make_index_sequence<COUNT>());
+	};
+}
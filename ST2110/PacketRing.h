@@ -0,0 +1,166 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	/// <summary>
+	/// PacketSlot: One preallocated packet buffer of a PacketRing. Filled
+	///				in place by the receive thread, read in place by the
+	///				consumer that acquired it.
+	/// </summary>
+	struct alignas(64) PacketSlot
+	{
+	public:
+		uint8_t* data = nullptr;
+
+		// Octets received. If truncated, the datagram was larger than the
+		// slot and only the first slot_octets were kept.
+		uint32_t octets = 0;
+		bool truncated = false;
+
+		// Sender address, as the kernel reported it
+		SDP::SocketAddress source = {};
+
+	private:
+		friend class PacketRing;
+
+		// Slot state (bounded queue sequence): position when free for the
+		// producer, position + 1 when published to the consumers
+		std::atomic<uint64_t> m_sequence = 0;
+	};
+
+
+	/// <summary>
+	/// PacketRing: Single producer, multiple consumer ring of preallocated
+	///				packet buffers. The producer fills a batch of free slots
+	///				and publishes them; each consumer claims the next
+	///				published slot with one compare exchange, reads it in
+	///				place and releases it. No locks and no allocation after
+	///				construction. Slots may be released out of order; the
+	///				producer then stops at the oldest slot still held.
+	/// </summary>
+	class PacketRing
+	{
+	public:
+		PacketRing(uint32_t slot_count, uint32_t slot_octets)
+			: m_slot_count(slot_count), m_slot_octets(slot_octets)
+		{
+			if (slot_count == 0 || (slot_count & (slot_count - 1)) != 0)
+				throw std::runtime_error("PacketRing: Slot count must be a power of two");
+
+			if (slot_octets == 0)
+				throw std::runtime_error("PacketRing: Slot size must not be zero");
+
+			m_buffer.resize((size_t)slot_count * slot_octets);
+			m_slots = std::make_unique<PacketSlot[]>(slot_count);
+
+			for (uint32_t i = 0; i < slot_count; i++)
+			{
+				m_slots[i].data = m_buffer.data() + (size_t)i * slot_octets;
+				m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		PacketRing(const PacketRing&) = delete;
+		PacketRing& operator=(const PacketRing&) = delete;
+
+		uint32_t GetSlotCount() const { return m_slot_count; }
+		uint32_t GetSlotOctets() const { return m_slot_octets; }
+
+
+		/// Producer (one thread)
+
+		/// <summary>
+		/// GetFreeSlot: Returns the n-th slot after the last published one
+		///				 if no consumer still holds it, else nullptr. Slots
+		///				 are filled in order and published with Publish().
+		/// </summary>
+		PacketSlot* GetFreeSlot(uint32_t n)
+		{
+			uint64_t position = m_write_position + n;
+			PacketSlot* slot = &m_slots[position & (m_slot_count - 1)];
+			return slot->m_sequence.load(std::memory_order_acquire) == position ? slot : nullptr;
+		}
+
+		/// <summary>
+		/// Publish: Hands the next `count` slots, which GetFreeSlot()
+		///			 returned and the producer filled, to the consumers.
+		/// </summary>
+		void Publish(uint32_t count)
+		{
+			for (uint32_t i = 0; i < count; i++, m_write_position++)
+				m_slots[m_write_position & (m_slot_count - 1)].m_sequence.store(m_write_position + 1, std::memory_order_release);
+		}
+
+
+		/// Consumers (any number of threads)
+
+		/// <summary>
+		/// TryAcquire: Claims the oldest published slot, or returns nullptr
+		///				if there is none. The slot must be given back with
+		///				Release().
+		/// </summary>
+		PacketSlot* TryAcquire()
+		{
+			uint64_t position = m_read_position.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				PacketSlot* slot = &m_slots[position & (m_slot_count - 1)];
+				int64_t ready = (int64_t)(slot->m_sequence.load(std::memory_order_acquire) - (position + 1));
+
+				if (ready < 0)
+					return nullptr;
+
+				if (ready == 0)
+				{
+					if (m_read_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						return slot;
+				}
+				else
+					position = m_read_position.load(std::memory_order_relaxed);
+			}
+		}
+
+		/// <summary>
+		/// Release: Returns an acquired slot to the producer.
+		/// </summary>
+		void Release(PacketSlot* slot)
+		{
+			uint64_t published = slot->m_sequence.load(std::memory_order_relaxed);
+			slot->m_sequence.store(published - 1 + m_slot_count, std::memory_order_release);
+		}
+
+	private:
+		uint32_t m_slot_count;
+		uint32_t m_slot_octets;
+		std::vector<uint8_t> m_buffer;
+		std::unique_ptr<PacketSlot[]> m_slots;
+
+		// Producer and consumer positions on their own cache lines
+		alignas(64) uint64_t m_write_position = 0;
+		alignas(64) std::atomic<uint64_t> m_read_position = 0;
+	};
+}
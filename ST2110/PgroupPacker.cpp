@@ -0,0 +1,578 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+namespace Cf
+{
+	namespace
+	{
+		using namespace KernelDetail;
+
+
+		/// Scalar kernels, for every format. Each is specialized on the
+		/// PgroupLayout of its KernelFormat.
+
+		template<typename Layout>
+		void PackPlanarScalar(const VideoFormat& format, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload)
+		{
+			using Sample = typename Layout::Sample;
+			constexpr int32_t bits = Layout::BITS;
+
+			BitWriter writer(payload);
+			uint32_t pixels = pgroups * format.pgroup_width;
+
+			if constexpr (Layout::CHROMA == SDPChroma::C422)
+			{
+				const Sample* y = LinePointer<Sample>(frame, 0, line) + x;
+				const Sample* cb = LinePointer<Sample>(frame, 1, line) + x / 2;
+				const Sample* cr = LinePointer<Sample>(frame, 2, line) + x / 2;
+
+				for (uint32_t i = 0; i < pixels / 2; i++)
+				{
+					writer.Write<bits>(cb[i]);
+					writer.Write<bits>(y[2 * i]);
+					writer.Write<bits>(cr[i]);
+					writer.Write<bits>(y[2 * i + 1]);
+				}
+			}
+			else if constexpr (Layout::CHROMA == SDPChroma::C420)
+			{
+				const Sample* y0 = LinePointer<Sample>(frame, 0, line) + x;
+				const Sample* y1 = LinePointer<Sample>(frame, 0, line + 1) + x;
+				const Sample* cb = LinePointer<Sample>(frame, 1, line / 2) + x / 2;
+				const Sample* cr = LinePointer<Sample>(frame, 2, line / 2) + x / 2;
+
+				for (uint32_t i = 0; i < pixels / 2; i++)
+				{
+					writer.Write<bits>(y0[2 * i]);
+					writer.Write<bits>(y0[2 * i + 1]);
+					writer.Write<bits>(y1[2 * i]);
+					writer.Write<bits>(y1[2 * i + 1]);
+					writer.Write<bits>(cb[i]);
+					writer.Write<bits>(cr[i]);
+				}
+			}
+			else
+			{
+				constexpr std::array<int32_t, 3> planes = Layout::PLANES;
+				const Sample* first = LinePointer<Sample>(frame, planes[0], line) + x;
+				const Sample* second = LinePointer<Sample>(frame, planes[1], line) + x;
+				const Sample* third = LinePointer<Sample>(frame, planes[2], line) + x;
+
+				for (uint32_t i = 0; i < pixels; i++)
+				{
+					writer.Write<bits>(first[i]);
+					writer.Write<bits>(second[i]);
+					writer.Write<bits>(third[i]);
+				}
+			}
+		}
+
+		template<typename Layout>
+		void PackP010Scalar(const VideoFormat& format, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload)
+		{
+			constexpr int32_t bits = Layout::BITS;
+			constexpr int32_t shift = 16 - bits;
+
+			BitWriter writer(payload);
+			uint32_t pixels = pgroups * format.pgroup_width;
+
+			if constexpr (Layout::CHROMA == SDPChroma::C422)
+			{
+				const uint16_t* y = LinePointer<uint16_t>(frame, 0, line) + x;
+				const uint16_t* uv = LinePointer<uint16_t>(frame, 1, line) + x;
+
+				for (uint32_t i = 0; i < pixels; i += 2)
+				{
+					writer.Write<bits>(uv[i] >> shift);
+					writer.Write<bits>(y[i] >> shift);
+					writer.Write<bits>(uv[i + 1] >> shift);
+					writer.Write<bits>(y[i + 1] >> shift);
+				}
+			}
+			else
+			{
+				const uint16_t* y0 = LinePointer<uint16_t>(frame, 0, line) + x;
+				const uint16_t* y1 = LinePointer<uint16_t>(frame, 0, line + 1) + x;
+				const uint16_t* uv = LinePointer<uint16_t>(frame, 1, line / 2) + x;
+
+				for (uint32_t i = 0; i < pixels; i += 2)
+				{
+					writer.Write<bits>(y0[i] >> shift);
+					writer.Write<bits>(y0[i + 1] >> shift);
+					writer.Write<bits>(y1[i] >> shift);
+					writer.Write<bits>(y1[i + 1] >> shift);
+					writer.Write<bits>(uv[i] >> shift);
+					writer.Write<bits>(uv[i + 1] >> shift);
+				}
+			}
+		}
+
+		void PackV210Scalar(const VideoFormat&, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload)
+		{
+			BitWriter writer(payload);
+			const uint32_t* words = LinePointer<uint32_t>(frame, 0, line);
+
+			uint32_t first = 2 * x;
+			uint32_t last = first + 4 * pgroups;
+			for (uint32_t s = first; s < last; s++)
+				writer.Write<10>(words[s / 3] >> (s % 3) * 10);
+		}
+
+		using Layout422_8 = PgroupLayout<SDPChroma::C422, 8, false>;
+		using Layout422_10 = PgroupLayout<SDPChroma::C422, 10, false>;
+
+
+#ifdef ST2110_X86
+		/// 4:2:2 8 bit. The payload is UYVY.
+
+		ST2110_TARGET_SSE41 void Pack422_8PlanarSSE41(const VideoFormat& format, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload)
+		{
+			const uint8_t* y = LinePointer<uint8_t>(frame, 0, line) + x;
+			const uint8_t* cb = LinePointer<uint8_t>(frame, 1, line) + x / 2;
+			const uint8_t* cr = LinePointer<uint8_t>(frame, 2, line) + x / 2;
+
+			// 16 pixels per iteration
+			uint32_t i = 0;
+			for (; i + 8 <= pgroups; i += 8)
+			{
+				__m128i luma = _mm_loadu_si128((const __m128i*)(y + 2 * i));
+				__m128i chroma = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(cb + i)), _mm_loadl_epi64((const __m128i*)(cr + i)));
+
+				_mm_storeu_si128((__m128i*)(payload + 4 * i), _mm_unpacklo_epi8(chroma, luma));
+				_mm_storeu_si128((__m128i*)(payload + 4 * i + 16), _mm_unpackhi_epi8(chroma, luma));
+			}
+
+			if (i < pgroups)
+				PackPlanarScalar<Layout422_8>(format, frame, line, x + 2 * i, pgroups - i, payload + 4 * i);
+		}
+
+		ST2110_TARGET_AVX2 void Pack422_8PlanarAVX2(const VideoFormat& format, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload)
+		{
+			const uint8_t* y = LinePointer<uint8_t>(frame, 0, line) + x;
+			const uint8_t* cb = LinePointer<uint8_t>(frame, 1, line) + x / 2;
+			const uint8_t* cr = LinePointer<uint8_t>(frame, 2, line) + x / 2;
+
+			// 32 pixels per iteration
+			uint32_t i = 0;
+			for (; i + 16 <= pgroups; i += 16)
+			{
+				__m128i cb_samples = _mm_loadu_si128((const __m128i*)(cb + i));
+				__m128i cr_samples = _mm_loadu_si128((const __m128i*)(cr + i));
+
+				// [CbCr 0-7 | CbCr 8-15] against [Y 0-15 | Y 16-31]
+				__m256i chroma = _mm256_set_m128i(_mm_unpackhi_epi8(cb_samples, cr_samples), _mm_unpacklo_epi8(cb_samples, cr_samples));
+				__m256i luma = _mm256_loadu_si256((const __m256i*)(y + 2 * i));
+
+				__m256i low = _mm256_unpacklo_epi8(chroma, luma);
+				__m256i high = _mm256_unpackhi_epi8(chroma, luma);
+
+				_mm256_storeu_si256((__m256i*)(payload + 4 * i), _mm256_permute2x128_si256(low, high, 0x20));
+				_mm256_storeu_si256((__m256i*)(payload + 4 * i + 32), _mm256_permute2x128_si256(low, high, 0x31));
+			}
+
+			// The SSE4.1 tail must not run with dirty upper AVX state
+			_mm256_zeroupper();
+
+			if (i < pgroups)
+				Pack422_8PlanarSSE41(format, frame, line, x + 2 * i, pgroups - i, payload + 4 * i);
+		}
+
+
+		/// 4:2:2 10 bit. Samples are interleaved as [Y0 Cb Y1 Cr] 16 bit 
+		/// lanes; a multiply-add makes the 20 bit halves Cb:Y0 and Cr:Y1
+		/// of each pgroup, and each 64 bit lane joins them into the 40 bit
+		/// pgroup, which a byte shuffle writes out big endian. Stores are
+		/// 16 bytes wide for 10 bytes of pgroups; the next store overwrites
+		/// the rest.
+
+		constexpr int8_t PGROUP_10_SHUFFLE[16] = { 4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1 };
+
+		ST2110_TARGET_SSE41 __m128i Join422_10(__m128i interleaved)
+		{
+			__m128i halves = _mm_madd_epi16(interleaved, _mm_set1_epi32(0x04000001));
+			__m128i pgroups = _mm_or_si128(_mm_slli_epi64(_mm_and_si128(halves, _mm_set1_epi64x(0xFFFFF)), 20), _mm_srli_epi64(halves, 32));
+			return _mm_shuffle_epi8(pgroups, _mm_loadu_si128((const __m128i*)PGROUP_10_SHUFFLE));
+		}
+
+		ST2110_TARGET_AVX2 __m256i Join422_10(__m256i interleaved)
+		{
+			__m256i halves = _mm256_madd_epi16(interleaved, _mm256_set1_epi32(0x04000001));
+			__m256i pgroups = _mm256_or_si256(_mm256_slli_epi64(_mm256_and_si256(halves, _mm256_set1_epi64x(0xFFFFF)), 20), _mm256_srli_epi64(halves, 32));
+			return _mm256_shuffle_epi8(pgroups, _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)PGROUP_10_SHUFFLE)));
+		}
+
+		// Writes 4 pgroups from 8 luma samples and 4 CbCr pairs
+		ST2110_TARGET_SSE41 void Store422_10(__m128i luma, __m128i chroma, uint8_t* payload)
+		{
+			_mm_storeu_si128((__m128i*)payload, Join422_10(_mm_unpacklo_epi16(luma, chroma)));
+			_mm_storeu_si128((__m128i*)(payload + 10), Join422_10(_mm_unpackhi_epi16(luma, chroma)));
+		}
+
+		// Writes 8 pgroups from 16 luma samples and 8 CbCr pairs
+		ST2110_TARGET_AVX2 void Store422_10(__m256i luma, __m256i chroma, uint8_t* payload)
+		{
+			__m256i low = Join422_10(_mm256_unpacklo_epi16(luma, chroma));
+			__m256i high = Join422_10(_mm256_unpackhi_epi16(luma, chroma));
+
+			_mm_storeu_si128((__m128i*)payload, _mm256_castsi256_si128(low));
+			_mm_storeu_si128((__m128i*)(payload + 10), _mm256_castsi256_si128(high));
+			_mm_storeu_si128((__m128i*)(payload + 20), _mm256_extracti128_si256(low, 1));
+			_mm_storeu_si128((__m128i*)(payload + 30), _mm256_extracti128_si256(high, 1));
+		}
+
+		ST2110_TARGET_SSE41 void Pack422_10PlanarSSE41(const VideoFormat& format, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload)
+		{
+			const uint16_t* y = LinePointer<uint16_t>(frame, 0, line) + x;
+			const uint16_t* cb = LinePointer<uint16_t>(frame, 1, line) + x / 2;
+			const uint16_t* cr = LinePointer<uint16_t>(frame, 2, line) + x / 2;
+
+			const __m128i mask = _mm_set1_epi16(0x3FF);
+
+			// 8 pixels per iteration, writing 16 bytes at offset 10
+			uint32_t i = 0;
+			for (; i + 6 <= pgroups; i += 4)
+			{
+				__m128i luma = _mm_and_si128(_mm_loadu_si128((const __m128i*)(y + 2 * i)), mask);
+				__m128i chroma = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)(cb + i)), _mm_loadl_epi64((const __m128i*)(cr + i)));
+				Store422_10(luma, _mm_and_si128(chroma, mask), payload + 5 * i);
+			}
+
+			if (i < pgroups)
+				PackPlanarScalar<Layout422_10>(format, frame, line, x + 2 * i, pgroups - i, payload + 5 * i);
+		}
+
+		ST2110_TARGET_AVX2 void Pack422_10PlanarAVX2(const VideoFormat& format, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload)
+		{
+			const uint16_t* y = LinePointer<uint16_t>(frame, 0, line) + x;
+			const uint16_t* cb = LinePointer<uint16_t>(frame, 1, line) + x / 2;
+			const uint16_t* cr = LinePointer<uint16_t>(frame, 2, line) + x / 2;
+
+			const __m256i mask = _mm256_set1_epi16(0x3FF);
+
+			// 16 pixels per iteration, writing 16 bytes at offset 30
+			uint32_t i = 0;
+			for (; i + 10 <= pgroups; i += 8)
+			{
+				__m128i cb_samples = _mm_loadu_si128((const __m128i*)(cb + i));
+				__m128i cr_samples = _mm_loadu_si128((const __m128i*)(cr + i));
+				__m256i chroma = _mm256_set_m128i(_mm_unpackhi_epi16(cb_samples, cr_samples), _mm_unpacklo_epi16(cb_samples, cr_samples));
+				__m256i luma = _mm256_loadu_si256((const __m256i*)(y + 2 * i));
+
+				Store422_10(_mm256_and_si256(luma, mask), _mm256_and_si256(chroma, mask), payload + 5 * i);
+			}
+
+			// The SSE4.1 tail must not run with dirty upper AVX state
+			_mm256_zeroupper();
+
+			if (i < pgroups)
+				Pack422_10PlanarSSE41(format, frame, line, x + 2 * i, pgroups - i, payload + 5 * i);
+		}
+
+		ST2110_TARGET_SSE41 void Pack422_10P210SSE41(const VideoFormat& format, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload)
+		{
+			const uint16_t* y = LinePointer<uint16_t>(frame, 0, line) + x;
+			const uint16_t* uv = LinePointer<uint16_t>(frame, 1, line) + x;
+
+			uint32_t i = 0;
+			for (; i + 6 <= pgroups; i += 4)
+			{
+				__m128i luma = _mm_srli_epi16(_mm_loadu_si128((const __m128i*)(y + 2 * i)), 6);
+				__m128i chroma = _mm_srli_epi16(_mm_loadu_si128((const __m128i*)(uv + 2 * i)), 6);
+				Store422_10(luma, chroma, payload + 5 * i);
+			}
+
+			if (i < pgroups)
+				PackP010Scalar<Layout422_10>(format, frame, line, x + 2 * i, pgroups - i, payload + 5 * i);
+		}
+
+		ST2110_TARGET_AVX2 void Pack422_10P210AVX2(const VideoFormat& format, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload)
+		{
+			const uint16_t* y = LinePointer<uint16_t>(frame, 0, line) + x;
+			const uint16_t* uv = LinePointer<uint16_t>(frame, 1, line) + x;
+
+			uint32_t i = 0;
+			for (; i + 10 <= pgroups; i += 8)
+			{
+				__m256i luma = _mm256_srli_epi16(_mm256_loadu_si256((const __m256i*)(y + 2 * i)), 6);
+				__m256i chroma = _mm256_srli_epi16(_mm256_loadu_si256((const __m256i*)(uv + 2 * i)), 6);
+				Store422_10(luma, chroma, payload + 5 * i);
+			}
+
+			// The SSE4.1 tail must not run with dirty upper AVX state
+			_mm256_zeroupper();
+
+			if (i < pgroups)
+				Pack422_10P210SSE41(format, frame, line, x + 2 * i, pgroups - i, payload + 5 * i);
+		}
+
+
+		/// v210 to 4:2:2 10 bit. Each 64 bit lane joins two words (with
+		/// their fields swapped back to payload order) into 60 payload bits.
+		/// The first lane is shifted to the top of its 8 bytes, and two
+		/// byte shuffles merge the shared middle byte of the 15.
+
+		constexpr int8_t V210_FIRST_SHUFFLE[16] = { 7, 6, 5, 4, 3, 2, 1, 0, -1, -1, -1, -1, -1, -1, -1, -1 };
+		constexpr int8_t V210_SECOND_SHUFFLE[16] = { -1, -1, -1, -1, -1, -1, -1, 15, 14, 13, 12, 11, 10, 9, 8, -1 };
+
+		ST2110_TARGET_SSE41 void Pack422_10V210SSE41(const VideoFormat& format, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload)
+		{
+			// Words start every 6 pixels
+			uint32_t i = 0;
+			if (x % 6 != 0)
+			{
+				i = std::min((6 - x % 6) / 2, pgroups);
+				PackV210Scalar(format, frame, line, x, i, payload);
+			}
+
+			const uint32_t* words = LinePointer<uint32_t>(frame, 0, line) + (x + 2 * i) / 6 * 4;
+
+			const __m128i first = _mm_loadu_si128((const __m128i*)V210_FIRST_SHUFFLE);
+			const __m128i second = _mm_loadu_si128((const __m128i*)V210_SECOND_SHUFFLE);
+			const __m128i mask = _mm_set1_epi64x(0x3FFFFFFF);
+
+			// 6 pixels per iteration, writing 16 bytes for 15
+			for (; i + 4 <= pgroups; i += 3)
+			{
+				__m128i fields = ReverseV210Fields(_mm_loadu_si128((const __m128i*)words));
+				__m128i bits = _mm_or_si128(_mm_slli_epi64(_mm_and_si128(fields, mask), 30), _mm_srli_epi64(fields, 32));
+				bits = _mm_blend_epi16(_mm_slli_epi64(bits, 4), bits, 0xF0);
+
+				_mm_storeu_si128((__m128i*)(payload + 5 * i), _mm_or_si128(_mm_shuffle_epi8(bits, first), _mm_shuffle_epi8(bits, second)));
+				words += 4;
+			}
+
+			if (i < pgroups)
+				PackV210Scalar(format, frame, line, x + 2 * i, pgroups - i, payload + 5 * i);
+		}
+
+		ST2110_TARGET_AVX2 void Pack422_10V210AVX2(const VideoFormat& format, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload)
+		{
+			uint32_t i = 0;
+			if (x % 6 != 0)
+			{
+				i = std::min((6 - x % 6) / 2, pgroups);
+				PackV210Scalar(format, frame, line, x, i, payload);
+			}
+
+			const uint32_t* words = LinePointer<uint32_t>(frame, 0, line) + (x + 2 * i) / 6 * 4;
+
+			const __m256i first = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)V210_FIRST_SHUFFLE));
+			const __m256i second = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)V210_SECOND_SHUFFLE));
+			const __m256i shift = _mm256_setr_epi64x(4, 0, 4, 0);
+			const __m256i mask = _mm256_set1_epi64x(0x3FFFFFFF);
+
+			// 12 pixels per iteration, writing 16 bytes at offset 15
+			for (; i + 7 <= pgroups; i += 6)
+			{
+				__m256i fields = ReverseV210Fields(_mm256_loadu_si256((const __m256i*)words));
+				__m256i bits = _mm256_or_si256(_mm256_slli_epi64(_mm256_and_si256(fields, mask), 30), _mm256_srli_epi64(fields, 32));
+				bits = _mm256_sllv_epi64(bits, shift);
+				bits = _mm256_or_si256(_mm256_shuffle_epi8(bits, first), _mm256_shuffle_epi8(bits, second));
+
+				_mm_storeu_si128((__m128i*)(payload + 5 * i), _mm256_castsi256_si128(bits));
+				_mm_storeu_si128((__m128i*)(payload + 5 * i + 15), _mm256_extracti128_si256(bits, 1));
+				words += 8;
+			}
+
+			// The SSE4.1 tail must not run with dirty upper AVX state
+			_mm256_zeroupper();
+
+			if (i < pgroups)
+				Pack422_10V210SSE41(format, frame, line, x + 2 * i, pgroups - i, payload + 5 * i);
+		}
+#endif
+
+
+		// PGROUP frames hold pgroups as sent, one pgroup row per frame line,
+		// so packing is a copy
+		void PackPgroupCopy(const VideoFormat& format, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload)
+		{
+			const uint8_t* row = frame.data[0] + (size_t)frame.strides[0] * (line / format.pgroup_lines);
+			std::memcpy(payload, row + format.GetPixelOffset(x), (size_t)pgroups * format.pgroup_octets);
+		}
+
+
+		/// <summary>
+		/// PackKernels: Kernel of one KernelFormat at one SIMD level. The
+		///				 SIMD kernels cover 4:2:2 8 and 10 bit; every other
+		///				 format packs with its scalar specialization, and
+		///				 PGROUP with a copy.
+		/// </summary>
+		template<typename Format, SimdLevel Level>
+		struct PackKernels
+		{
+			using Layout = typename Format::Layout;
+
+			static constexpr KernelEntry<PackKernel> Get()
+			{
+				constexpr PixelFormat pixel_format = Format::PIXEL_FORMAT;
+
+				if constexpr (pixel_format == PixelFormat::PGROUP)
+					return { PackPgroupCopy, SimdLevel::SCALAR };
+
+#ifdef ST2110_X86
+				constexpr bool avx2 = Level == SimdLevel::AVX2;
+
+				if constexpr (Level != SimdLevel::SCALAR && Layout::CHROMA == SDPChroma::C422 && Layout::BITS == 8 && pixel_format == PixelFormat::PLANAR)
+					return { avx2 ? Pack422_8PlanarAVX2 : Pack422_8PlanarSSE41, Level };
+
+				if constexpr (Level != SimdLevel::SCALAR && Layout::CHROMA == SDPChroma::C422 && Layout::BITS == 10)
+				{
+					if constexpr (pixel_format == PixelFormat::PLANAR)
+						return { avx2 ? Pack422_10PlanarAVX2 : Pack422_10PlanarSSE41, Level };
+					else if constexpr (pixel_format == PixelFormat::V210)
+						return { avx2 ? Pack422_10V210AVX2 : Pack422_10V210SSE41, Level };
+					else if constexpr (pixel_format == PixelFormat::P010)
+						return { avx2 ? Pack422_10P210AVX2 : Pack422_10P210SSE41, Level };
+				}
+#endif
+
+				if constexpr (pixel_format == PixelFormat::V210)
+					return { PackV210Scalar, SimdLevel::SCALAR };
+				else if constexpr (pixel_format == PixelFormat::P010)
+					return { PackP010Scalar<Layout>, SimdLevel::SCALAR };
+				else
+					return { PackPlanarScalar<Layout>, SimdLevel::SCALAR };
+			}
+		};
+
+		using PackKernelTable = KernelTable<PackKernel, PackKernels>;
+	}
+
+
+	PgroupPacker::PgroupPacker(const VideoFormat& format, PixelFormat pixel_format, SimdLevel max_simd_level)
+		: m_format(format), m_geometry(format), m_pixel_format(pixel_format)
+	{
+		if (!FrameLayout::IsSupported(format, pixel_format))
+			throw std::runtime_error(std::string("PgroupPacker: Pixel format ") + PixelFormatName(pixel_format) + " cannot hold the video format");
+
+		if (format.width > 0x8000 || format.field_height > 0x8000)
+			throw std::runtime_error("PgroupPacker: Picture is too large for SRD row numbers and offsets");
+
+		KernelEntry<PackKernel> entry = PackKernelTable::Find(m_format, pixel_format, std::min(DetectSimdLevel(), max_simd_level));
+		if (!entry.kernel)
+			throw std::runtime_error("PgroupPacker: ST 2110-20 does not allow the sampling, depth and packing mode of the video format");
+
+		m_kernel = entry.kernel;
+		m_simd_level = entry.simd_level;
+
+		BuildPacketPlan();
+
+		PLOG_INFO << "PgroupPacker: " << PixelFormatName(pixel_format) << " to " << SDPEnumToString(format.GetSampling()) << " " 
+			<< SDPEnumToString(format.GetDepth()) << " " << SDPEnumToString(format.GetPackingMode()) << ", "
+			<< GetPacketsPerFrame() << " packets per frame using " << SimdLevelName(m_simd_level) << " kernel";
+	}
+
+	PgroupPacker::PgroupPacker(const SDP::VideoDescription& video_description, PixelFormat pixel_format)
+		: PgroupPacker(VideoFormat(video_description), pixel_format)
+	{
+	}
+
+	void PgroupPacker::BuildPacketPlan()
+	{
+		uint32_t line_octets = m_geometry.line_octets;
+		uint32_t field_octets = m_geometry.field_octets;
+		uint32_t packet_data_octets = m_geometry.packet_data_octets;
+
+		m_segments.clear();
+		m_packet_segments.clear();
+
+		auto add_segment = [&](uint32_t position, uint32_t length)
+		{
+			uint32_t row = position / line_octets;
+			uint32_t pgroup = position % line_octets / m_format.pgroup_octets;
+			m_segments.push_back({ (uint16_t)(row * m_format.pgroup_lines), (uint16_t)(pgroup * m_format.pgroup_width), (uint16_t)length });
+		};
+
+		if (m_format.GetPackingMode() == SDPPackingMode::BPM)
+		{
+			// Fixed size packets that continue across lines
+			for (uint32_t position = 0; position < field_octets; )
+			{
+				m_packet_segments.push_back((uint32_t)m_segments.size());
+
+				uint32_t remaining = std::min(packet_data_octets, field_octets - position);
+				while (remaining > 0)
+				{
+					uint32_t length = std::min(remaining, line_octets - position % line_octets);
+					add_segment(position, length);
+					position += length;
+					remaining -= length;
+				}
+			}
+		}
+		else
+		{
+			// One segment per packet, never crossing a line
+			for (uint32_t row_start = 0; row_start < field_octets; row_start += line_octets)
+			{
+				for (uint32_t offset = 0; offset < line_octets; offset += packet_data_octets)
+				{
+					m_packet_segments.push_back((uint32_t)m_segments.size());
+					add_segment(row_start + offset, std::min(packet_data_octets, line_octets - offset));
+				}
+			}
+		}
+
+		m_packet_segments.push_back((uint32_t)m_segments.size());
+	}
+
+	uint32_t PgroupPacker::PackPacket(const FramePlanes& frame, uint32_t packet, uint32_t sequence, uint8_t* payload) const
+	{
+		uint32_t packets_per_field = GetPacketsPerField();
+		uint32_t field = packet / packets_per_field;
+		uint32_t index = packet % packets_per_field;
+
+		FramePlanes planes = m_format.IsInterlaced() ? frame.GetField(field) : frame;
+
+		uint32_t first = m_packet_segments[index];
+		uint32_t last = m_packet_segments[index + 1];
+
+		// Extended sequence number, then all SRD headers, then the data
+		RtpDetail::WriteBE16(payload, (uint16_t)(sequence >> 16));
+		uint8_t* header = payload + StreamGeometryDetail::EXTENDED_SEQUENCE_OCTETS;
+		uint8_t* data = header + SampleRowData::OCTETS * (last - first);
+
+		for (uint32_t i = first; i < last; i++)
+		{
+			const Segment& segment = m_segments[i];
+
+			SampleRowData srd;
+			srd.length = segment.length;
+			srd.row = segment.row;
+			srd.offset = segment.offset;
+			srd.second_field = field != 0;
+			srd.continuation = i + 1 < last;
+			srd.Write(header);
+			header += SampleRowData::OCTETS;
+
+			m_kernel(m_format, planes, segment.row, segment.offset, segment.length / m_format.pgroup_octets, data);
+			data += segment.length;
+		}
+
+		return (uint32_t)(data - payload);
+	}
+}
@@ -0,0 +1,100 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	// Packs `pgroups` pgroups of one pgroup row, starting at pixel x of
+	// picture line `line` of the frame, into a payload
+	using PackKernel = void (*)(const VideoFormat& format, const FramePlanes& frame, uint32_t line, uint32_t x, uint32_t pgroups, uint8_t* payload);
+
+
+	/// <summary>
+	/// PgroupPacker: Converts a PixelFormat frame into ST 2110-20 RTP 
+	///				  payloads, the reverse of PgroupUnpacker. Packet
+	///				  boundaries follow the VideoStreamGeometry of the
+	///				  format: GPM packets hold whole pgroups of one line up
+	///				  to MAXUDP, BPM packets hold 1260 octets and continue
+	///				  across lines. The packet plan is built once, at
+	///				  activation, and each packet gets its SRD headers
+	///				  (row, offset, continuation, field) from it.
+	/// </summary>
+	class PgroupPacker
+	{
+	public:
+		PgroupPacker(const VideoFormat& format, PixelFormat pixel_format, SimdLevel max_simd_level = SimdLevel::AVX2);
+		PgroupPacker(const SDP::VideoDescription& video_description, PixelFormat pixel_format);
+
+		/// <summary>
+		/// PackPacket: Writes the 2110-20 payload of packet n of a frame:
+		///				extended sequence number, SRD headers, then pgroups.
+		///				`sequence` is the 32 bit extended sequence number of
+		///				the packet; its low 16 bits go in the RTP header.
+		///				Returns the payload octets, at most 
+		///				GetMaxPayloadOctets().
+		/// </summary>
+		uint32_t PackPacket(const FramePlanes& frame, uint32_t packet, uint32_t sequence, uint8_t* payload) const;
+
+		// Packs pgroups without headers
+		void Pack(const FramePlanes& frame, uint32_t line, uint32_t offset, uint32_t pgroups, uint8_t* payload) const
+		{
+			m_kernel(m_format, frame, line, offset, pgroups, payload);
+		}
+
+		// RTP marker bit of a packet: set on the last packet of each field
+		bool IsLastOfField(uint32_t packet) const { return (packet + 1) % GetPacketsPerField() == 0; }
+
+		uint32_t GetPacketsPerField() const { return (uint32_t)m_packet_segments.size() - 1; }
+		uint32_t GetPacketsPerFrame() const { return m_geometry.packets_per_frame; }
+		uint32_t GetMaxPayloadOctets() const { return m_geometry.max_packet_octets - StreamGeometryDetail::RTP_HEADER_OCTETS; }
+
+		const VideoFormat& GetFormat() const { return m_format; }
+		const VideoStreamGeometry& GetGeometry() const { return m_geometry; }
+		PixelFormat GetPixelFormat() const { return m_pixel_format; }
+		SimdLevel GetSimdLevel() const { return m_simd_level; }
+
+	private:
+		// One SRD: a run of pgroups of one pgroup row
+		struct Segment
+		{
+			uint16_t row;		// line within the field
+			uint16_t offset;	// pixels
+			uint16_t length;	// octets
+		};
+
+		void BuildPacketPlan();
+
+		VideoFormat m_format;
+		VideoStreamGeometry m_geometry;
+		PackKernel m_kernel = nullptr;
+		PixelFormat m_pixel_format = PixelFormat::PLANAR;
+		SimdLevel m_simd_level = SimdLevel::SCALAR;
+
+		// Segments of one field in packet order, and the first segment of 
+		// each packet (plus one past the last)
+		std::vector<Segment> m_segments;
+		std::vector<uint32_t> m_packet_segments;
+	};
+}
@@ -0,0 +1,553 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+namespace Cf
+{
+	namespace
+	{
+		using namespace KernelDetail;
+
+
+		/// Scalar kernels, for every format. Each is specialized on the
+		/// PgroupLayout of its KernelFormat.
+
+		template<typename Layout>
+		void UnpackPlanarScalar(const VideoFormat& format, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x)
+		{
+			using Sample = typename Layout::Sample;
+			constexpr int32_t bits = Layout::BITS;
+
+			BitReader reader(payload);
+			uint32_t pixels = pgroups * format.pgroup_width;
+
+			if constexpr (Layout::CHROMA == SDPChroma::C422)
+			{
+				Sample* y = LinePointer<Sample>(frame, 0, line) + x;
+				Sample* cb = LinePointer<Sample>(frame, 1, line) + x / 2;
+				Sample* cr = LinePointer<Sample>(frame, 2, line) + x / 2;
+
+				for (uint32_t i = 0; i < pixels / 2; i++)
+				{
+					cb[i] = (Sample)reader.Read<bits>();
+					y[2 * i] = (Sample)reader.Read<bits>();
+					cr[i] = (Sample)reader.Read<bits>();
+					y[2 * i + 1] = (Sample)reader.Read<bits>();
+				}
+			}
+			else if constexpr (Layout::CHROMA == SDPChroma::C420)
+			{
+				Sample* y0 = LinePointer<Sample>(frame, 0, line) + x;
+				Sample* y1 = LinePointer<Sample>(frame, 0, line + 1) + x;
+				Sample* cb = LinePointer<Sample>(frame, 1, line / 2) + x / 2;
+				Sample* cr = LinePointer<Sample>(frame, 2, line / 2) + x / 2;
+
+				for (uint32_t i = 0; i < pixels / 2; i++)
+				{
+					y0[2 * i] = (Sample)reader.Read<bits>();
+					y0[2 * i + 1] = (Sample)reader.Read<bits>();
+					y1[2 * i] = (Sample)reader.Read<bits>();
+					y1[2 * i + 1] = (Sample)reader.Read<bits>();
+					cb[i] = (Sample)reader.Read<bits>();
+					cr[i] = (Sample)reader.Read<bits>();
+				}
+			}
+			else
+			{
+				constexpr std::array<int32_t, 3> planes = Layout::PLANES;
+				Sample* first = LinePointer<Sample>(frame, planes[0], line) + x;
+				Sample* second = LinePointer<Sample>(frame, planes[1], line) + x;
+				Sample* third = LinePointer<Sample>(frame, planes[2], line) + x;
+
+				for (uint32_t i = 0; i < pixels; i++)
+				{
+					first[i] = (Sample)reader.Read<bits>();
+					second[i] = (Sample)reader.Read<bits>();
+					third[i] = (Sample)reader.Read<bits>();
+				}
+			}
+		}
+
+		template<typename Layout>
+		void UnpackP010Scalar(const VideoFormat& format, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x)
+		{
+			constexpr int32_t bits = Layout::BITS;
+			constexpr int32_t shift = 16 - bits;
+
+			BitReader reader(payload);
+			uint32_t pixels = pgroups * format.pgroup_width;
+
+			if constexpr (Layout::CHROMA == SDPChroma::C422)
+			{
+				uint16_t* y = LinePointer<uint16_t>(frame, 0, line) + x;
+				uint16_t* uv = LinePointer<uint16_t>(frame, 1, line) + x;
+
+				for (uint32_t i = 0; i < pixels; i += 2)
+				{
+					uv[i] = (uint16_t)(reader.Read<bits>() << shift);
+					y[i] = (uint16_t)(reader.Read<bits>() << shift);
+					uv[i + 1] = (uint16_t)(reader.Read<bits>() << shift);
+					y[i + 1] = (uint16_t)(reader.Read<bits>() << shift);
+				}
+			}
+			else
+			{
+				uint16_t* y0 = LinePointer<uint16_t>(frame, 0, line) + x;
+				uint16_t* y1 = LinePointer<uint16_t>(frame, 0, line + 1) + x;
+				uint16_t* uv = LinePointer<uint16_t>(frame, 1, line / 2) + x;
+
+				for (uint32_t i = 0; i < pixels; i += 2)
+				{
+					y0[i] = (uint16_t)(reader.Read<bits>() << shift);
+					y0[i + 1] = (uint16_t)(reader.Read<bits>() << shift);
+					y1[i] = (uint16_t)(reader.Read<bits>() << shift);
+					y1[i + 1] = (uint16_t)(reader.Read<bits>() << shift);
+					uv[i] = (uint16_t)(reader.Read<bits>() << shift);
+					uv[i + 1] = (uint16_t)(reader.Read<bits>() << shift);
+				}
+			}
+		}
+
+		// v210 keeps the 4:2:2 sample order of the payload (Cb Y Cr Y ...),
+		// three samples to a word, so sample s of a line is field s % 3 of
+		// word s / 3.
+		void UnpackV210Scalar(const VideoFormat&, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x)
+		{
+			BitReader reader(payload);
+			uint32_t* words = LinePointer<uint32_t>(frame, 0, line);
+
+			uint32_t first = 2 * x;
+			uint32_t last = first + 4 * pgroups;
+			for (uint32_t s = first; s < last; s++)
+			{
+				// The last field also clears the two unused bits
+				uint32_t shift = (s % 3) * 10;
+				uint32_t mask = shift == 20 ? 0xFFF00000u : 0x3FFu << shift;
+				uint32_t& word = words[s / 3];
+				word = (word & ~mask) | (reader.Read<10>() << shift);
+			}
+		}
+
+		using Layout422_8 = PgroupLayout<SDPChroma::C422, 8, false>;
+		using Layout422_10 = PgroupLayout<SDPChroma::C422, 10, false>;
+
+
+#ifdef ST2110_X86
+		/// 4:2:2 8 bit. The payload is UYVY.
+
+		ST2110_TARGET_SSE41 void Unpack422_8PlanarSSE41(const VideoFormat& format, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x)
+		{
+			uint8_t* y = LinePointer<uint8_t>(frame, 0, line) + x;
+			uint8_t* cb = LinePointer<uint8_t>(frame, 1, line) + x / 2;
+			uint8_t* cr = LinePointer<uint8_t>(frame, 2, line) + x / 2;
+
+			const __m128i shuffle = _mm_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, 0, 4, 8, 12, 2, 6, 10, 14);
+
+			// 16 pixels per iteration
+			uint32_t i = 0;
+			for (; i + 8 <= pgroups; i += 8)
+			{
+				__m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(payload + 4 * i)), shuffle);
+				__m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(payload + 4 * i + 16)), shuffle);
+
+				_mm_storeu_si128((__m128i*)(y + 2 * i), _mm_unpacklo_epi64(a, b));
+
+				__m128i chroma = _mm_shuffle_epi32(_mm_unpackhi_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+				_mm_storel_epi64((__m128i*)(cb + i), chroma);
+				_mm_storel_epi64((__m128i*)(cr + i), _mm_unpackhi_epi64(chroma, chroma));
+			}
+
+			if (i < pgroups)
+				UnpackPlanarScalar<Layout422_8>(format, payload + 4 * i, pgroups - i, frame, line, x + 2 * i);
+		}
+
+		ST2110_TARGET_AVX2 void Unpack422_8PlanarAVX2(const VideoFormat& format, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x)
+		{
+			uint8_t* y = LinePointer<uint8_t>(frame, 0, line) + x;
+			uint8_t* cb = LinePointer<uint8_t>(frame, 1, line) + x / 2;
+			uint8_t* cr = LinePointer<uint8_t>(frame, 2, line) + x / 2;
+
+			const __m256i shuffle = _mm256_setr_epi8(
+				1, 3, 5, 7, 9, 11, 13, 15, 0, 4, 8, 12, 2, 6, 10, 14,
+				1, 3, 5, 7, 9, 11, 13, 15, 0, 4, 8, 12, 2, 6, 10, 14);
+
+			// 32 pixels per iteration
+			uint32_t i = 0;
+			for (; i + 16 <= pgroups; i += 16)
+			{
+				__m256i a = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(payload + 4 * i)), shuffle);
+				__m256i b = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(payload + 4 * i + 32)), shuffle);
+
+				// [Y Y | C C] per vector
+				a = _mm256_permute4x64_epi64(a, _MM_SHUFFLE(3, 1, 2, 0));
+				b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(3, 1, 2, 0));
+
+				_mm256_storeu_si256((__m256i*)(y + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+
+				// Cb0-3 Cr0-3 Cb4-7 Cr4-7 | ... -> Cb0-15 | Cr0-15
+				__m256i chroma = _mm256_permute2x128_si256(a, b, 0x31);
+				chroma = _mm256_shuffle_epi32(chroma, _MM_SHUFFLE(3, 1, 2, 0));
+				chroma = _mm256_permute4x64_epi64(chroma, _MM_SHUFFLE(3, 1, 2, 0));
+
+				_mm_storeu_si128((__m128i*)(cb + i), _mm256_castsi256_si128(chroma));
+				_mm_storeu_si128((__m128i*)(cr + i), _mm256_extracti128_si256(chroma, 1));
+			}
+
+			// The SSE4.1 tail must not run with dirty upper AVX state
+			_mm256_zeroupper();
+
+			if (i < pgroups)
+				Unpack422_8PlanarSSE41(format, payload + 4 * i, pgroups - i, frame, line, x + 2 * i);
+		}
+
+
+		/// 4:2:2 10 bit. Each 16 bit lane takes the two payload bytes that
+		/// hold its sample, byte swapped, so a multiply (left shift) by 1, 4,
+		/// 16 or 64 and a right shift by 6 extract it. The shuffles place
+		/// the lanes of two pgroups as [Y0 Y1 Y2 Y3 | Cb0 Cb1 Cr0 Cr1] for
+		/// planar and [Y0 Y1 Y2 Y3 | Cb0 Cr0 Cb1 Cr1] for P210.
+
+		constexpr int8_t PLANAR_10_SHUFFLE[16] = { 2, 1, 4, 3, 7, 6, 9, 8, 1, 0, 6, 5, 3, 2, 8, 7 };
+		constexpr int16_t PLANAR_10_SHIFT[8] = { 4, 64, 4, 64, 1, 1, 16, 16 };
+		constexpr int8_t P210_SHUFFLE[16] = { 2, 1, 4, 3, 7, 6, 9, 8, 1, 0, 3, 2, 6, 5, 8, 7 };
+		constexpr int16_t P210_SHIFT[8] = { 4, 64, 4, 64, 1, 16, 1, 16 };
+
+		ST2110_TARGET_SSE41 __m128i Extract422_10(const uint8_t* payload, __m128i shuffle, __m128i shift)
+		{
+			__m128i samples = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)payload), shuffle);
+			return _mm_mullo_epi16(samples, shift);
+		}
+
+		ST2110_TARGET_AVX2 __m256i Extract422_10(const uint8_t* payload, __m256i shuffle, __m256i shift)
+		{
+			__m256i samples = _mm256_inserti128_si256(
+				_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)payload)),
+				_mm_loadu_si128((const __m128i*)(payload + 10)), 1);
+
+			return _mm256_mullo_epi16(_mm256_shuffle_epi8(samples, shuffle), shift);
+		}
+
+		ST2110_TARGET_SSE41 void Unpack422_10PlanarSSE41(const VideoFormat& format, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x)
+		{
+			uint16_t* y = LinePointer<uint16_t>(frame, 0, line) + x;
+			uint16_t* cb = LinePointer<uint16_t>(frame, 1, line) + x / 2;
+			uint16_t* cr = LinePointer<uint16_t>(frame, 2, line) + x / 2;
+
+			const __m128i shuffle = _mm_loadu_si128((const __m128i*)PLANAR_10_SHUFFLE);
+			const __m128i shift = _mm_loadu_si128((const __m128i*)PLANAR_10_SHIFT);
+
+			// 8 pixels per iteration, reading 16 bytes at offset 10
+			uint32_t i = 0;
+			for (; i + 6 <= pgroups; i += 4)
+			{
+				__m128i a = _mm_srli_epi16(Extract422_10(payload + 5 * i, shuffle, shift), 6);
+				__m128i b = _mm_srli_epi16(Extract422_10(payload + 5 * i + 10, shuffle, shift), 6);
+
+				_mm_storeu_si128((__m128i*)(y + 2 * i), _mm_unpacklo_epi64(a, b));
+
+				__m128i chroma = _mm_shuffle_epi32(_mm_unpackhi_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+				_mm_storel_epi64((__m128i*)(cb + i), chroma);
+				_mm_storel_epi64((__m128i*)(cr + i), _mm_unpackhi_epi64(chroma, chroma));
+			}
+
+			if (i < pgroups)
+				UnpackPlanarScalar<Layout422_10>(format, payload + 5 * i, pgroups - i, frame, line, x + 2 * i);
+		}
+
+		ST2110_TARGET_AVX2 void Unpack422_10PlanarAVX2(const VideoFormat& format, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x)
+		{
+			uint16_t* y = LinePointer<uint16_t>(frame, 0, line) + x;
+			uint16_t* cb = LinePointer<uint16_t>(frame, 1, line) + x / 2;
+			uint16_t* cr = LinePointer<uint16_t>(frame, 2, line) + x / 2;
+
+			const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)PLANAR_10_SHUFFLE));
+			const __m256i shift = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)PLANAR_10_SHIFT));
+
+			// 16 pixels per iteration, reading 16 bytes at offset 30
+			uint32_t i = 0;
+			for (; i + 10 <= pgroups; i += 8)
+			{
+				__m256i a = _mm256_srli_epi16(Extract422_10(payload + 5 * i, shuffle, shift), 6);
+				__m256i b = _mm256_srli_epi16(Extract422_10(payload + 5 * i + 20, shuffle, shift), 6);
+
+				// [Y0-3 C | Y4-7 C] -> [Y0-7 | C]
+				a = _mm256_permute4x64_epi64(a, _MM_SHUFFLE(3, 1, 2, 0));
+				b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(3, 1, 2, 0));
+
+				_mm256_storeu_si256((__m256i*)(y + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+
+				__m256i chroma = _mm256_permute2x128_si256(a, b, 0x31);
+				chroma = _mm256_shuffle_epi32(chroma, _MM_SHUFFLE(3, 1, 2, 0));
+				chroma = _mm256_permute4x64_epi64(chroma, _MM_SHUFFLE(3, 1, 2, 0));
+
+				_mm_storeu_si128((__m128i*)(cb + i), _mm256_castsi256_si128(chroma));
+				_mm_storeu_si128((__m128i*)(cr + i), _mm256_extracti128_si256(chroma, 1));
+			}
+
+			// The SSE4.1 tail must not run with dirty upper AVX state
+			_mm256_zeroupper();
+
+			if (i < pgroups)
+				Unpack422_10PlanarSSE41(format, payload + 5 * i, pgroups - i, frame, line, x + 2 * i);
+		}
+
+		ST2110_TARGET_SSE41 void Unpack422_10P210SSE41(const VideoFormat& format, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x)
+		{
+			uint16_t* y = LinePointer<uint16_t>(frame, 0, line) + x;
+			uint16_t* uv = LinePointer<uint16_t>(frame, 1, line) + x;
+
+			const __m128i shuffle = _mm_loadu_si128((const __m128i*)P210_SHUFFLE);
+			const __m128i shift = _mm_loadu_si128((const __m128i*)P210_SHIFT);
+			const __m128i mask = _mm_set1_epi16((int16_t)0xFFC0);
+
+			uint32_t i = 0;
+			for (; i + 6 <= pgroups; i += 4)
+			{
+				__m128i a = _mm_and_si128(Extract422_10(payload + 5 * i, shuffle, shift), mask);
+				__m128i b = _mm_and_si128(Extract422_10(payload + 5 * i + 10, shuffle, shift), mask);
+
+				_mm_storeu_si128((__m128i*)(y + 2 * i), _mm_unpacklo_epi64(a, b));
+				_mm_storeu_si128((__m128i*)(uv + 2 * i), _mm_unpackhi_epi64(a, b));
+			}
+
+			if (i < pgroups)
+				UnpackP010Scalar<Layout422_10>(format, payload + 5 * i, pgroups - i, frame, line, x + 2 * i);
+		}
+
+		ST2110_TARGET_AVX2 void Unpack422_10P210AVX2(const VideoFormat& format, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x)
+		{
+			uint16_t* y = LinePointer<uint16_t>(frame, 0, line) + x;
+			uint16_t* uv = LinePointer<uint16_t>(frame, 1, line) + x;
+
+			const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)P210_SHUFFLE));
+			const __m256i shift = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)P210_SHIFT));
+			const __m256i mask = _mm256_set1_epi16((int16_t)0xFFC0);
+
+			uint32_t i = 0;
+			for (; i + 10 <= pgroups; i += 8)
+			{
+				__m256i a = _mm256_and_si256(Extract422_10(payload + 5 * i, shuffle, shift), mask);
+				__m256i b = _mm256_and_si256(Extract422_10(payload + 5 * i + 20, shuffle, shift), mask);
+
+				a = _mm256_permute4x64_epi64(a, _MM_SHUFFLE(3, 1, 2, 0));
+				b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(3, 1, 2, 0));
+
+				_mm256_storeu_si256((__m256i*)(y + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+				_mm256_storeu_si256((__m256i*)(uv + 2 * i), _mm256_permute2x128_si256(a, b, 0x31));
+			}
+
+			// The SSE4.1 tail must not run with dirty upper AVX state
+			_mm256_zeroupper();
+
+			if (i < pgroups)
+				Unpack422_10P210SSE41(format, payload + 5 * i, pgroups - i, frame, line, x + 2 * i);
+		}
+
+
+		/// 4:2:2 10 bit to v210. A v210 word holds 30 consecutive payload
+		/// bits with its three samples in reverse order. Three pgroups (15
+		/// bytes) make four words: each 64 bit lane takes 8 byte swapped
+		/// payload bytes, two 30 bit fields are shifted out of it, and the
+		/// samples of each field are swapped end for end.
+
+		constexpr int8_t V210_SHUFFLE[16] = { 7, 6, 5, 4, 3, 2, 1, 0, 14, 13, 12, 11, 10, 9, 8, 7 };
+
+		ST2110_TARGET_SSE41 void Unpack422_10V210SSE41(const VideoFormat& format, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x)
+		{
+			// Words start every 6 pixels
+			uint32_t i = 0;
+			if (x % 6 != 0)
+			{
+				i = (6 - x % 6) / 2;
+				if (i > pgroups)
+					i = pgroups;
+
+				UnpackV210Scalar(format, payload, i, frame, line, x);
+			}
+
+			uint32_t* words = LinePointer<uint32_t>(frame, 0, line) + (x + 2 * i) / 6 * 4;
+
+			const __m128i shuffle = _mm_loadu_si128((const __m128i*)V210_SHUFFLE);
+			const __m128i mask = _mm_set1_epi64x(0x3FFFFFFF);
+
+			// 6 pixels per iteration
+			for (; i + 4 <= pgroups; i += 3)
+			{
+				__m128i lanes = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(payload + 5 * i)), shuffle);
+
+				// Fields 0 and 2 at bits 34 and 30, fields 1 and 3 at 4 and 0
+				__m128i even = _mm_blend_epi16(_mm_srli_epi64(lanes, 34), _mm_srli_epi64(lanes, 30), 0xF0);
+				__m128i odd = _mm_blend_epi16(_mm_srli_epi64(lanes, 4), lanes, 0xF0);
+
+				__m128i fields = _mm_or_si128(_mm_and_si128(even, mask), _mm_slli_epi64(_mm_and_si128(odd, mask), 32));
+				_mm_storeu_si128((__m128i*)words, ReverseV210Fields(fields));
+				words += 4;
+			}
+
+			if (i < pgroups)
+				UnpackV210Scalar(format, payload + 5 * i, pgroups - i, frame, line, x + 2 * i);
+		}
+
+		ST2110_TARGET_AVX2 void Unpack422_10V210AVX2(const VideoFormat& format, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x)
+		{
+			uint32_t i = 0;
+			if (x % 6 != 0)
+			{
+				i = (6 - x % 6) / 2;
+				if (i > pgroups)
+					i = pgroups;
+
+				UnpackV210Scalar(format, payload, i, frame, line, x);
+			}
+
+			uint32_t* words = LinePointer<uint32_t>(frame, 0, line) + (x + 2 * i) / 6 * 4;
+
+			const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)V210_SHUFFLE));
+			const __m256i even_shift = _mm256_setr_epi64x(34, 30, 34, 30);
+			const __m256i odd_shift = _mm256_setr_epi64x(4, 0, 4, 0);
+			const __m256i mask = _mm256_set1_epi64x(0x3FFFFFFF);
+
+			// 12 pixels per iteration, reading 16 bytes at offset 15
+			for (; i + 7 <= pgroups; i += 6)
+			{
+				const uint8_t* source = payload + 5 * i;
+				__m256i lanes = _mm256_inserti128_si256(
+					_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)source)),
+					_mm_loadu_si128((const __m128i*)(source + 15)), 1);
+				lanes = _mm256_shuffle_epi8(lanes, shuffle);
+
+				__m256i even = _mm256_and_si256(_mm256_srlv_epi64(lanes, even_shift), mask);
+				__m256i odd = _mm256_and_si256(_mm256_srlv_epi64(lanes, odd_shift), mask);
+
+				__m256i fields = _mm256_or_si256(even, _mm256_slli_epi64(odd, 32));
+				_mm256_storeu_si256((__m256i*)words, ReverseV210Fields(fields));
+				words += 8;
+			}
+
+			// The SSE4.1 tail must not run with dirty upper AVX state
+			_mm256_zeroupper();
+
+			if (i < pgroups)
+				Unpack422_10V210SSE41(format, payload + 5 * i, pgroups - i, frame, line, x + 2 * i);
+		}
+#endif
+
+
+		// PGROUP frames hold pgroups as sent, one pgroup row per frame line,
+		// so unpacking is a copy
+		void UnpackPgroupCopy(const VideoFormat& format, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x)
+		{
+			uint8_t* row = frame.data[0] + (size_t)frame.strides[0] * (line / format.pgroup_lines);
+			std::memcpy(row + format.GetPixelOffset(x), payload, (size_t)pgroups * format.pgroup_octets);
+		}
+
+
+		/// <summary>
+		/// UnpackKernels: Kernel of one KernelFormat at one SIMD level. The
+		///				   SIMD kernels cover 4:2:2 8 and 10 bit; every other
+		///				   format unpacks with its scalar specialization, and
+		///				   PGROUP with a copy.
+		/// </summary>
+		template<typename Format, SimdLevel Level>
+		struct UnpackKernels
+		{
+			using Layout = typename Format::Layout;
+
+			static constexpr KernelEntry<UnpackKernel> Get()
+			{
+				constexpr PixelFormat pixel_format = Format::PIXEL_FORMAT;
+
+				if constexpr (pixel_format == PixelFormat::PGROUP)
+					return { UnpackPgroupCopy, SimdLevel::SCALAR };
+
+#ifdef ST2110_X86
+				constexpr bool avx2 = Level == SimdLevel::AVX2;
+
+				if constexpr (Level != SimdLevel::SCALAR && Layout::CHROMA == SDPChroma::C422 && Layout::BITS == 8 && pixel_format == PixelFormat::PLANAR)
+					return { avx2 ? Unpack422_8PlanarAVX2 : Unpack422_8PlanarSSE41, Level };
+
+				if constexpr (Level != SimdLevel::SCALAR && Layout::CHROMA == SDPChroma::C422 && Layout::BITS == 10)
+				{
+					if constexpr (pixel_format == PixelFormat::PLANAR)
+						return { avx2 ? Unpack422_10PlanarAVX2 : Unpack422_10PlanarSSE41, Level };
+					else if constexpr (pixel_format == PixelFormat::V210)
+						return { avx2 ? Unpack422_10V210AVX2 : Unpack422_10V210SSE41, Level };
+					else if constexpr (pixel_format == PixelFormat::P010)
+						return { avx2 ? Unpack422_10P210AVX2 : Unpack422_10P210SSE41, Level };
+				}
+#endif
+
+				if constexpr (pixel_format == PixelFormat::V210)
+					return { UnpackV210Scalar, SimdLevel::SCALAR };
+				else if constexpr (pixel_format == PixelFormat::P010)
+					return { UnpackP010Scalar<Layout>, SimdLevel::SCALAR };
+				else
+					return { UnpackPlanarScalar<Layout>, SimdLevel::SCALAR };
+			}
+		};
+
+		using UnpackKernelTable = KernelTable<UnpackKernel, UnpackKernels>;
+	}
+
+
+	PgroupUnpacker::PgroupUnpacker(const VideoFormat& format, PixelFormat pixel_format, SimdLevel max_simd_level)
+		: m_format(format), m_pixel_format(pixel_format)
+	{
+		if (!FrameLayout::IsSupported(format, pixel_format))
+			throw std::runtime_error(std::string("PgroupUnpacker: Pixel format ") + PixelFormatName(pixel_format) + " cannot hold the video format");
+
+		KernelEntry<UnpackKernel> entry = UnpackKernelTable::Find(m_format, pixel_format, std::min(DetectSimdLevel(), max_simd_level));
+		if (!entry.kernel)
+			throw std::runtime_error("PgroupUnpacker: ST 2110-20 does not allow the sampling, depth and packing mode of the video format");
+
+		m_kernel = entry.kernel;
+		m_simd_level = entry.simd_level;
+
+		PLOG_INFO << "PgroupUnpacker: " << SDPEnumToString(format.GetSampling()) << " " << SDPEnumToString(format.GetDepth())
+			<< " to " << PixelFormatName(pixel_format) << " using " << SimdLevelName(m_simd_level) << " kernel";
+	}
+
+	PgroupUnpacker::PgroupUnpacker(const SDP::VideoDescription& video_description, PixelFormat pixel_format)
+		: PgroupUnpacker(VideoFormat(video_description), pixel_format)
+	{
+	}
+
+	void PgroupUnpacker::UnpackFrame(const uint8_t* payload, const FramePlanes& frame) const
+	{
+		uint32_t fields = m_format.IsInterlaced() ? 2 : 1;
+		uint32_t rows = m_format.rows_per_frame / fields;
+
+		for (uint32_t field = 0; field < fields; field++)
+		{
+			FramePlanes planes = fields == 1 ? frame : frame.GetField(field);
+
+			for (uint32_t row = 0; row < rows; row++)
+			{
+				m_kernel(m_format, payload, m_format.pgroups_per_line, planes, row * m_format.pgroup_lines, 0);
+				payload += m_format.line_octets;
+			}
+		}
+	}
+}
@@ -0,0 +1,86 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	// Unpacks `pgroups` pgroups of one pgroup row, starting at pixel x of
+	// picture line `line`, into the frame
+	using UnpackKernel = void (*)(const VideoFormat& format, const uint8_t* payload, uint32_t pgroups, const FramePlanes& frame, uint32_t line, uint32_t x);
+
+
+	/// <summary>
+	/// PgroupUnpacker: Converts ST 2110-20 pgroups into a PixelFormat frame.
+	///					The kernel is chosen once, at activation, from the
+	///					sampling and depth of the video format and the SIMD
+	///					level of the CPU. 4:2:2 8 and 10 bit have SSE4.1 and
+	///					AVX2 kernels; every other format uses the scalar
+	///					kernel.
+	/// </summary>
+	class PgroupUnpacker
+	{
+	public:
+		PgroupUnpacker(const VideoFormat& format, PixelFormat pixel_format, SimdLevel max_simd_level = SimdLevel::AVX2);
+		PgroupUnpacker(const SDP::VideoDescription& video_description, PixelFormat pixel_format);
+
+		/// <summary>
+		/// Unpack: Unpacks one sample row data segment (SRD). `line` is the
+		///			first picture line of the pgroup row in `frame`, a frame
+		///			or field view of `lines` picture lines (the field height
+		///			for a field view), and `offset` the SRD pixel offset.
+		///			Length is rounded down to whole pgroups. Returns false
+		///			and writes nothing if the segment lies outside the view.
+		/// </summary>
+		bool Unpack(const uint8_t* payload, uint32_t length, uint32_t line, uint32_t offset, const FramePlanes& frame, uint32_t lines) const
+		{
+			uint32_t pgroups = length / m_format.pgroup_octets;
+
+			if (line % m_format.pgroup_lines != 0 || lines > m_format.height || line + m_format.pgroup_lines > lines
+				|| offset % m_format.pgroup_width != 0 || offset / m_format.pgroup_width + pgroups > m_format.pgroups_per_line)
+				return false;
+
+			if (pgroups != 0)
+				m_kernel(m_format, payload, pgroups, frame, line, offset);
+
+			return true;
+		}
+
+		/// <summary>
+		/// UnpackFrame: Unpacks a whole frame of pgroup rows stored back to
+		///				 back, fields one after the other if interlaced.
+		/// </summary>
+		void UnpackFrame(const uint8_t* payload, const FramePlanes& frame) const;
+
+		const VideoFormat& GetFormat() const { return m_format; }
+		PixelFormat GetPixelFormat() const { return m_pixel_format; }
+		SimdLevel GetSimdLevel() const { return m_simd_level; }
+
+	private:
+		VideoFormat m_format;
+		UnpackKernel m_kernel = nullptr;
+		PixelFormat m_pixel_format = PixelFormat::PLANAR;
+		SimdLevel m_simd_level = SimdLevel::SCALAR;
+	};
+}
@@ -0,0 +1,335 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+#ifdef ST2110_LINUX
+#include <cmath>
+#include <netinet/udp.h>
+#include <random>
+
+namespace Cf
+{
+	namespace
+	{
+		using namespace RuntimeDetail;
+
+		// Audio packets per cycle: 1 s of 1 ms packets
+		constexpr uint32_t AUDIO_CYCLE_PACKETS = 1000;
+
+		// -20 dBFS 1 kHz tone
+		constexpr double TONE_HZ = 1000;
+		constexpr double TONE_AMPLITUDE = 0.1;
+
+		// Largest UDP payload of an IPv4 datagram, which a GSO buffer must
+		// fit in
+		constexpr uint32_t MAX_GSO_OCTETS = 65507;
+
+		constexpr size_t CONTROL_OCTETS = CMSG_SPACE(sizeof(uint16_t));
+
+		uint8_t GetPayloadType(const SDP::MediaDescription& media_description, uint8_t default_payload_type)
+		{
+			return media_description.payload_types.empty() ? default_payload_type : (uint8_t)media_description.payload_types[0];
+		}
+	}
+
+
+	RtpBlaster::RtpBlaster(const RtpBlasterSettings& settings)
+		: m_socket_settings(settings.socket), m_batch_size(settings.batch_size), m_max_segments(settings.max_segments),
+		  m_segmentation_offload(settings.segmentation_offload)
+	{
+		if (m_batch_size == 0 || m_max_segments == 0)
+			throw std::runtime_error("RtpBlaster: Batch size and segments must not be zero");
+
+#ifndef UDP_SEGMENT
+		m_segmentation_offload = false;
+#endif
+
+		m_messages.resize(m_batch_size);
+		m_vectors.resize(m_batch_size);
+		m_controls.resize(m_batch_size * CONTROL_OCTETS);
+		m_message_packets.resize(m_batch_size);
+		for (uint32_t i = 0; i < m_batch_size; i++)
+		{
+			msghdr& header = m_messages[i].msg_hdr;
+			header = {};
+			header.msg_iov = &m_vectors[i];
+			header.msg_iovlen = 1;
+		}
+	}
+
+	void RtpBlaster::AddStream(const SDP::VideoDescription& video_description)
+	{
+		VideoFormat format(video_description);
+		PgroupPacker packer(format, PixelFormat::PLANAR);
+		TestPattern pattern(format);
+		const FramePlanes& frame = pattern.Render(0);
+
+		uint32_t packet_count = packer.GetPacketsPerFrame();
+		Stream& stream = OpenStream(video_description, packet_count, RtpHeader::OCTETS + packer.GetMaxPayloadOctets());
+
+		stream.video = true;
+		stream.frame_timing = FrameTiming(format.framerate, video_description.rtp_clock.GetClockRate());
+		stream.rtp_offset = video_description.rtp_clock.GetOffset();
+		stream.timestamp = (uint32_t)stream.frame_timing.GetFrameTicks(0) + stream.rtp_offset;
+
+		RtpHeader header;
+		header.payload_type = GetPayloadType(video_description, 96);
+		header.ssrc = std::random_device()();
+		for (uint32_t i = 0; i < packet_count; i++)
+		{
+			uint8_t* packet = stream.packets.data() + stream.offsets.back();
+			header.marker = packer.IsLastOfField(i);
+			header.Write(packet);
+			stream.offsets.push_back(stream.offsets.back() + RtpHeader::OCTETS + packer.PackPacket(frame, i, i, packet + RtpHeader::OCTETS));
+		}
+
+		stream.packets.resize(stream.offsets.back());
+		BuildRuns(stream);
+
+		PLOG_INFO << "RtpBlaster: Video stream of " << packet_count << " packets per frame, " << stream.runs.size() << " messages";
+	}
+
+	void RtpBlaster::AddStream(const SDP::AudioDescription& audio_description)
+	{
+		AudioFormat format(audio_description);
+		AudioPacker packer(format, SampleFormat::INT32, SampleLayout::INTERLEAVED);
+
+		// The same tone on every channel
+		uint32_t samples = AUDIO_CYCLE_PACKETS * format.samples_per_packet;
+		std::vector<int32_t> tone((size_t)samples * format.channels);
+		for (uint32_t i = 0; i < samples; i++)
+		{
+			int32_t value = (int32_t)(std::sin(2 * M_PI * TONE_HZ * i / format.sample_rate) * TONE_AMPLITUDE * INT32_MAX);
+			std::fill_n(tone.begin() + (size_t)i * format.channels, format.channels, value);
+		}
+
+		Stream& stream = OpenStream(audio_description, AUDIO_CYCLE_PACKETS, RtpHeader::OCTETS + format.packet_data_octets);
+		stream.packet_ticks = format.samples_per_packet;
+		stream.rtp_offset = audio_description.rtp_clock.GetOffset();
+		stream.timestamp = stream.rtp_offset;
+
+		RtpHeader header;
+		header.payload_type = GetPayloadType(audio_description, 97);
+		header.ssrc = std::random_device()();
+		AudioBuffer input = { tone.data(), 0 };
+		for (uint32_t i = 0; i < AUDIO_CYCLE_PACKETS; i++)
+		{
+			uint8_t* packet = stream.packets.data() + stream.offsets.back();
+			header.Write(packet);
+			stream.offsets.push_back(stream.offsets.back() + RtpHeader::OCTETS
+				+ packer.Pack(input, i * format.samples_per_packet, format.samples_per_packet, packet + RtpHeader::OCTETS));
+		}
+
+		stream.packets.resize(stream.offsets.back());
+		BuildRuns(stream);
+
+		PLOG_INFO << "RtpBlaster: Audio stream of " << format.packet_data_octets << " octet payloads, " << stream.runs.size() << " messages per "
+			<< AUDIO_CYCLE_PACKETS << " packets";
+	}
+
+	void RtpBlaster::AddSDP(const std::string& sdp)
+	{
+		SDPParser sdp_parser(sdp);
+		const SDP& description = sdp_parser.GetSDP();
+
+		for (size_t i = 0; i < description.GetVideoCount(); i++)
+			AddStream(description.GetVideo(i));
+		for (size_t i = 0; i < description.GetAudioCount(); i++)
+			AddStream(description.GetAudio(i));
+	}
+
+	uint64_t RtpBlaster::SendRound()
+	{
+		uint64_t sent = 0;
+		for (Stream& stream : m_streams)
+		{
+			// Never a run twice in one call, its headers would be those of
+			// the second
+			uint32_t count = std::min(m_batch_size, (uint32_t)stream.runs.size());
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const Run& run = stream.runs[stream.next_run];
+				Rewrite(stream, run);
+
+				uint32_t first = stream.offsets[run.first_packet];
+				m_vectors[i] = { stream.packets.data() + first, stream.offsets[run.first_packet + run.packet_count] - first };
+				m_message_packets[i] = run.packet_count;
+
+				msghdr& header = m_messages[i].msg_hdr;
+				if (run.packet_count > 1)
+				{
+#ifdef UDP_SEGMENT
+					header.msg_control = m_controls.data() + i * CONTROL_OCTETS;
+					header.msg_controllen = CONTROL_OCTETS;
+
+					cmsghdr* control = CMSG_FIRSTHDR(&header);
+					control->cmsg_level = SOL_UDP;
+					control->cmsg_type = UDP_SEGMENT;
+					control->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+					uint16_t segment_octets = (uint16_t)run.segment_octets;
+					std::memcpy(CMSG_DATA(control), &segment_octets, sizeof(segment_octets));
+#endif
+				}
+				else
+				{
+					header.msg_control = nullptr;
+					header.msg_controllen = 0;
+				}
+
+				if (++stream.next_run == stream.runs.size())
+					StartCycle(stream);
+			}
+
+			sent += Send(stream, count);
+		}
+
+		return sent;
+	}
+
+	RtpBlaster::Stream& RtpBlaster::OpenStream(const SDP::MediaDescription& media_description, uint32_t packet_count, uint32_t max_packet_octets)
+	{
+		Stream stream;
+		stream.socket = std::make_unique<RtpSendSocket>(media_description.endpoint, m_socket_settings);
+		stream.packets.resize((size_t)packet_count * max_packet_octets);
+		stream.offsets.reserve(packet_count + 1);
+		stream.offsets.push_back(0);
+
+		m_streams.push_back(std::move(stream));
+		return m_streams.back();
+	}
+
+	void RtpBlaster::BuildRuns(Stream& stream) const
+	{
+		stream.runs.clear();
+		stream.next_run = 0;
+
+		uint32_t packet_count = (uint32_t)stream.offsets.size() - 1;
+		for (uint32_t first = 0; first < packet_count;)
+		{
+			uint32_t segment_octets = stream.offsets[first + 1] - stream.offsets[first];
+			uint32_t count = 1;
+
+			// GSO splits a buffer into segment_octets packets, the last
+			// one possibly shorter
+			if (m_segmentation_offload)
+			{
+				uint32_t max_count = std::min(m_max_segments, MAX_GSO_OCTETS / segment_octets);
+				while (count < max_count && first + count < packet_count)
+				{
+					uint32_t octets = stream.offsets[first + count + 1] - stream.offsets[first + count];
+					if (octets > segment_octets)
+						break;
+
+					count++;
+					if (octets < segment_octets)
+						break;
+				}
+			}
+
+			stream.runs.push_back({ first, count, segment_octets });
+			first += count;
+		}
+	}
+
+	void RtpBlaster::Rewrite(Stream& stream, const Run& run)
+	{
+		for (uint32_t i = run.first_packet; i < run.first_packet + run.packet_count; i++)
+		{
+			uint8_t* packet = stream.packets.data() + stream.offsets[i];
+			RtpDetail::WriteBE16(packet + 2, (uint16_t)stream.sequence);
+			RtpDetail::WriteBE32(packet + 4, stream.timestamp);
+
+			if (stream.video)
+				RtpDetail::WriteBE16(packet + RtpHeader::OCTETS, (uint16_t)(stream.sequence >> 16));
+			else
+				stream.timestamp += stream.packet_ticks;
+
+			stream.sequence++;
+		}
+	}
+
+	void RtpBlaster::StartCycle(Stream& stream)
+	{
+		stream.next_run = 0;
+		if (stream.video)
+			stream.timestamp = (uint32_t)stream.frame_timing.GetFrameTicks(++stream.frame_index) + stream.rtp_offset;
+	}
+
+	void RtpBlaster::DisableSegmentationOffload()
+	{
+		m_segmentation_offload = false;
+
+		// Runs change, so video starts over with the next frame
+		for (Stream& stream : m_streams)
+		{
+			BuildRuns(stream);
+			StartCycle(stream);
+		}
+	}
+
+	uint32_t RtpBlaster::Send(Stream& stream, uint32_t count)
+	{
+		uint32_t sent = 0;
+		uint32_t packets = 0;
+		uint64_t octets = 0;
+		while (sent < count)
+		{
+			int32_t result = sendmmsg(stream.socket->GetDescriptor(), m_messages.data() + sent, count - sent, 0);
+			RelaxedAdd(m_statistics.system_calls, 1);
+
+			if (result < 0)
+			{
+				if (errno == EINTR)
+					continue;
+
+				uint32_t dropped = 0;
+				for (uint32_t i = sent; i < count; i++)
+					dropped += m_message_packets[i];
+				RelaxedAdd(m_statistics.packets_dropped, dropped);
+
+				// EIO without checksum offload, EINVAL for a segment over
+				// the MTU
+				if (m_segmentation_offload && (errno == EIO || errno == EINVAL))
+				{
+					PLOG_ERROR << "RtpBlaster: UDP_SEGMENT refused (" << std::strerror(errno) << "), sending a packet per message";
+					DisableSegmentationOffload();
+				}
+				break;
+			}
+
+			for (int32_t i = 0; i < result; i++)
+			{
+				packets += m_message_packets[sent + i];
+				octets += m_messages[sent + i].msg_len;
+			}
+			sent += result;
+		}
+
+		RelaxedAdd(m_statistics.packets, packets);
+		RelaxedAdd(m_statistics.octets, octets);
+		return packets;
+	}
+}
+#endif
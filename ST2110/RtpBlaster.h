@@ -0,0 +1,187 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+#ifdef ST2110_LINUX
+namespace Cf
+{
+	/// <summary>
+	/// RtpBlasterSettings: Socket and batching of an RtpBlaster.
+	/// </summary>
+	struct RtpBlasterSettings
+	{
+	public:
+		RtpSendSocketSettings socket;
+
+		// Messages per sendmmsg() call, each a run of packets of one stream
+		uint32_t batch_size = 64;
+
+		// Hand each run to the kernel as one UDP_SEGMENT (GSO) buffer that
+		// is split into packets below the socket layer, or by the NIC. Off,
+		// or where the kernel refuses it, every packet is a message.
+		bool segmentation_offload = true;
+
+		// Packets per GSO buffer. Kernels take at most UDP_MAX_SEGMENTS (64
+		// on most) and 64 KiB in one.
+		uint32_t max_segments = 64;
+	};
+
+
+	/// <summary>
+	/// RtpBlasterStatistics: Counters of the sending thread. Written only by
+	///						  it, readable from any thread.
+	/// </summary>
+	struct RtpBlasterStatistics
+	{
+	public:
+		std::atomic<uint64_t> packets = 0;
+
+		// UDP payload, RTP header included
+		std::atomic<uint64_t> octets = 0;
+		std::atomic<uint64_t> system_calls = 0;
+
+		// Refused by the kernel, e.g. ENOBUFS when the interface queue is
+		// full
+		std::atomic<uint64_t> packets_dropped = 0;
+	};
+
+
+	/// <summary>
+	/// RtpBlaster: Sends the streams of a set of SDPs as fast as the
+	///				kernel takes them, to find where a receiver breaks.
+	///				Every stream gets a cycle of valid packets built once:
+	///				a TestPattern frame packed by a PgroupPacker for
+	///				ST 2110-20 video, a 1 kHz tone packed by an AudioPacker
+	///				for ST 2110-30 audio. Sending walks the streams round
+	///				robin, a sendmmsg() of batch_size messages each, with
+	///				only the RTP sequence numbers, timestamps and extended
+	///				sequence numbers rewritten in place; consecutive
+	///				packets of one size share a message as a UDP_SEGMENT
+	///				buffer. Nothing is paced: rates are whatever the host
+	///				and NIC sustain, not the streams' nominal ones.
+	///				Not thread safe: one thread sends. Split the streams
+	///				over several blasters for more threads.
+	/// </summary>
+	class RtpBlaster
+	{
+	public:
+		RtpBlaster(const RtpBlasterSettings& settings = {});
+
+		RtpBlaster(const RtpBlaster&) = delete;
+		RtpBlaster& operator=(const RtpBlaster&) = delete;
+
+		void AddStream(const SDP::VideoDescription& video_description);
+		void AddStream(const SDP::AudioDescription& audio_description);
+
+		/// <summary>
+		/// AddSDP: Adds every video and audio stream of an SDP, e.g. one of
+		///			NmosNodeServer::GetSourceSDPs(). Throws for streams
+		///			that are not uncompressed 2110-20 video or L16/L24
+		///			audio, or whose endpoint is not resolved.
+		/// </summary>
+		void AddSDP(const std::string& sdp);
+
+		/// <summary>
+		/// SendRound: Sends one batch of every stream. Returns the packets
+		///			   sent.
+		/// </summary>
+		uint64_t SendRound();
+
+		size_t GetStreamCount() const { return m_streams.size(); }
+
+		// Off when the settings or the kernel ruled it out
+		bool IsSegmentationOffloaded() const { return m_segmentation_offload; }
+
+		const RtpBlasterStatistics& GetStatistics() const { return m_statistics; }
+
+	private:
+		// Consecutive packets sent as one message, all of segment_octets
+		// but a shorter last one
+		struct Run
+		{
+			uint32_t first_packet;
+			uint32_t packet_count;
+			uint32_t segment_octets;
+		};
+
+		struct Stream
+		{
+			std::unique_ptr<RtpSendSocket> socket;
+
+			// One cycle of packets, back to back: a frame of video, or
+			// a fixed number of audio packets
+			std::vector<uint8_t> packets;
+			std::vector<uint32_t> offsets;		// packet count + 1
+			std::vector<Run> runs;
+			uint32_t next_run = 0;
+
+			// Video timestamps step per cycle (frame), audio timestamps
+			// per packet
+			bool video = false;
+			FrameTiming frame_timing;
+			uint64_t frame_index = 0;
+			uint32_t packet_ticks = 0;
+			uint32_t rtp_offset = 0;
+			uint32_t timestamp = 0;
+
+			// Extended for video, whose payloads carry the high 16 bits
+			uint32_t sequence = 0;
+		};
+
+		RtpSendSocketSettings m_socket_settings;
+		uint32_t m_batch_size;
+		uint32_t m_max_segments;
+		bool m_segmentation_offload;
+
+		std::vector<Stream> m_streams;
+
+		// sendmmsg() headers and the UDP_SEGMENT control message of each
+		std::vector<mmsghdr> m_messages;
+		std::vector<iovec> m_vectors;
+		std::vector<uint8_t> m_controls;
+		std::vector<uint32_t> m_message_packets;
+
+		RtpBlasterStatistics m_statistics;
+
+		// Connects a stream's socket and reserves its cycle of packets
+		Stream& OpenStream(const SDP::MediaDescription& media_description, uint32_t packet_count, uint32_t max_packet_octets);
+
+		// Splits the cycle into runs; with offload off, one per packet
+		void BuildRuns(Stream& stream) const;
+
+		// Writes the next sequence numbers and timestamps into a run
+		void Rewrite(Stream& stream, const Run& run);
+
+		// Moves a stream on to its next cycle, the next frame for video
+		void StartCycle(Stream& stream);
+
+		// Falls back to a packet per message when the kernel or NIC
+		// refuses GSO
+		void DisableSegmentationOffload();
+
+		uint32_t Send(Stream& stream, uint32_t count);
+	};
+}
+#endif
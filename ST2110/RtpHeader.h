@@ -0,0 +1,148 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	namespace RtpDetail
+	{
+		inline void WriteBE16(uint8_t* data, uint16_t value)
+		{
+			data[0] = (uint8_t)(value >> 8);
+			data[1] = (uint8_t)value;
+		}
+
+		inline void WriteBE32(uint8_t* data, uint32_t value)
+		{
+			data[0] = (uint8_t)(value >> 24);
+			data[1] = (uint8_t)(value >> 16);
+			data[2] = (uint8_t)(value >> 8);
+			data[3] = (uint8_t)value;
+		}
+
+		inline uint16_t ReadBE16(const uint8_t* data)
+		{
+			return (uint16_t)((data[0] << 8) | data[1]);
+		}
+
+		inline uint32_t ReadBE32(const uint8_t* data)
+		{
+			return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+		}
+	}
+
+
+	/// <summary>
+	/// RtpHeader: RTP fixed header (RFC 3550 5.1). Written without CSRCs or
+	///			   extension; Read() skips both.
+	/// </summary>
+	struct RtpHeader
+	{
+	public:
+		static constexpr uint32_t OCTETS = 12;
+
+		bool marker = false;
+		uint8_t payload_type = 0;
+		uint16_t sequence_number = 0;
+		uint32_t timestamp = 0;
+		uint32_t ssrc = 0;
+
+		void Write(uint8_t* packet) const
+		{
+			packet[0] = 0x80;
+			packet[1] = (uint8_t)((marker ? 0x80 : 0) | (payload_type & 0x7F));
+			RtpDetail::WriteBE16(packet + 2, sequence_number);
+			RtpDetail::WriteBE32(packet + 4, timestamp);
+			RtpDetail::WriteBE32(packet + 8, ssrc);
+		}
+
+		/// <summary>
+		/// Read: Reads the header of an RTP packet. Returns the offset of
+		///		  the payload, or 0 if the packet is not RTP version 2 or
+		///		  is too short. Padding is not removed.
+		/// </summary>
+		uint32_t Read(const uint8_t* packet, size_t length)
+		{
+			if (length < OCTETS || (packet[0] & 0xC0) != 0x80)
+				return 0;
+
+			marker = (packet[1] & 0x80) != 0;
+			payload_type = packet[1] & 0x7F;
+			sequence_number = RtpDetail::ReadBE16(packet + 2);
+			timestamp = RtpDetail::ReadBE32(packet + 4);
+			ssrc = RtpDetail::ReadBE32(packet + 8);
+
+			uint32_t offset = OCTETS + 4 * (packet[0] & 0x0F);
+			if ((packet[0] & 0x10) != 0)
+			{
+				if (length < offset + 4)
+					return 0;
+
+				offset += 4 + 4 * RtpDetail::ReadBE16(packet + offset + 2);
+			}
+
+			return offset <= length ? offset : 0;
+		}
+	};
+
+
+	/// <summary>
+	/// SampleRowData: Sample row data (SRD) header of a 2110-20 payload
+	///				   (2110-20:2022 6.2, RFC 4175 4.3). The payload starts
+	///				   with the extended sequence number, then one SRD header
+	///				   per line segment, then the segments.
+	/// </summary>
+	struct SampleRowData
+	{
+	public:
+		static constexpr uint32_t OCTETS = 6;
+
+		uint16_t length = 0;		// octets of pgroups
+		uint16_t row = 0;			// line number within the field
+		uint16_t offset = 0;		// pixel offset of the first pgroup
+		bool second_field = false;
+		bool continuation = false;	// another SRD header follows
+
+		void Write(uint8_t* header) const
+		{
+			RtpDetail::WriteBE16(header, length);
+			RtpDetail::WriteBE16(header + 2, (uint16_t)((second_field ? 0x8000 : 0) | (row & 0x7FFF)));
+			RtpDetail::WriteBE16(header + 4, (uint16_t)((continuation ? 0x8000 : 0) | (offset & 0x7FFF)));
+		}
+
+		void Read(const uint8_t* header)
+		{
+			length = RtpDetail::ReadBE16(header);
+
+			uint16_t row_field = RtpDetail::ReadBE16(header + 2);
+			second_field = (row_field & 0x8000) != 0;
+			row = row_field & 0x7FFF;
+
+			uint16_t offset_continuation = RtpDetail::ReadBE16(header + 4);
+			continuation = (offset_continuation & 0x8000) != 0;
+			offset = offset_continuation & 0x7FFF;
+		}
+	};
+}
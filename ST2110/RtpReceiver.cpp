@@ -0,0 +1,146 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+#ifdef ST2110_LINUX
+namespace Cf
+{
+	namespace
+	{
+		using namespace RuntimeDetail;
+
+		// A blocked receive thread notices Stop() within this time
+		constexpr int32_t RECEIVE_TIMEOUT_MS = 100;
+	}
+
+
+	RtpReceiver::RtpReceiver(const SDP::MediaDescription& media_description, const RtpReceiverSettings& settings)
+		: m_socket(media_description.endpoint, settings.socket), m_ring(settings.slot_count, settings.slot_octets),
+		  m_batch_size(std::min(settings.batch_size, settings.slot_count))
+	{
+		if (m_batch_size == 0)
+			throw std::runtime_error("RtpReceiver: Batch size must not be zero");
+
+		timeval timeout = { 0, RECEIVE_TIMEOUT_MS * 1000 };
+		if (setsockopt(m_socket.GetDescriptor(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) != 0)
+			ThrowSystemError("RtpReceiver", "SO_RCVTIMEO");
+
+		m_messages.resize(m_batch_size);
+		m_vectors.resize(m_batch_size);
+
+		PLOG_INFO << "RtpReceiver: " << m_ring.GetSlotCount() << " slots of " << m_ring.GetSlotOctets()
+			<< " octets, batches of " << m_batch_size;
+	}
+
+	RtpReceiver::~RtpReceiver()
+	{
+		Stop();
+	}
+
+	void RtpReceiver::Start()
+	{
+		if (m_running.exchange(true))
+			return;
+
+		m_thread = std::thread([this]()
+		{
+			try
+			{
+				while (m_running.load(std::memory_order_relaxed))
+					ReceiveBatch();
+			}
+			catch (const std::exception& exception)
+			{
+				PLOG_ERROR << exception.what();
+				m_running.store(false);
+			}
+		});
+	}
+
+	void RtpReceiver::Stop()
+	{
+		m_running.store(false);
+		if (m_thread.joinable())
+			m_thread.join();
+	}
+
+	uint32_t RtpReceiver::ReceiveBatch()
+	{
+		// Point the headers at the free slots, in ring order
+		uint32_t free_slots = 0;
+		for (; free_slots < m_batch_size; free_slots++)
+		{
+			PacketSlot* slot = m_ring.GetFreeSlot(free_slots);
+			if (slot == nullptr)
+				break;
+
+			m_vectors[free_slots] = { slot->data, m_ring.GetSlotOctets() };
+
+			msghdr& header = m_messages[free_slots].msg_hdr;
+			header = {};
+			header.msg_name = &slot->source;
+			header.msg_namelen = sizeof(slot->source);
+			header.msg_iov = &m_vectors[free_slots];
+			header.msg_iovlen = 1;
+		}
+
+		// Consumers are behind; leave the packets in the socket buffer
+		if (free_slots == 0)
+		{
+			RelaxedAdd(m_statistics.ring_full, 1);
+			std::this_thread::yield();
+			return 0;
+		}
+
+		// Block for the first datagram only, then take what is queued
+		int32_t received = recvmmsg(m_socket.GetDescriptor(), m_messages.data(), free_slots, MSG_WAITFORONE, nullptr);
+		RelaxedAdd(m_statistics.system_calls, 1);
+
+		if (received <= 0)
+		{
+			if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+				ThrowSystemError("RtpReceiver", "recvmmsg");
+			return 0;
+		}
+
+		uint32_t truncated = 0;
+		for (int32_t i = 0; i < received; i++)
+		{
+			PacketSlot* slot = m_ring.GetFreeSlot(i);
+			slot->octets = std::min(m_messages[i].msg_len, m_ring.GetSlotOctets());
+			slot->truncated = (m_messages[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+			truncated += slot->truncated;
+		}
+
+		m_ring.Publish(received);
+
+		RelaxedAdd(m_statistics.packets, received);
+		if (truncated != 0)
+			RelaxedAdd(m_statistics.truncated, truncated);
+
+		return received;
+	}
+}
+#endif
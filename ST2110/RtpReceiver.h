@@ -0,0 +1,124 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+#ifdef ST2110_LINUX
+namespace Cf
+{
+	/// <summary>
+	/// RtpReceiverSettings: Socket, ring and batch sizes of an RtpReceiver.
+	/// </summary>
+	struct RtpReceiverSettings
+	{
+	public:
+		RtpSocketSettings socket;
+
+		// Ring slots, a power of two. 8192 slots hold about 2 ms of a
+		// 1080p60 2110-20 stream.
+		uint32_t slot_count = 8192;
+
+		// Largest datagram kept whole; 2110 senders stay under a 1500
+		// octet MTU
+		uint32_t slot_octets = 2048;
+
+		// Datagrams asked of each recvmmsg() call
+		uint32_t batch_size = 64;
+	};
+
+
+	/// <summary>
+	/// RtpReceiverStatistics: Counters of the receive thread. Written only
+	///						   by it, readable from any thread.
+	/// </summary>
+	struct RtpReceiverStatistics
+	{
+	public:
+		std::atomic<uint64_t> packets = 0;
+		std::atomic<uint64_t> system_calls = 0;
+
+		// Times the ring had no free slot, so the socket buffer had to
+		// absorb the burst
+		std::atomic<uint64_t> ring_full = 0;
+
+		// Datagrams larger than a slot
+		std::atomic<uint64_t> truncated = 0;
+	};
+
+
+	/// <summary>
+	/// RtpReceiver: Receives the RTP stream of one media description with
+	///				 recvmmsg() straight into the slots of a PacketRing, so
+	///				 one system call moves a whole batch of packets and no
+	///				 packet is copied or allocated. Any number of consumer
+	///				 threads take packets from the ring without locks.
+	/// </summary>
+	class RtpReceiver
+	{
+	public:
+		RtpReceiver(const SDP::MediaDescription& media_description, const RtpReceiverSettings& settings = {});
+		~RtpReceiver();
+
+		RtpReceiver(const RtpReceiver&) = delete;
+		RtpReceiver& operator=(const RtpReceiver&) = delete;
+
+		/// <summary>
+		/// Start: Runs ReceiveBatch() on a receive thread until Stop().
+		/// </summary>
+		void Start();
+		void Stop();
+
+		/// <summary>
+		/// ReceiveBatch: Waits for at least one datagram and moves every
+		///				  queued datagram, up to the batch size and the free
+		///				  slots, into the ring. Returns the packets received,
+		///				  0 on timeout or a full ring. Only one thread may
+		///				  call it, and not while the receive thread runs.
+		/// </summary>
+		uint32_t ReceiveBatch();
+
+		// Consumer side, see PacketRing
+		PacketSlot* TryAcquire() { return m_ring.TryAcquire(); }
+		void Release(PacketSlot* slot) { m_ring.Release(slot); }
+
+		PacketRing& GetRing() { return m_ring; }
+		const RtpSocket& GetSocket() const { return m_socket; }
+		const RtpReceiverStatistics& GetStatistics() const { return m_statistics; }
+
+	private:
+		RtpSocket m_socket;
+		PacketRing m_ring;
+		uint32_t m_batch_size;
+
+		// recvmmsg() headers, pointed at the ring slots before each call
+		std::vector<mmsghdr> m_messages;
+		std::vector<iovec> m_vectors;
+
+		RtpReceiverStatistics m_statistics;
+
+		std::thread m_thread;
+		std::atomic<bool> m_running = false;
+	};
+}
+#endif
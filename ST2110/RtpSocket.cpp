@@ -0,0 +1,246 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+#ifdef ST2110_LINUX
+namespace Cf
+{
+	namespace
+	{
+		using namespace RuntimeDetail;
+
+		void CopyAddress(const SDP::SocketAddress& address, int32_t family, sockaddr_storage* storage_ptr)
+		{
+			std::memset(storage_ptr, 0, sizeof(sockaddr_storage));
+			std::memcpy(storage_ptr, &address, family == AF_INET6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in));
+		}
+	}
+
+
+	RtpSocket::RtpSocket(const SDP::Endpoint& endpoint, const RtpSocketSettings& settings)
+		: m_endpoint(endpoint)
+	{
+		if (!endpoint.IsResolved())
+			throw std::runtime_error("RtpSocket: Endpoint is not resolved");
+
+		uint32_t interface_index = 0;
+		if (!settings.interface_name.empty())
+		{
+			interface_index = if_nametoindex(settings.interface_name.c_str());
+			if (interface_index == 0)
+				ThrowSystemError("RtpSocket", ("Unknown interface " + settings.interface_name).c_str());
+		}
+
+		m_descriptor = socket(endpoint.family, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP);
+		if (m_descriptor < 0)
+			ThrowSystemError("RtpSocket", "socket");
+
+		try
+		{
+			int32_t enable = 1;
+			if (setsockopt(m_descriptor, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) != 0)
+				ThrowSystemError("RtpSocket", "SO_REUSEADDR");
+
+			// Best effort; GetReceiveBufferOctets() tells what was granted
+			int32_t buffer_octets = settings.receive_buffer_octets;
+			setsockopt(m_descriptor, SOL_SOCKET, SO_RCVBUF, &buffer_octets, sizeof(buffer_octets));
+
+			// Bind the group itself so other groups on the same port are not
+			// delivered here; unicast binds every local address
+			SDP::SocketAddress bind_address = {};
+			if (endpoint.family == AF_INET6)
+			{
+				bind_address.ipv6.sin6_family = AF_INET6;
+				bind_address.ipv6.sin6_port = endpoint.address.ipv6.sin6_port;
+				if (endpoint.multicast)
+					bind_address.ipv6.sin6_addr = endpoint.address.ipv6.sin6_addr;
+			}
+			else
+			{
+				bind_address.ipv4.sin_family = AF_INET;
+				bind_address.ipv4.sin_port = endpoint.address.ipv4.sin_port;
+				bind_address.ipv4.sin_addr.s_addr = endpoint.multicast ? endpoint.address.ipv4.sin_addr.s_addr : htonl(INADDR_ANY);
+			}
+
+			if (bind(m_descriptor, &bind_address.generic, endpoint.GetSockAddrLength()) != 0)
+				ThrowSystemError("RtpSocket", "bind");
+
+			if (endpoint.multicast)
+				Join(interface_index);
+		}
+		catch (...)
+		{
+			close(m_descriptor);
+			throw;
+		}
+
+		PLOG_INFO << "RtpSocket: Bound port " << endpoint.GetPort() << (endpoint.multicast ? " and joined multicast group" : "")
+			<< (endpoint.sources.empty() ? "" : endpoint.exclude_sources ? " excluding " : " from ")
+			<< (endpoint.sources.empty() ? "" : std::to_string(endpoint.sources.size()) + " sources")
+			<< ", receive buffer " << GetReceiveBufferOctets() << " octets";
+	}
+
+	RtpSocket::~RtpSocket()
+	{
+		if (m_descriptor >= 0)
+			close(m_descriptor);
+	}
+
+	int32_t RtpSocket::GetReceiveBufferOctets() const
+	{
+		int32_t buffer_octets = 0;
+		socklen_t length = sizeof(buffer_octets);
+		getsockopt(m_descriptor, SOL_SOCKET, SO_RCVBUF, &buffer_octets, &length);
+		return buffer_octets;
+	}
+
+	/// <summary>
+	/// Join: Joins the endpoint's group with the protocol independent
+	///		  (RFC 3678) options, which take IPv4 and IPv6 alike.
+	/// </summary>
+	void RtpSocket::Join(uint32_t interface_index)
+	{
+		int32_t level = m_endpoint.family == AF_INET6 ? IPPROTO_IPV6 : IPPROTO_IP;
+
+		// Only deliver the groups joined on this socket, not every group
+		// joined on the host with this port
+		int32_t disable = 0;
+		if (m_endpoint.family == AF_INET)
+			setsockopt(m_descriptor, IPPROTO_IP, IP_MULTICAST_ALL, &disable, sizeof(disable));
+
+		// Source specific: one (S,G) join per included source
+		if (!m_endpoint.sources.empty() && !m_endpoint.exclude_sources)
+		{
+			for (const SDP::SocketAddress& source : m_endpoint.sources)
+			{
+				group_source_req request = {};
+				request.gsr_interface = interface_index;
+				CopyAddress(m_endpoint.address, m_endpoint.family, &request.gsr_group);
+				CopyAddress(source, m_endpoint.family, &request.gsr_source);
+
+				if (setsockopt(m_descriptor, level, MCAST_JOIN_SOURCE_GROUP, &request, sizeof(request)) != 0)
+					ThrowSystemError("RtpSocket", "MCAST_JOIN_SOURCE_GROUP");
+			}
+			return;
+		}
+
+		group_req request = {};
+		request.gr_interface = interface_index;
+		CopyAddress(m_endpoint.address, m_endpoint.family, &request.gr_group);
+
+		if (setsockopt(m_descriptor, level, MCAST_JOIN_GROUP, &request, sizeof(request)) != 0)
+			ThrowSystemError("RtpSocket", "MCAST_JOIN_GROUP");
+
+		// Any source multicast, less the excluded sources
+		for (const SDP::SocketAddress& source : m_endpoint.sources)
+		{
+			group_source_req block = {};
+			block.gsr_interface = interface_index;
+			CopyAddress(m_endpoint.address, m_endpoint.family, &block.gsr_group);
+			CopyAddress(source, m_endpoint.family, &block.gsr_source);
+
+			if (setsockopt(m_descriptor, level, MCAST_BLOCK_SOURCE, &block, sizeof(block)) != 0)
+				ThrowSystemError("RtpSocket", "MCAST_BLOCK_SOURCE");
+		}
+	}
+
+
+	RtpSendSocket::RtpSendSocket(const SDP::Endpoint& endpoint, const RtpSendSocketSettings& settings)
+		: m_endpoint(endpoint)
+	{
+		if (!endpoint.IsResolved())
+			throw std::runtime_error("RtpSendSocket: Endpoint is not resolved");
+
+		uint32_t interface_index = 0;
+		if (!settings.interface_name.empty())
+		{
+			interface_index = if_nametoindex(settings.interface_name.c_str());
+			if (interface_index == 0)
+				ThrowSystemError("RtpSendSocket", ("Unknown interface " + settings.interface_name).c_str());
+		}
+
+		m_descriptor = socket(endpoint.family, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP);
+		if (m_descriptor < 0)
+			ThrowSystemError("RtpSendSocket", "socket");
+
+		try
+		{
+			// Best effort, like the receive buffer
+			int32_t buffer_octets = settings.send_buffer_octets;
+			setsockopt(m_descriptor, SOL_SOCKET, SO_SNDBUF, &buffer_octets, sizeof(buffer_octets));
+
+			if (endpoint.multicast)
+				SetMulticastOptions(interface_index, settings);
+
+			// Connected, so sends need no address and the route is looked
+			// up once
+			if (connect(m_descriptor, endpoint.GetSockAddr(), endpoint.GetSockAddrLength()) != 0)
+				ThrowSystemError("RtpSendSocket", "connect");
+		}
+		catch (...)
+		{
+			close(m_descriptor);
+			throw;
+		}
+
+		PLOG_INFO << "RtpSendSocket: Connected to port " << endpoint.GetPort() << (endpoint.multicast ? " of a multicast group" : "")
+			<< (settings.interface_name.empty() ? "" : " on " + settings.interface_name);
+	}
+
+	RtpSendSocket::~RtpSendSocket()
+	{
+		if (m_descriptor >= 0)
+			close(m_descriptor);
+	}
+
+	void RtpSendSocket::SetMulticastOptions(uint32_t interface_index, const RtpSendSocketSettings& settings)
+	{
+		int32_t loop = settings.multicast_loop ? 1 : 0;
+
+		if (m_endpoint.family == AF_INET6)
+		{
+			if (interface_index != 0 && setsockopt(m_descriptor, IPPROTO_IPV6, IPV6_MULTICAST_IF, &interface_index, sizeof(interface_index)) != 0)
+				ThrowSystemError("RtpSendSocket", "IPV6_MULTICAST_IF");
+
+			setsockopt(m_descriptor, IPPROTO_IPV6, IPV6_MULTICAST_LOOP, &loop, sizeof(loop));
+			return;
+		}
+
+		if (interface_index != 0)
+		{
+			ip_mreqn request = {};
+			request.imr_ifindex = (int32_t)interface_index;
+			if (setsockopt(m_descriptor, IPPROTO_IP, IP_MULTICAST_IF, &request, sizeof(request)) != 0)
+				ThrowSystemError("RtpSendSocket", "IP_MULTICAST_IF");
+		}
+
+		// "c=" without a TTL keeps the kernel default of 1
+		if (m_endpoint.ttl > 0 && setsockopt(m_descriptor, IPPROTO_IP, IP_MULTICAST_TTL, &m_endpoint.ttl, sizeof(m_endpoint.ttl)) != 0)
+			ThrowSystemError("RtpSendSocket", "IP_MULTICAST_TTL");
+
+		setsockopt(m_descriptor, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+	}
+}
+#endif
@@ -0,0 +1,119 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+#ifdef ST2110_LINUX
+namespace Cf
+{
+	/// <summary>
+	/// RtpSocketSettings: Receive socket options shared by the receive
+	///					   backends.
+	/// </summary>
+	struct RtpSocketSettings
+	{
+	public:
+		// Interface that joins the multicast group, e.g. "eth1" or "lo".
+		// Empty lets the kernel pick it from the routing table.
+		std::string interface_name;
+
+		// SO_RCVBUF request. The kernel caps it at net.core.rmem_max.
+		int32_t receive_buffer_octets = 64 * 1024 * 1024;
+	};
+
+
+	/// <summary>
+	/// RtpSocket: UDP socket bound and joined from a media description's
+	///			   resolved endpoint: binds the "m=" port, joins the "c="
+	///			   multicast group and applies "a=source-filter:" (SSM
+	///			   sources for incl, blocked sources for excl). Closes the
+	///			   socket, and so leaves the group, on destruction.
+	/// </summary>
+	class RtpSocket
+	{
+	public:
+		RtpSocket(const SDP::Endpoint& endpoint, const RtpSocketSettings& settings = {});
+		~RtpSocket();
+
+		RtpSocket(const RtpSocket&) = delete;
+		RtpSocket& operator=(const RtpSocket&) = delete;
+
+		int32_t GetDescriptor() const { return m_descriptor; }
+		const SDP::Endpoint& GetEndpoint() const { return m_endpoint; }
+
+		// SO_RCVBUF as granted by the kernel (twice the usable octets)
+		int32_t GetReceiveBufferOctets() const;
+
+	private:
+		SDP::Endpoint m_endpoint;
+		int32_t m_descriptor = -1;
+
+		void Join(uint32_t interface_index);
+	};
+
+
+	/// <summary>
+	/// RtpSendSocketSettings: Send socket options shared by the senders.
+	/// </summary>
+	struct RtpSendSocketSettings
+	{
+	public:
+		// Interface multicast is sent on, e.g. "eth1" or "lo". Empty lets
+		// the kernel pick it from the routing table.
+		std::string interface_name;
+
+		// SO_SNDBUF request. The kernel caps it at net.core.wmem_max.
+		int32_t send_buffer_octets = 4 * 1024 * 1024;
+
+		// Deliver multicast to receivers on this host as well
+		bool multicast_loop = true;
+	};
+
+
+	/// <summary>
+	/// RtpSendSocket: UDP socket connected to a media description's
+	///				   resolved endpoint, the "c=" address and "m=" port.
+	///				   Multicast goes out on the chosen interface with the
+	///				   "c=" TTL. Closes the socket on destruction.
+	/// </summary>
+	class RtpSendSocket
+	{
+	public:
+		RtpSendSocket(const SDP::Endpoint& endpoint, const RtpSendSocketSettings& settings = {});
+		~RtpSendSocket();
+
+		RtpSendSocket(const RtpSendSocket&) = delete;
+		RtpSendSocket& operator=(const RtpSendSocket&) = delete;
+
+		int32_t GetDescriptor() const { return m_descriptor; }
+		const SDP::Endpoint& GetEndpoint() const { return m_endpoint; }
+
+	private:
+		SDP::Endpoint m_endpoint;
+		int32_t m_descriptor = -1;
+
+		void SetMulticastOptions(uint32_t interface_index, const RtpSendSocketSettings& settings);
+	};
+}
+#endif
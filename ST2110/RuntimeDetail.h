@@ -0,0 +1,51 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	namespace RuntimeDetail
+	{
+		// Statistics counters have one writer, so they need no atomic
+		// read-modify-write. Relaxed loads from other threads still see
+		// whole values.
+		inline void RelaxedAdd(std::atomic<uint64_t>& counter, uint64_t value)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		inline void RelaxedSubtract(std::atomic<uint64_t>& counter, uint64_t value)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) - value, std::memory_order_relaxed);
+		}
+
+		// Throws "<owner>: <what>: <error text>" for a failed system call.
+		// The error defaults to errno; io_uring reports it as -res instead.
+		[[noreturn]] inline void ThrowSystemError(const char* owner, const char* what, int32_t error = errno)
+		{
+			throw std::runtime_error(std::string(owner) + ": " + what + ": " + std::strerror(error));
+		}
+	}
+}
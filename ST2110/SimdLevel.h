@@ -0,0 +1,82 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	// Instruction set of a kernel, in increasing order
+	enum class SimdLevel : uint8_t
+	{
+		SCALAR,
+		SSE41,	// SSSE3 + SSE4.1
+		AVX2
+	};
+
+	constexpr const char* SimdLevelName(SimdLevel simd_level)
+	{
+		switch (simd_level)
+		{
+		case SimdLevel::SSE41: return "sse4.1";
+		case SimdLevel::AVX2: return "avx2";
+		default: return "scalar";
+		}
+	}
+
+
+	/// <summary>
+	/// DetectSimdLevel: Highest SimdLevel the running CPU and OS support.
+	///					 Kernels are chosen from it once, at activation.
+	/// </summary>
+	inline SimdLevel DetectSimdLevel()
+	{
+#if defined(ST2110_X86) && defined(_MSC_VER) && !defined(__clang__)
+		int32_t info[4];
+		__cpuid(info, 1);
+
+		bool sse41 = (info[2] & (1 << 19)) != 0;
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+
+		// AVX2 also needs the OS to save the YMM registers
+		bool ymm = osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+
+		__cpuidex(info, 7, 0);
+		bool avx2 = (info[1] & (1 << 5)) != 0;
+
+		if (ymm && avx2)
+			return SimdLevel::AVX2;
+		if (sse41)
+			return SimdLevel::SSE41;
+#elif defined(ST2110_X86)
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx2"))
+			return SimdLevel::AVX2;
+		if (__builtin_cpu_supports("sse4.1"))
+			return SimdLevel::SSE41;
+#endif
+		return SimdLevel::SCALAR;
+	}
+}
@@ -0,0 +1,194 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+namespace Cf
+{
+	namespace
+	{
+		// Linear R'G'B' of the 75% bars, left to right
+		constexpr double BARS[7][3] =
+		{
+			{ 0.75, 0.75, 0.75 }, { 0.75, 0.75, 0 }, { 0, 0.75, 0.75 }, { 0, 0.75, 0 },
+			{ 0.75, 0, 0.75 }, { 0.75, 0, 0 }, { 0, 0, 0.75 }
+		};
+
+		// Luma coefficients of the colour difference encodings
+		void GetLumaCoefficients(SDPColorimetry colorimetry, double* kr, double* kb)
+		{
+			switch (colorimetry)
+			{
+			case SDPColorimetry::BT601:
+				*kr = 0.299;
+				*kb = 0.114;
+				break;
+			case SDPColorimetry::BT2020:
+			case SDPColorimetry::BT2100:
+				*kr = 0.2627;
+				*kb = 0.0593;
+				break;
+			default:
+				*kr = 0.2126;
+				*kb = 0.0722;
+				break;
+			}
+		}
+
+		// Picture line rounded down to a whole pgroup row
+		uint32_t AlignLine(const VideoFormat& format, uint32_t line)
+		{
+			return line / format.pgroup_lines * format.pgroup_lines;
+		}
+	}
+
+
+	TestPattern::TestPattern(const VideoFormat& format)
+		: m_format(format), m_layout(format, PixelFormat::PLANAR)
+	{
+		if (format.GetDepth() == SDPDepth::FLOAT_16)
+			throw std::runtime_error("TestPattern: Floating point samples are not supported");
+
+		SDPSampling sampling = format.GetSampling();
+		m_rgb = sampling == SDPSampling::RGB || sampling == SDPSampling::XYZ;
+		GetLumaCoefficients(format.GetColorimetry(), &m_kr, &m_kb);
+
+		m_buffer.resize(m_layout.size);
+		m_planes = m_layout.GetPlanes(m_buffer.data());
+
+		m_ramp_line = AlignLine(format, format.height * 2 / 3);
+		m_counter_line = GetCounterLine(format);
+
+		uint32_t width = format.width;
+		DrawBand(0, m_ramp_line, [&](uint32_t x)
+		{
+			const double* bar = BARS[x * 7 / width];
+			return ToPixel(bar[0], bar[1], bar[2]);
+		});
+	}
+
+	const FramePlanes& TestPattern::Render(uint64_t frame_index)
+	{
+		// Everything drawn follows from the counter, so a receiver can draw
+		// the frame it should have got from the counter it read
+		uint32_t counter = (uint32_t)frame_index;
+		uint32_t width = m_format.width;
+		uint32_t shift = (uint32_t)((uint64_t)counter * RAMP_STEP % width);
+		DrawBand(m_ramp_line, m_counter_line, [&](uint32_t x)
+		{
+			double level = (double)((x + shift) % width) / std::max(width - 1, 1u);
+			return ToPixel(level, level, level);
+		});
+
+		DrawBand(m_counter_line, m_format.height, [&](uint32_t x)
+		{
+			uint32_t bit = COUNTER_BITS - 1 - x * COUNTER_BITS / width;
+			double level = (counter >> bit) & 1 ? 1.0 : 0.0;
+			return ToPixel(level, level, level);
+		});
+
+		return m_planes;
+	}
+
+	uint32_t TestPattern::ReadCounter(const VideoFormat& format, const FramePlanes& frame)
+	{
+		const uint8_t* line = frame.data[0] + (size_t)frame.strides[0] * ((GetCounterLine(format) + format.height) / 2);
+
+		// Halfway between the black and white code values of either range
+		uint32_t threshold = 1u << (format.depth_bits - 1);
+
+		uint32_t counter = 0;
+		for (uint32_t bit = 0; bit < COUNTER_BITS; bit++)
+		{
+			uint32_t x = (uint32_t)(((uint64_t)bit * 2 + 1) * format.width / (COUNTER_BITS * 2));
+			uint32_t value = format.depth_bits == 8 ? line[x] : ((const uint16_t*)line)[x];
+			counter = (counter << 1) | (value >= threshold ? 1 : 0);
+		}
+
+		return counter;
+	}
+
+	uint32_t TestPattern::GetCounterLine(const VideoFormat& format)
+	{
+		return AlignLine(format, format.height * 5 / 6);
+	}
+
+	TestPattern::Pixel TestPattern::ToPixel(double r, double g, double b) const
+	{
+		uint32_t bits = m_format.depth_bits;
+		double max = (double)((1u << bits) - 1);
+		bool narrow = m_format.GetRange() == SDPRange::NARROW;
+		double scale = (double)(1u << (bits - 8));
+
+		auto luma = [&](double value)
+		{
+			double code = narrow ? (16 + 219 * value) * scale : value * max;
+			return (uint16_t)std::clamp(std::lround(code), 0l, (long)max);
+		};
+		auto chroma = [&](double value)
+		{
+			double code = narrow ? (128 + 224 * value) * scale : (1u << (bits - 1)) + value * max;
+			return (uint16_t)std::clamp(std::lround(code), 0l, (long)max);
+		};
+
+		if (m_rgb)
+			return { luma(r), luma(g), luma(b) };
+
+		double y = m_kr * r + (1 - m_kr - m_kb) * g + m_kb * b;
+		return { luma(y), chroma((b - y) / (2 * (1 - m_kb))), chroma((r - y) / (2 * (1 - m_kr))) };
+	}
+
+	template<typename PixelAt>
+	void TestPattern::DrawBand(uint32_t first_line, uint32_t end_line, PixelAt pixel_at)
+	{
+		if (first_line >= end_line)
+			return;
+
+		bool wide = m_format.depth_bits > 8;
+		uint32_t chroma_step = m_format.GetChroma() == SDPChroma::C444 ? 1 : 2;
+		uint32_t chroma_lines = m_format.GetChroma() == SDPChroma::C420 ? 2 : 1;
+
+		for (uint32_t plane = 0; plane < m_layout.plane_count; plane++)
+		{
+			uint32_t step = plane == 0 ? 1 : chroma_step;
+			uint32_t line_step = plane == 0 ? 1 : chroma_lines;
+			uint32_t samples = m_layout.line_bytes[plane] / (wide ? 2 : 1);
+
+			// First line of the band in this plane, drawn sample by sample
+			uint8_t* first = m_planes.data[plane] + (size_t)m_planes.strides[plane] * (first_line / line_step);
+			for (uint32_t i = 0; i < samples; i++)
+			{
+				uint32_t x = std::min(i * step, m_format.width - 1);
+				uint16_t value = pixel_at(x)[plane];
+				if (wide)
+					((uint16_t*)first)[i] = value;
+				else
+					first[i] = (uint8_t)value;
+			}
+
+			for (uint32_t line = first_line / line_step + 1; line < (end_line + line_step - 1) / line_step; line++)
+				std::memcpy(m_planes.data[plane] + (size_t)m_planes.strides[plane] * line, first, m_layout.line_bytes[plane]);
+		}
+	}
+}
@@ -0,0 +1,91 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+namespace Cf
+{
+	/// <summary>
+	/// TestPattern: Test signal for a video format, rendered into a PLANAR
+	///				 frame it owns. From the top: 75% colour bars (white,
+	///				 yellow, cyan, green, magenta, red, blue), a luma ramp
+	///				 that moves along the line by RAMP_STEP pixels per
+	///				 frame, and the frame index as 32 black and white
+	///				 blocks, most significant bit first, so a receiver can
+	///				 read back which frame it got and draw the frame it
+	///				 should have got. The bars are drawn once; Render()
+	///				 only redraws the ramp and counter bands, a line each
+	///				 and copies.
+	/// </summary>
+	class TestPattern
+	{
+	public:
+		static constexpr uint32_t RAMP_STEP = 4;
+		static constexpr uint32_t COUNTER_BITS = 32;
+
+		explicit TestPattern(const VideoFormat& format);
+
+		/// <summary>
+		/// Render: Draws frame n and returns its planes. The planes stay
+		///			valid, and unchanged, until the next Render().
+		/// </summary>
+		const FramePlanes& Render(uint64_t frame_index);
+
+		/// <summary>
+		/// ReadCounter: The frame index drawn into the counter band of a
+		///				 PLANAR frame of the format, read back from the
+		///				 middle of each block's luma.
+		/// </summary>
+		static uint32_t ReadCounter(const VideoFormat& format, const FramePlanes& frame);
+
+		const VideoFormat& GetFormat() const { return m_format; }
+		const FrameLayout& GetLayout() const { return m_layout; }
+
+	private:
+		// Code values of one pixel, Y/Cb/Cr or R/G/B
+		using Pixel = std::array<uint16_t, 3>;
+
+		VideoFormat m_format;
+		FrameLayout m_layout;
+		std::vector<uint8_t> m_buffer;
+		FramePlanes m_planes;
+
+		// Picture lines where the ramp and counter bands start
+		uint32_t m_ramp_line = 0;
+		uint32_t m_counter_line = 0;
+
+		bool m_rgb = false;
+		double m_kr = 0;
+		double m_kb = 0;
+
+		Pixel ToPixel(double r, double g, double b) const;
+
+		// Draws one picture line of every plane from a pixel per column,
+		// then repeats it over the band's lines
+		template<typename PixelAt>
+		void DrawBand(uint32_t first_line, uint32_t end_line, PixelAt pixel_at);
+
+		static uint32_t GetCounterLine(const VideoFormat& format);
+	};
+}
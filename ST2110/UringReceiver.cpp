@@ -0,0 +1,421 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+#ifdef ST2110_LINUX
+namespace Cf
+{
+	namespace
+	{
+		using namespace RuntimeDetail;
+
+		constexpr uint32_t SUBMISSION_ENTRIES = 256;
+
+		// The kernel writes this ahead of each datagram in a buffer, then
+		// the source address
+		constexpr uint32_t RECVMSG_HEADER_OCTETS = sizeof(io_uring_recvmsg_out) + sizeof(SDP::SocketAddress);
+
+		int32_t Setup(uint32_t entries, io_uring_params* params_ptr)
+		{
+			return (int32_t)syscall(__NR_io_uring_setup, entries, params_ptr);
+		}
+
+		int32_t Enter(int32_t ring_descriptor, uint32_t to_submit, uint32_t min_complete, uint32_t flags, const void* argument, size_t argument_octets)
+		{
+			return (int32_t)syscall(__NR_io_uring_enter, ring_descriptor, to_submit, min_complete, flags, argument, argument_octets);
+		}
+
+		int32_t Register(int32_t ring_descriptor, uint32_t opcode, const void* argument, uint32_t argument_count)
+		{
+			return (int32_t)syscall(__NR_io_uring_register, ring_descriptor, opcode, argument, argument_count);
+		}
+
+		void* Map(size_t octets, int32_t descriptor, off_t offset)
+		{
+			void* address = mmap(nullptr, octets, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor, offset);
+			if (address == MAP_FAILED)
+				ThrowSystemError("UringReceiver", "mmap");
+			return address;
+		}
+
+		template<typename T>
+		T* At(void* map, uint32_t offset)
+		{
+			return (T*)((uint8_t*)map + offset);
+		}
+
+		// Ring indices shared with the kernel
+		uint32_t LoadAcquire(const uint32_t* index)
+		{
+			return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+		}
+
+		void StoreRelease(uint32_t* index, uint32_t value)
+		{
+			__atomic_store_n(index, value, __ATOMIC_RELEASE);
+		}
+	}
+
+
+	/// <summary>
+	/// Stream: Socket, handler and provided buffer ring of one stream. The
+	///			buffer group id is the stream index.
+	/// </summary>
+	struct UringReceiver::Stream
+	{
+	public:
+		Stream(const SDP::Endpoint& endpoint, const RtpSocketSettings& settings, UringPacketHandler packet_handler)
+			: socket(endpoint, settings), handler(std::move(packet_handler))
+		{
+		}
+
+		~Stream()
+		{
+			if (ring != nullptr)
+				munmap(ring, ring_octets);
+			if (buffers != nullptr)
+				munmap(buffers, buffers_octets);
+		}
+
+		RtpSocket socket;
+		UringPacketHandler handler;
+
+		// Read by the kernel for every datagram of the multishot request;
+		// only the name and control lengths are used
+		msghdr header = {};
+
+		// io_uring_buf_ring, addressed as plain entries: the flexible array
+		// of the header lays out differently in C++. The kernel reads the
+		// tail from the resv field of the first entry.
+		io_uring_buf* ring = nullptr;
+		size_t ring_octets = 0;
+		uint16_t ring_tail = 0;
+
+		void PublishTail()
+		{
+			__atomic_store_n(&ring[0].resv, ring_tail, __ATOMIC_RELEASE);
+		}
+
+		uint8_t* buffers = nullptr;
+		size_t buffers_octets = 0;
+	};
+
+
+	UringReceiver::UringReceiver(const UringReceiverSettings& settings)
+		: m_settings(settings)
+	{
+		if (settings.buffer_count == 0 || settings.buffer_count > 32768 || (settings.buffer_count & (settings.buffer_count - 1)) != 0)
+			throw std::runtime_error("UringReceiver: Buffer count must be a power of two up to 32768");
+
+		if (settings.buffer_octets <= RECVMSG_HEADER_OCTETS)
+			throw std::runtime_error("UringReceiver: Buffers are too small for the recvmsg header");
+
+		// The ring starts disabled so that the receive thread, not this
+		// one, becomes its only submitter (Receive() enables it)
+		io_uring_params params = {};
+		params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_R_DISABLED | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+		params.cq_entries = settings.completion_entries;
+
+		m_ring_descriptor = Setup(SUBMISSION_ENTRIES, &params);
+		if (m_ring_descriptor < 0 && errno == EINVAL)
+		{
+			// Before Linux 6.1: completions run as task work instead
+			params = {};
+			params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_R_DISABLED;
+			params.cq_entries = settings.completion_entries;
+			m_ring_descriptor = Setup(SUBMISSION_ENTRIES, &params);
+		}
+
+		if (m_ring_descriptor < 0)
+			ThrowSystemError("UringReceiver", "io_uring_setup");
+
+		m_setup_flags = params.flags;
+
+		try
+		{
+			if ((params.features & IORING_FEAT_EXT_ARG) == 0)
+				throw std::runtime_error("UringReceiver: Kernel does not support io_uring wait timeouts");
+
+			// Submission and completion rings share one map on 5.4 and later
+			m_submission_map_octets = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+			m_completion_map_octets = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+			if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+				m_submission_map_octets = m_completion_map_octets = std::max(m_submission_map_octets, m_completion_map_octets);
+
+			m_submission_map = Map(m_submission_map_octets, m_ring_descriptor, IORING_OFF_SQ_RING);
+			m_completion_map = (params.features & IORING_FEAT_SINGLE_MMAP) != 0 ? m_submission_map : Map(m_completion_map_octets, m_ring_descriptor, IORING_OFF_CQ_RING);
+
+			m_entries_octets = params.sq_entries * sizeof(io_uring_sqe);
+			m_entries = (io_uring_sqe*)Map(m_entries_octets, m_ring_descriptor, IORING_OFF_SQES);
+
+			m_submission_tail = At<uint32_t>(m_submission_map, params.sq_off.tail);
+			m_submission_array = At<uint32_t>(m_submission_map, params.sq_off.array);
+			m_submission_mask = *At<uint32_t>(m_submission_map, params.sq_off.ring_mask);
+
+			m_completion_head = At<uint32_t>(m_completion_map, params.cq_off.head);
+			m_completion_tail = At<uint32_t>(m_completion_map, params.cq_off.tail);
+			m_completions = At<io_uring_cqe>(m_completion_map, params.cq_off.cqes);
+			m_completion_mask = *At<uint32_t>(m_completion_map, params.cq_off.ring_mask);
+		}
+		catch (...)
+		{
+			Release();
+			throw;
+		}
+
+		PLOG_INFO << "UringReceiver: " << params.cq_entries << " completion entries, "
+			<< ((m_setup_flags & IORING_SETUP_DEFER_TASKRUN) != 0 ? "deferred" : "immediate") << " task work";
+	}
+
+	UringReceiver::~UringReceiver()
+	{
+		Stop();
+		Release();
+	}
+
+	/// <summary>
+	/// Release: Closes the ring, which ends its requests, before the
+	///			 stream buffers are unmapped.
+	/// </summary>
+	void UringReceiver::Release()
+	{
+		if (m_ring_descriptor >= 0)
+			close(m_ring_descriptor);
+		m_ring_descriptor = -1;
+
+		if (m_entries != nullptr)
+			munmap(m_entries, m_entries_octets);
+		if (m_completion_map != nullptr && m_completion_map != m_submission_map)
+			munmap(m_completion_map, m_completion_map_octets);
+		if (m_submission_map != nullptr)
+			munmap(m_submission_map, m_submission_map_octets);
+
+		m_entries = nullptr;
+		m_completion_map = nullptr;
+		m_submission_map = nullptr;
+
+		m_streams.clear();
+	}
+
+	uint32_t UringReceiver::AddStream(const SDP::MediaDescription& media_description, UringPacketHandler handler)
+	{
+		if (m_armed)
+			throw std::runtime_error("UringReceiver: Streams must be added before receiving starts");
+
+		if (m_streams.size() >= 65536)
+			throw std::runtime_error("UringReceiver: Too many streams");
+
+		uint32_t stream_index = (uint32_t)m_streams.size();
+		auto stream = std::make_unique<Stream>(media_description.endpoint, m_settings.socket, std::move(handler));
+
+		stream->header.msg_namelen = sizeof(SDP::SocketAddress);
+
+		// Buffer ring and buffers, page aligned as the kernel requires
+		uint32_t buffer_count = m_settings.buffer_count;
+		stream->ring_octets = buffer_count * sizeof(io_uring_buf);
+		stream->buffers_octets = (size_t)buffer_count * m_settings.buffer_octets;
+
+		void* ring = mmap(nullptr, stream->ring_octets, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (ring == MAP_FAILED)
+			ThrowSystemError("UringReceiver", "mmap");
+		stream->ring = (io_uring_buf*)ring;
+
+		void* buffers = mmap(nullptr, stream->buffers_octets, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+		if (buffers == MAP_FAILED)
+			ThrowSystemError("UringReceiver", "mmap");
+		stream->buffers = (uint8_t*)buffers;
+
+		for (uint32_t i = 0; i < buffer_count; i++)
+		{
+			io_uring_buf& buffer = stream->ring[i];
+			buffer.addr = (uint64_t)(uintptr_t)(stream->buffers + (size_t)i * m_settings.buffer_octets);
+			buffer.len = m_settings.buffer_octets;
+			buffer.bid = (uint16_t)i;
+		}
+		stream->ring_tail = (uint16_t)buffer_count;
+		stream->PublishTail();
+
+		io_uring_buf_reg registration = {};
+		registration.ring_addr = (uint64_t)(uintptr_t)stream->ring;
+		registration.ring_entries = buffer_count;
+		registration.bgid = (uint16_t)stream_index;
+
+		if (Register(m_ring_descriptor, IORING_REGISTER_PBUF_RING, &registration, 1) != 0)
+			ThrowSystemError("UringReceiver", "IORING_REGISTER_PBUF_RING");
+
+		m_streams.push_back(std::move(stream));
+		return stream_index;
+	}
+
+	void UringReceiver::Start()
+	{
+		if (m_running.exchange(true))
+			return;
+
+		m_thread = std::thread([this]()
+		{
+			try
+			{
+				while (m_running.load(std::memory_order_relaxed))
+					Receive();
+			}
+			catch (const std::exception& exception)
+			{
+				PLOG_ERROR << exception.what();
+				m_running.store(false);
+			}
+		});
+	}
+
+	void UringReceiver::Stop()
+	{
+		m_running.store(false);
+		if (m_thread.joinable())
+			m_thread.join();
+	}
+
+	/// <summary>
+	/// Arm: Queues the multishot recvmsg request of a stream. It keeps
+	///		 completing until its buffers run out or it fails.
+	/// </summary>
+	void UringReceiver::Arm(uint32_t stream_index)
+	{
+		if (m_pending > m_submission_mask)
+		{
+			if (Enter(m_ring_descriptor, m_pending, 0, 0, nullptr, 0) < 0)
+				ThrowSystemError("UringReceiver", "io_uring_enter");
+			RelaxedAdd(m_statistics.system_calls, 1);
+			m_pending = 0;
+		}
+
+		uint32_t tail = *m_submission_tail;
+		uint32_t index = tail & m_submission_mask;
+
+		io_uring_sqe& entry = m_entries[index];
+		entry = {};
+		entry.opcode = IORING_OP_RECVMSG;
+		entry.fd = m_streams[stream_index]->socket.GetDescriptor();
+		entry.addr = (uint64_t)(uintptr_t)&m_streams[stream_index]->header;
+		entry.ioprio = IORING_RECV_MULTISHOT;
+		entry.flags = IOSQE_BUFFER_SELECT;
+		entry.buf_group = (uint16_t)stream_index;
+		entry.user_data = stream_index;
+
+		// No length, so a datagram may fill its whole provided buffer
+
+		m_submission_array[index] = index;
+		StoreRelease(m_submission_tail, tail + 1);
+		m_pending++;
+	}
+
+	uint32_t UringReceiver::Receive(int32_t timeout_ms)
+	{
+		if (!m_armed)
+		{
+			if (Register(m_ring_descriptor, IORING_REGISTER_ENABLE_RINGS, nullptr, 0) != 0)
+				ThrowSystemError("UringReceiver", "IORING_REGISTER_ENABLE_RINGS");
+
+			for (uint32_t i = 0; i < m_streams.size(); i++)
+				Arm(i);
+			m_armed = true;
+		}
+
+		// Submit any rearmed requests and wait for the first completion
+		__kernel_timespec timeout = { timeout_ms / 1000, (timeout_ms % 1000) * 1000000LL };
+		io_uring_getevents_arg argument = {};
+		argument.ts = (uint64_t)(uintptr_t)&timeout;
+
+		int32_t result = Enter(m_ring_descriptor, m_pending, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &argument, sizeof(argument));
+		RelaxedAdd(m_statistics.system_calls, 1);
+
+		if (result < 0 && errno != ETIME && errno != EINTR && errno != EBUSY)
+			ThrowSystemError("UringReceiver", "io_uring_enter");
+		if (result > 0)
+			m_pending -= std::min((uint32_t)result, m_pending);
+
+		uint32_t buffer_mask = m_settings.buffer_count - 1;
+		uint32_t packets = 0;
+		uint32_t truncated = 0;
+		uint32_t exhausted = 0;
+
+		uint32_t head = *m_completion_head;
+		uint32_t tail = LoadAcquire(m_completion_tail);
+
+		for (; head != tail; head++)
+		{
+			const io_uring_cqe& completion = m_completions[head & m_completion_mask];
+			uint32_t stream_index = (uint32_t)completion.user_data;
+			Stream& stream = *m_streams[stream_index];
+
+			if ((completion.flags & IORING_CQE_F_BUFFER) != 0)
+			{
+				uint16_t buffer_id = (uint16_t)(completion.flags >> IORING_CQE_BUFFER_SHIFT);
+				uint8_t* buffer = stream.buffers + (size_t)buffer_id * m_settings.buffer_octets;
+
+				if (completion.res >= 0)
+				{
+					const io_uring_recvmsg_out* message = (const io_uring_recvmsg_out*)buffer;
+					if ((message->flags & MSG_TRUNC) != 0)
+						truncated++;
+					else
+					{
+						stream.handler(buffer + RECVMSG_HEADER_OCTETS, message->payloadlen);
+						packets++;
+					}
+				}
+
+				// Hand the buffer straight back to the kernel
+				io_uring_buf& entry = stream.ring[stream.ring_tail & buffer_mask];
+				entry.addr = (uint64_t)(uintptr_t)buffer;
+				entry.len = m_settings.buffer_octets;
+				entry.bid = buffer_id;
+				stream.ring_tail++;
+				stream.PublishTail();
+			}
+
+			if (completion.res < 0 && completion.res != -ENOBUFS)
+				ThrowSystemError("UringReceiver", "recvmsg", -completion.res);
+
+			exhausted += completion.res == -ENOBUFS;
+
+			// The multishot request ended, at the latest because its
+			// buffers ran out; every buffer is back by now
+			if ((completion.flags & IORING_CQE_F_MORE) == 0)
+				Arm(stream_index);
+		}
+
+		StoreRelease(m_completion_head, head);
+
+		RelaxedAdd(m_statistics.packets, packets);
+		if (truncated != 0)
+			RelaxedAdd(m_statistics.truncated, truncated);
+		if (exhausted != 0)
+			RelaxedAdd(m_statistics.buffers_exhausted, exhausted);
+
+		return packets;
+	}
+}
+#endif
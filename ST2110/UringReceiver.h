@@ -0,0 +1,159 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+#ifdef ST2110_LINUX
+namespace Cf
+{
+	// Called on the receive thread for every whole datagram of a stream.
+	// The packet is only valid during the call.
+	using UringPacketHandler = std::function<void(const uint8_t* packet, uint32_t octets)>;
+
+
+	/// <summary>
+	/// UringReceiverSettings: Ring and buffer sizes of a UringReceiver.
+	/// </summary>
+	struct UringReceiverSettings
+	{
+	public:
+		RtpSocketSettings socket;
+
+		// Provided buffers per stream, a power of two up to 32768. 1024
+		// buffers hold about 8 ms of a 64 channel 125 us audio stream.
+		uint32_t buffer_count = 1024;
+
+		// Octets per buffer, including the recvmsg header and source
+		// address the kernel writes ahead of the datagram
+		uint32_t buffer_octets = 2048;
+
+		// Completion queue entries. Every datagram is one completion, so
+		// this bounds the datagrams reaped per wakeup.
+		uint32_t completion_entries = 16384;
+	};
+
+
+	/// <summary>
+	/// UringReceiverStatistics: Counters of the receive thread. Written
+	///							 only by it, readable from any thread.
+	/// </summary>
+	struct UringReceiverStatistics
+	{
+	public:
+		std::atomic<uint64_t> packets = 0;
+		std::atomic<uint64_t> system_calls = 0;
+
+		// Times a stream ran out of provided buffers, ending its multishot
+		// receive until it was rearmed
+		std::atomic<uint64_t> buffers_exhausted = 0;
+
+		// Datagrams larger than a buffer, dropped
+		std::atomic<uint64_t> truncated = 0;
+	};
+
+
+	/// <summary>
+	/// UringReceiver: Receives any number of RTP streams on one thread with
+	///				   io_uring. Each stream has one multishot recvmsg
+	///				   request and a ring of buffers registered with the
+	///				   kernel (provided buffer ring), so after setup datagrams
+	///				   arrive as completions with no system call per packet
+	///				   or per stream; one io_uring_enter() waits for all of
+	///				   them. Talks to the kernel through the raw system calls
+	///				   and linux/io_uring.h, so liburing is not needed.
+	///				   Needs Linux 6.0 or later.
+	/// </summary>
+	class UringReceiver
+	{
+	public:
+		UringReceiver(const UringReceiverSettings& settings = {});
+		~UringReceiver();
+
+		UringReceiver(const UringReceiver&) = delete;
+		UringReceiver& operator=(const UringReceiver&) = delete;
+
+		/// <summary>
+		/// AddStream: Binds and joins a media description's endpoint and
+		///			   registers its buffer ring. Streams are added before
+		///			   the first Receive() or Start(). Returns the stream
+		///			   index.
+		/// </summary>
+		uint32_t AddStream(const SDP::MediaDescription& media_description, UringPacketHandler handler);
+
+		/// <summary>
+		/// Start: Runs Receive() on a receive thread until Stop().
+		/// </summary>
+		void Start();
+		void Stop();
+
+		/// <summary>
+		/// Receive: Waits up to the timeout for completions, hands each
+		///			 datagram to its stream's handler and gives the buffers
+		///			 back to the kernel. Returns the datagrams handled. All
+		///			 calls must come from one thread, which owns the ring
+		///			 from the first call on.
+		/// </summary>
+		uint32_t Receive(int32_t timeout_ms = 100);
+
+		uint32_t GetStreamCount() const { return (uint32_t)m_streams.size(); }
+		const UringReceiverStatistics& GetStatistics() const { return m_statistics; }
+
+	private:
+		struct Stream;
+
+		UringReceiverSettings m_settings;
+		std::vector<std::unique_ptr<Stream>> m_streams;
+
+		int32_t m_ring_descriptor = -1;
+		uint32_t m_setup_flags = 0;
+		bool m_armed = false;
+
+		// Submission queue
+		void* m_submission_map = nullptr;
+		size_t m_submission_map_octets = 0;
+		io_uring_sqe* m_entries = nullptr;
+		size_t m_entries_octets = 0;
+		uint32_t* m_submission_tail = nullptr;
+		uint32_t* m_submission_array = nullptr;
+		uint32_t m_submission_mask = 0;
+		uint32_t m_pending = 0;
+
+		// Completion queue
+		void* m_completion_map = nullptr;
+		size_t m_completion_map_octets = 0;
+		uint32_t* m_completion_head = nullptr;
+		uint32_t* m_completion_tail = nullptr;
+		io_uring_cqe* m_completions = nullptr;
+		uint32_t m_completion_mask = 0;
+
+		UringReceiverStatistics m_statistics;
+
+		std::thread m_thread;
+		std::atomic<bool> m_running = false;
+
+		void Arm(uint32_t stream_index);
+		void Release();
+	};
+}
+#endif
@@ -0,0 +1,181 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+#ifdef ST2110_LINUX
+#include <random>
+#include <time.h>
+
+namespace Cf
+{
+	namespace
+	{
+		using namespace RuntimeDetail;
+
+		void SpinPause()
+		{
+#ifdef ST2110_X86
+			_mm_pause();
+#endif
+		}
+	}
+
+
+	VideoSender::VideoSender(const SDP::VideoDescription& video_description, const VideoSenderSettings& settings)
+		: m_format(video_description), m_packer(m_format, settings.pixel_format, settings.max_simd_level),
+		  m_schedule(m_format, m_packer.GetGeometry(), video_description.tp, video_description.cmax),
+		  m_socket(video_description.endpoint, settings.socket), m_batch_size(settings.batch_size), m_spin_ns(settings.spin_ns)
+	{
+		if (m_batch_size == 0)
+			throw std::runtime_error("VideoSender: Batch size must not be zero");
+
+		m_frame_timing = FrameTiming(m_format.framerate, video_description.rtp_clock.GetClockRate());
+		m_rtp_offset = video_description.rtp_clock.GetOffset();
+		m_late_ns = (int64_t)m_schedule.GetTrsNs();
+
+		m_header.payload_type = video_description.payload_types.empty() ? 96 : (uint8_t)video_description.payload_types[0];
+		m_header.ssrc = settings.ssrc != 0 ? settings.ssrc : std::random_device()();
+
+		m_packet_octets = RtpHeader::OCTETS + m_packer.GetMaxPayloadOctets();
+		m_packets.resize((size_t)m_batch_size * m_packet_octets);
+		m_messages.resize(m_batch_size);
+		m_vectors.resize(m_batch_size);
+		for (uint32_t slot = 0; slot < m_batch_size; slot++)
+		{
+			m_vectors[slot] = { m_packets.data() + (size_t)slot * m_packet_octets, 0 };
+
+			msghdr& header = m_messages[slot].msg_hdr;
+			header = {};
+			header.msg_iov = &m_vectors[slot];
+			header.msg_iovlen = 1;
+		}
+
+		PLOG_INFO << "VideoSender: " << m_packer.GetPacketsPerFrame() << " packets per frame, TRS " << m_schedule.GetTrsNs()
+			<< " ns, " << PixelFormatName(settings.pixel_format) << " frames";
+	}
+
+	void VideoSender::SendFrame(const FramePlanes& frame, uint64_t frame_index)
+	{
+		m_header.timestamp = (uint32_t)m_frame_timing.GetFrameTicks(frame_index) + m_rtp_offset;
+
+		uint32_t packet_count = m_packer.GetPacketsPerFrame();
+		uint32_t late = 0;
+		for (uint32_t packet = 0; packet < packet_count;)
+		{
+			// Packed before the wait, so it leaves on time
+			int64_t send_ns = m_schedule.GetSendTimeNs(frame_index, packet);
+			Pack(frame, packet, 0);
+			WaitUntil(send_ns);
+
+			// Packets that fell due meanwhile join it
+			int64_t now_ns = GetTaiNs();
+			uint32_t count = 1;
+			while (count < m_batch_size && packet + count < packet_count && m_schedule.GetSendTimeNs(frame_index, packet + count) <= now_ns)
+			{
+				Pack(frame, packet + count, count);
+				count++;
+			}
+
+			for (uint32_t i = 0; i < count; i++)
+				late += now_ns - m_schedule.GetSendTimeNs(frame_index, packet + i) > m_late_ns ? 1 : 0;
+
+			Send(count);
+			packet += count;
+		}
+
+		RelaxedAdd(m_statistics.frames, 1);
+		if (late != 0)
+			RelaxedAdd(m_statistics.packets_late, late);
+	}
+
+	uint64_t VideoSender::GetNextFrame() const
+	{
+		return m_schedule.GetFrameTiming().NsToFrame(GetTaiNs()) + 1;
+	}
+
+	int64_t VideoSender::GetTaiNs()
+	{
+		timespec time;
+		clock_gettime(CLOCK_TAI, &time);
+		return (int64_t)time.tv_sec * 1000000000 + time.tv_nsec;
+	}
+
+	void VideoSender::Pack(const FramePlanes& frame, uint32_t packet, uint32_t slot)
+	{
+		uint8_t* data = m_packets.data() + (size_t)slot * m_packet_octets;
+
+		m_header.sequence_number = (uint16_t)m_sequence;
+		m_header.marker = m_packer.IsLastOfField(packet);
+		m_header.Write(data);
+
+		uint32_t payload_octets = m_packer.PackPacket(frame, packet, m_sequence, data + RtpHeader::OCTETS);
+		m_vectors[slot].iov_len = RtpHeader::OCTETS + payload_octets;
+		m_sequence++;
+	}
+
+	void VideoSender::WaitUntil(int64_t tai_ns) const
+	{
+		if (tai_ns - GetTaiNs() > m_spin_ns)
+		{
+			int64_t wake_ns = tai_ns - m_spin_ns;
+			timespec wake = { (time_t)(wake_ns / 1000000000), (long)(wake_ns % 1000000000) };
+			while (clock_nanosleep(CLOCK_TAI, TIMER_ABSTIME, &wake, nullptr) == EINTR)
+			{
+			}
+		}
+
+		while (GetTaiNs() < tai_ns)
+			SpinPause();
+	}
+
+	void VideoSender::Send(uint32_t count)
+	{
+		uint32_t sent = 0;
+		uint64_t octets = 0;
+		while (sent < count)
+		{
+			int32_t result = sendmmsg(m_socket.GetDescriptor(), m_messages.data() + sent, count - sent, 0);
+			RelaxedAdd(m_statistics.system_calls, 1);
+
+			if (result < 0)
+			{
+				if (errno == EINTR)
+					continue;
+
+				// Retrying would push every later packet off its time
+				RelaxedAdd(m_statistics.packets_dropped, count - sent);
+				break;
+			}
+
+			for (int32_t i = 0; i < result; i++)
+				octets += m_messages[sent + i].msg_len;
+			sent += result;
+		}
+
+		RelaxedAdd(m_statistics.packets, sent);
+		RelaxedAdd(m_statistics.octets, octets);
+	}
+}
+#endif
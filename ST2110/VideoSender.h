@@ -0,0 +1,151 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+#ifdef ST2110_LINUX
+namespace Cf
+{
+	/// <summary>
+	/// VideoSenderSettings: Socket, frame format and pacing of a
+	///						 VideoSender.
+	/// </summary>
+	struct VideoSenderSettings
+	{
+	public:
+		RtpSendSocketSettings socket;
+
+		// Memory layout of the frames handed to SendFrame()
+		PixelFormat pixel_format = PixelFormat::PLANAR;
+		SimdLevel max_simd_level = SimdLevel::AVX2;
+
+		// RTP SSRC, random if 0
+		uint32_t ssrc = 0;
+
+		// Packets that are due together go out in one sendmmsg() call, up
+		// to this many
+		uint32_t batch_size = 32;
+
+		// Waits shorter than this spin, as a sleep overshoots by tens of
+		// microseconds
+		int64_t spin_ns = 50000;
+	};
+
+
+	/// <summary>
+	/// VideoSenderStatistics: Counters of the sending thread. Written only
+	///						   by it, readable from any thread.
+	/// </summary>
+	struct VideoSenderStatistics
+	{
+	public:
+		std::atomic<uint64_t> frames = 0;
+		std::atomic<uint64_t> packets = 0;
+		std::atomic<uint64_t> octets = 0;
+		std::atomic<uint64_t> system_calls = 0;
+
+		// Sent more than one TRS after their scheduled time
+		std::atomic<uint64_t> packets_late = 0;
+
+		// Refused by the kernel, e.g. ENOBUFS when the interface queue is
+		// full. Not retried, so the schedule holds.
+		std::atomic<uint64_t> packets_dropped = 0;
+	};
+
+
+	/// <summary>
+	/// VideoSender: Sends ST 2110-20 frames to a video description's
+	///				 endpoint, each packet at its ST 2110-21 PacingSchedule
+	///				 time against CLOCK_TAI: packed by a PgroupPacker just
+	///				 before it is due, then sent after a sleep and a short
+	///				 spin. Packets that fall due together, because the
+	///				 schedule has them closer than a system call or the
+	///				 sender is behind, share one sendmmsg() call. RTP
+	///				 timestamps are the frame's alignment point on the
+	///				 rtpmap clock plus the "a=mediaclk:direct=" offset
+	///				 (2110-10:2022 8.2). CLOCK_TAI is CLOCK_REALTIME plus
+	///				 the kernel's TAI offset, which ptp4l/phc2sys or
+	///				 chrony set; without them it runs 37 s early.
+	///				 Not thread safe: one thread sends.
+	/// </summary>
+	class VideoSender
+	{
+	public:
+		VideoSender(const SDP::VideoDescription& video_description, const VideoSenderSettings& settings = {});
+
+		VideoSender(const VideoSender&) = delete;
+		VideoSender& operator=(const VideoSender&) = delete;
+
+		/// <summary>
+		/// SendFrame: Sends frame n of the stream on its schedule and
+		///			   returns after its last packet. A frame whose time
+		///			   has passed goes out at once, its packets late.
+		/// </summary>
+		void SendFrame(const FramePlanes& frame, uint64_t frame_index);
+
+		// Index of the first frame whose alignment point is still ahead,
+		// the first one that can go out on time
+		uint64_t GetNextFrame() const;
+
+		// CLOCK_TAI in nanoseconds since the PTP epoch
+		static int64_t GetTaiNs();
+
+		const VideoFormat& GetFormat() const { return m_format; }
+		const PgroupPacker& GetPacker() const { return m_packer; }
+		const PacingSchedule& GetSchedule() const { return m_schedule; }
+		const RtpSendSocket& GetSocket() const { return m_socket; }
+		const VideoSenderStatistics& GetStatistics() const { return m_statistics; }
+
+	private:
+		VideoFormat m_format;
+		PgroupPacker m_packer;
+		PacingSchedule m_schedule;
+		RtpSendSocket m_socket;
+
+		// RTP ticks of each frame on the rtpmap clock, and the mediaclk
+		// offset added to them
+		FrameTiming m_frame_timing;
+		uint32_t m_rtp_offset = 0;
+
+		RtpHeader m_header;
+		uint32_t m_sequence = 0;
+
+		uint32_t m_batch_size;
+		int64_t m_spin_ns;
+		int64_t m_late_ns;
+
+		// One packet buffer and sendmmsg() header per batch slot
+		uint32_t m_packet_octets;
+		std::vector<uint8_t> m_packets;
+		std::vector<mmsghdr> m_messages;
+		std::vector<iovec> m_vectors;
+
+		VideoSenderStatistics m_statistics;
+
+		void Pack(const FramePlanes& frame, uint32_t packet, uint32_t slot);
+		void WaitUntil(int64_t tai_ns) const;
+		void Send(uint32_t count);
+	};
+}
+#endif
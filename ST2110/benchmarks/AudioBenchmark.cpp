@@ -0,0 +1,190 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+	const char* const ENCODINGS[] = { "L24", "L16" };
+
+	const Cf::SampleFormat SAMPLE_FORMATS[] = { Cf::SampleFormat::INT32, Cf::SampleFormat::FLOAT32 };
+	const Cf::SampleLayout SAMPLE_LAYOUTS[] = { Cf::SampleLayout::INTERLEAVED, Cf::SampleLayout::PLANAR };
+
+	// A 2110-30 level C feed: 64 channels as 16 SDI groups, 125 us packets
+	std::string MakeSDP(const char* encoding, int32_t channels, const char* ptime)
+	{
+		std::string order;
+		for (int32_t i = 0; i < channels / 4; i++)
+			order += i == 0 ? "SGRP" : ",SGRP";
+
+		return std::string(
+			"v=0\r\n"
+			"o=- 1443716955 1443716955 IN IP4 192.168.1.230\r\n"
+			"s=st2110 audio\r\n"
+			"t=0 0\r\n"
+			"m=audio 20000 RTP/AVP 97\r\n"
+			"c=IN IP4 239.100.9.11/32\r\n"
+			"a=rtpmap:97 ") + encoding + "/48000/" + std::to_string(channels) + "\r\n"
+			"a=fmtp:97 channel-order=SMPTE2110.(" + order + ")\r\n"
+			"a=ptime:" + ptime + "\r\n";
+	}
+
+	// Decodes every packet into one buffer of packets * samples_per_packet
+	// sample frames
+	void UnpackAll(const Cf::AudioUnpacker& unpacker, const std::vector<uint8_t>& packets, uint32_t packet_count, const Cf::AudioBuffer& output)
+	{
+		const Cf::AudioFormat& format = unpacker.GetFormat();
+		for (uint32_t i = 0; i < packet_count; i++)
+			unpacker.Unpack(packets.data() + (size_t)i * format.packet_data_octets, format.packet_data_octets, output, i * format.samples_per_packet);
+	}
+
+	void PackAll(const Cf::AudioPacker& packer, const Cf::AudioBuffer& input, uint32_t packet_count, std::vector<uint8_t>& packets)
+	{
+		const Cf::AudioFormat& format = packer.GetFormat();
+		for (uint32_t i = 0; i < packet_count; i++)
+			packer.Pack(input, i * format.samples_per_packet, format.samples_per_packet, packets.data() + (size_t)i * format.packet_data_octets);
+	}
+}
+
+
+/// <summary>
+/// AudioBenchmark: Decodes and encodes 10 ms blocks of random L24 and L16
+///					packets with every kernel the CPU supports, for each
+///					sample format and layout, for all channels and for one
+///					SDI group. Reports packets per second and how many
+///					streams of that rate one core keeps up with, and fails
+///					if a SIMD kernel differs from the scalar kernel or the
+///					encoded packets differ from the source.
+/// </summary>
+int main(int argc, char** argv)
+{
+	int32_t channels = argc > 1 ? std::atoi(argv[1]) : 64;
+	const char* ptime = argc > 2 ? argv[2] : "0.125";
+	int32_t seconds_to_run = argc > 3 ? std::atoi(argv[3]) : 4;
+	if (channels <= 0 || channels % 4 != 0 || seconds_to_run <= 0)
+	{
+		std::cerr << "usage: " << argv[0] << " [channels (multiple of 4) [ptime [seconds]]]" << std::endl;
+		return 2;
+	}
+
+	Cf::SimdLevel detected = Cf::DetectSimdLevel();
+	std::cout << "CPU: " << Cf::SimdLevelName(detected) << ", " << channels << " channels, ptime " << ptime << " ms" << std::endl;
+
+	std::mt19937 random(2110);
+	bool matched = true;
+
+	for (const char* encoding : ENCODINGS)
+	{
+		Cf::SDPParser sdp_parser(MakeSDP(encoding, channels, ptime));
+		const Cf::SDP::AudioDescription& audio_description = sdp_parser.GetSDP().GetAudio(0);
+		Cf::AudioFormat format(audio_description);
+
+		// 10 ms of packets, which stays in cache like a receiver's
+		// recently arrived packets
+		uint32_t packet_count = std::max(format.sample_rate / 100 / format.samples_per_packet, 1u);
+		uint32_t stream_packet_rate = format.sample_rate / format.samples_per_packet;
+		uint32_t samples = packet_count * format.samples_per_packet;
+
+		std::vector<uint8_t> packets((size_t)packet_count * format.packet_data_octets);
+		for (uint8_t& octet : packets)
+			octet = (uint8_t)random();
+
+		const Cf::ChannelRange ranges[] = { {}, Cf::ChannelRange::FromGroup(audio_description, Cf::SDPChannelGroup::SDI_GROUP, 1) };
+
+		for (Cf::ChannelRange range : ranges)
+		{
+			for (Cf::SampleFormat sample_format : SAMPLE_FORMATS)
+			{
+				for (Cf::SampleLayout sample_layout : SAMPLE_LAYOUTS)
+				{
+					Cf::ChannelRange resolved = range.Resolve(format);
+					Cf::AudioBuffer reference = { nullptr, samples };
+					std::vector<uint32_t> reference_samples((size_t)samples * resolved.count);
+					reference.data = reference_samples.data();
+
+					UnpackAll(Cf::AudioUnpacker(format, sample_format, sample_layout, range, Cf::SimdLevel::SCALAR), packets, packet_count, reference);
+
+					for (int32_t level = 0; level <= (int32_t)detected; level++)
+					{
+						Cf::AudioUnpacker unpacker(format, sample_format, sample_layout, range, (Cf::SimdLevel)level);
+						Cf::AudioPacker packer(format, sample_format, sample_layout, range, (Cf::SimdLevel)level);
+						if ((int32_t)unpacker.GetSimdLevel() != level)
+							continue;
+
+						std::vector<uint32_t> decoded((size_t)samples * resolved.count);
+						Cf::AudioBuffer buffer = { decoded.data(), samples };
+
+						// Warm up and check: decode matches scalar, and encoding
+						// the decoded audio gives back the selected channels
+						UnpackAll(unpacker, packets, packet_count, buffer);
+						std::vector<uint8_t> encoded(packets.size());
+						if (!range.count)
+							PackAll(packer, buffer, packet_count, encoded);
+						else
+						{
+							encoded = packets;
+							for (uint32_t i = 0; i < packet_count; i++)
+							{
+								for (uint32_t s = 0; s < format.samples_per_packet; s++)
+									std::memset(encoded.data() + (size_t)i * format.packet_data_octets + s * format.frame_octets + resolved.first * format.bytes_per_sample, 0, resolved.count * format.bytes_per_sample);
+							}
+							PackAll(packer, buffer, packet_count, encoded);
+						}
+
+						bool same = decoded == reference_samples && encoded == packets;
+						matched = matched && same;
+
+						int32_t rounds = seconds_to_run * (int32_t)(stream_packet_rate / packet_count);
+						auto start = std::chrono::steady_clock::now();
+						for (int32_t i = 0; i < rounds; i++)
+							UnpackAll(unpacker, packets, packet_count, buffer);
+						auto middle = std::chrono::steady_clock::now();
+						for (int32_t i = 0; i < rounds; i++)
+							PackAll(packer, buffer, packet_count, encoded);
+						auto stop = std::chrono::steady_clock::now();
+
+						double decode_seconds = std::chrono::duration<double>(middle - start).count();
+						double encode_seconds = std::chrono::duration<double>(stop - middle).count();
+
+						double decode_pps = (double)packet_count * rounds / decode_seconds;
+						double encode_pps = (double)packet_count * rounds / encode_seconds;
+
+						std::cout << encoding << " ch " << resolved.first << "-" << resolved.first + resolved.count - 1
+							<< "\t" << Cf::SampleLayoutName(sample_layout) << " " << Cf::SampleFormatName(sample_format)
+							<< "\t" << Cf::SimdLevelName(unpacker.GetSimdLevel())
+							<< "\tdecode " << decode_pps / 1e6 << " Mpps (" << (int64_t)(decode_pps / stream_packet_rate) << " streams)"
+							<< "\tencode " << encode_pps / 1e6 << " Mpps (" << (int64_t)(encode_pps / stream_packet_rate) << " streams)"
+							<< (same ? "" : "\tMISMATCH") << std::endl;
+					}
+				}
+			}
+		}
+	}
+
+	return matched ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+	void PrintUsage(const char* program)
+	{
+		std::cerr << "usage: " << program << " [--interface name] [--seconds n] [--threads n] [--batch n] [--no-gso] sdp_file..." << std::endl;
+	}
+
+	struct Totals
+	{
+		uint64_t packets = 0;
+		uint64_t octets = 0;
+		uint64_t system_calls = 0;
+		uint64_t packets_dropped = 0;
+	};
+
+	Totals Sum(const std::vector<std::unique_ptr<Cf::RtpBlaster>>& blasters)
+	{
+		Totals totals;
+		for (const std::unique_ptr<Cf::RtpBlaster>& blaster : blasters)
+		{
+			const Cf::RtpBlasterStatistics& statistics = blaster->GetStatistics();
+			totals.packets += statistics.packets.load();
+			totals.octets += statistics.octets.load();
+			totals.system_calls += statistics.system_calls.load();
+			totals.packets_dropped += statistics.packets_dropped.load();
+		}
+		return totals;
+	}
+
+	void Print(const char* label, const Totals& totals, const Totals& previous, double seconds)
+	{
+		uint64_t packets = totals.packets - previous.packets;
+		std::cout << label << (packets / seconds) / 1e6 << " Mpps, "
+			<< (totals.octets - previous.octets) * 8 / seconds / 1e9 << " Gbit/s RTP, "
+			<< (double)packets / std::max<uint64_t>(totals.system_calls - previous.system_calls, 1) << " packets per call, "
+			<< "dropped " << totals.packets_dropped - previous.packets_dropped << std::endl;
+	}
+}
+
+
+/// <summary>
+/// BlastSender: Sends every video and audio stream of the given SDP files
+///				 as fast as the host takes them, with an RtpBlaster per
+///				 thread and the streams dealt out among them. Reports
+///				 packets per second, RTP bit rate and packets per system
+///				 call every second and for the whole run, to find the
+///				 rate a receiver breaks at.
+/// </summary>
+int main(int argc, char** argv)
+{
+	Cf::RtpBlasterSettings settings;
+	int32_t seconds_to_run = 10;
+	int32_t thread_count = 1;
+	std::vector<std::string> sdps;
+
+	for (int32_t i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		bool has_value = i + 1 < argc;
+		if (argument == "--interface" && has_value)
+			settings.socket.interface_name = argv[++i];
+		else if (argument == "--seconds" && has_value)
+			seconds_to_run = std::atoi(argv[++i]);
+		else if (argument == "--threads" && has_value)
+			thread_count = std::atoi(argv[++i]);
+		else if (argument == "--batch" && has_value)
+			settings.batch_size = (uint32_t)std::max(std::atoi(argv[++i]), 0);
+		else if (argument == "--no-gso")
+			settings.segmentation_offload = false;
+		else if (argument.starts_with("--"))
+		{
+			PrintUsage(argv[0]);
+			return 2;
+		}
+		else
+		{
+			std::ifstream file(argument, std::ios::binary);
+			if (!file)
+			{
+				std::cerr << "cannot read " << argument << std::endl;
+				return 2;
+			}
+			std::stringstream sdp;
+			sdp << file.rdbuf();
+			sdps.push_back(sdp.str());
+		}
+	}
+
+	if (sdps.empty() || seconds_to_run <= 0 || thread_count <= 0 || settings.batch_size == 0)
+	{
+		PrintUsage(argv[0]);
+		return 2;
+	}
+
+	// Each SDP's streams go to the thread with the fewest so far
+	std::vector<std::unique_ptr<Cf::RtpBlaster>> blasters;
+	for (int32_t i = 0; i < thread_count; i++)
+		blasters.push_back(std::make_unique<Cf::RtpBlaster>(settings));
+
+	for (const std::string& sdp : sdps)
+	{
+		Cf::RtpBlaster& blaster = **std::min_element(blasters.begin(), blasters.end(), [](const auto& a, const auto& b)
+		{
+			return a->GetStreamCount() < b->GetStreamCount();
+		});
+
+		// Streams before the one that failed are kept
+		try
+		{
+			blaster.AddSDP(sdp);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "skipped streams of an SDP: " << e.what() << std::endl;
+		}
+	}
+
+	size_t stream_count = 0;
+	for (const std::unique_ptr<Cf::RtpBlaster>& blaster : blasters)
+		stream_count += blaster->GetStreamCount();
+
+	if (stream_count == 0)
+	{
+		std::cerr << "no streams to send" << std::endl;
+		return 1;
+	}
+
+	std::cout << stream_count << " streams on " << thread_count << " threads, "
+		<< (blasters[0]->IsSegmentationOffloaded() ? "UDP_SEGMENT" : "no GSO") << ", " << settings.batch_size << " messages per call" << std::endl;
+
+	std::atomic<bool> sending = true;
+	std::vector<std::thread> threads;
+	for (std::unique_ptr<Cf::RtpBlaster>& blaster : blasters)
+	{
+		if (blaster->GetStreamCount() == 0)
+			continue;
+
+		threads.emplace_back([&sending, &blaster]()
+		{
+			while (sending.load(std::memory_order_relaxed))
+				blaster->SendRound();
+		});
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	auto last = start;
+	Totals previous;
+	for (int32_t second = 0; second < seconds_to_run; second++)
+	{
+		std::this_thread::sleep_until(start + std::chrono::seconds(second + 1));
+
+		auto now = std::chrono::steady_clock::now();
+		Totals totals = Sum(blasters);
+		Print("", totals, previous, std::chrono::duration<double>(now - last).count());
+		previous = totals;
+		last = now;
+	}
+
+	sending.store(false);
+	for (std::thread& thread : threads)
+		thread.join();
+
+	Print("total: ", Sum(blasters), Totals(), std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	return 0;
+}
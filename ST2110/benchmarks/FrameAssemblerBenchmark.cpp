@@ -0,0 +1,225 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+	// 90 kHz RTP clock at 50 frames per second
+	constexpr uint32_t TIMESTAMP_STEP = 1800;
+
+	// Packets swapped around within windows of this many in the reordered
+	// run, about what a switch with per-flow ECMP or a NIC with several RX
+	// queues does
+	constexpr uint32_t REORDER_WINDOW = 32;
+
+	std::string MakeSDP(int32_t width, int32_t height, bool interlaced, const char* packing_mode)
+	{
+		return std::string(
+			"v=0\r\n"
+			"o=- 1443716955 1443716955 IN IP4 192.168.1.230\r\n"
+			"s=st2110 stream\r\n"
+			"t=0 0\r\n"
+			"m=video 20000 RTP/AVP 96\r\n"
+			"c=IN IP4 239.100.9.10/32\r\n"
+			"a=rtpmap:96 raw/90000\r\n"
+			"a=fmtp:96 sampling=YCbCr-4:2:2; width=") + std::to_string(width) + "; height=" + std::to_string(height)
+			+ "; exactframerate=" + (interlaced ? "25; interlace" : "50") + "; depth=10; TCS=SDR; colorimetry=BT709; PM=" + packing_mode + "; SSN=ST2110-20:2017; TP=2110TPN; \r\n";
+	}
+
+	// GPM and BPM unpacked to planar, and BPM placed in PGROUP frames
+	// without unpacking
+	struct Output
+	{
+		const char* packing_mode;
+		Cf::PixelFormat pixel_format;
+		bool interlaced;
+	};
+
+	const Output OUTPUTS[] =
+	{
+		{ "2110GPM", Cf::PixelFormat::PLANAR, false }, { "2110BPM", Cf::PixelFormat::PLANAR, false }, { "2110BPM", Cf::PixelFormat::PGROUP, false },
+		{ "2110GPM", Cf::PixelFormat::PLANAR, true }, { "2110BPM", Cf::PixelFormat::PLANAR, true }, { "2110BPM", Cf::PixelFormat::PGROUP, true }
+	};
+
+	struct Scenario
+	{
+		const char* name;
+		bool reorder;
+		double loss;
+		double duplication;
+	};
+
+	const Scenario SCENARIOS[] =
+	{
+		{ "in order", false, 0, 0 }, { "reordered", true, 0, 0 }, { "0.01% loss", false, 0.0001, 0 }, { "reordered, 0.01% loss", true, 0.0001, 0 },
+		{ "reordered, 0.01% duplicated", true, 0, 0.0001 }
+	};
+}
+
+
+/// <summary>
+/// FrameAssemblerBenchmark: Packs a random 4:2:2 10 bit frame into RTP
+///							 packets and pushes them through a
+///							 FrameAssembler as a stream of frames: in
+///							 order, reordered within a small window, with
+///							 random loss and with random duplicates.
+///							 Reports packets per second
+///							 and the frames handed out complete and
+///							 incomplete, for GPM and BPM streams into
+///							 planar frames and BPM into PGROUP frames
+///							 (direct placement). Fails if a complete frame
+///							 differs from the source, a run without loss
+///							 has incomplete frames or lost packets, or
+///							 the duplicates counted differ from those sent.
+/// </summary>
+int main(int argc, char** argv)
+{
+	int32_t width = argc > 2 ? std::atoi(argv[1]) : 1920;
+	int32_t height = argc > 2 ? std::atoi(argv[2]) : 1080;
+	int32_t frames = argc > 3 ? std::atoi(argv[3]) : 200;
+	if (width <= 0 || height <= 0 || frames <= 0)
+	{
+		std::cerr << "usage: " << argv[0] << " [width height [frames]]" << std::endl;
+		return 2;
+	}
+
+	std::mt19937 random(2110);
+	bool matched = true;
+
+	for (const Output& output : OUTPUTS)
+	{
+		Cf::SDPParser sdp_parser(MakeSDP(width, height, output.interlaced, output.packing_mode));
+		const Cf::SDP::VideoDescription& video_description = *sdp_parser.GetSDP().GetFirstVideo();
+
+		Cf::VideoFormat video_format(video_description);
+		Cf::FrameLayout layout(video_format, output.pixel_format);
+		Cf::PgroupPacker packer(video_format, output.pixel_format);
+
+		std::vector<uint8_t> source(layout.size);
+		for (size_t i = 0; i < source.size() / 2; i++)
+			((uint16_t*)source.data())[i] = (uint16_t)(random() & 0x3FF);
+
+		// One frame of RTP packets; only the headers change per frame
+		uint32_t packet_count = packer.GetPacketsPerFrame();
+		uint32_t packet_stride = Cf::RtpHeader::OCTETS + packer.GetMaxPayloadOctets();
+		std::vector<uint8_t> packets((size_t)packet_count * packet_stride);
+		std::vector<uint32_t> octets(packet_count);
+		for (uint32_t i = 0; i < packet_count; i++)
+			octets[i] = Cf::RtpHeader::OCTETS + packer.PackPacket(layout.GetPlanes(source.data()), i, i, packets.data() + (size_t)i * packet_stride + Cf::RtpHeader::OCTETS);
+
+		for (const Scenario& scenario : SCENARIOS)
+		{
+			bool content_matched = true;
+			bool content_checked = false;
+			Cf::FrameAssembler assembler(video_description, output.pixel_format, [&](Cf::FrameHandle frame)
+			{
+				// Every frame carries the same picture; checking the first
+				// complete one keeps the compare out of the timing. Line
+				// padding is never written, so compare line by line.
+				if (!frame->IsComplete() || content_checked)
+					return;
+
+				content_checked = true;
+				for (uint32_t plane = 0; plane < layout.plane_count; plane++)
+				{
+					for (uint32_t line = 0; line < layout.heights[plane]; line++)
+					{
+						size_t offset = layout.offsets[plane] + (size_t)layout.strides[plane] * line;
+						content_matched = content_matched && std::memcmp(frame->GetPlanes().data[plane] + (size_t)layout.strides[plane] * line,
+							source.data() + offset, layout.line_bytes[plane]) == 0;
+					}
+				}
+			});
+
+			std::vector<uint32_t> order(packet_count);
+			std::bernoulli_distribution lose(scenario.loss);
+			std::bernoulli_distribution duplicate(scenario.duplication);
+			uint64_t duplicated = 0;
+			Cf::RtpHeader header;
+			header.payload_type = 96;
+			uint32_t sequence = 0;
+
+			double seconds = 0;
+			for (int32_t frame = 0; frame < frames; frame++)
+			{
+				for (uint32_t i = 0; i < packet_count; i++)
+					order[i] = i;
+				if (scenario.reorder)
+				{
+					for (uint32_t i = 0; i < packet_count; i += REORDER_WINDOW)
+						std::shuffle(order.begin() + i, order.begin() + std::min(i + REORDER_WINDOW, packet_count), random);
+				}
+
+				// Headers as the sender wrote them, sequence numbers in
+				// packet order
+				header.timestamp = frame * TIMESTAMP_STEP;
+				for (uint32_t i = 0; i < packet_count; i++, sequence++)
+				{
+					uint8_t* packet = packets.data() + (size_t)i * packet_stride;
+					header.sequence_number = (uint16_t)sequence;
+					header.marker = packer.IsLastOfField(i);
+					header.Write(packet);
+					Cf::RtpDetail::WriteBE16(packet + Cf::RtpHeader::OCTETS, (uint16_t)(sequence >> 16));
+				}
+
+				auto start = std::chrono::steady_clock::now();
+				for (uint32_t i : order)
+				{
+					if (scenario.loss == 0 || !lose(random))
+						assembler.Push(packets.data() + (size_t)i * packet_stride, octets[i]);
+
+					if (scenario.duplication != 0 && duplicate(random))
+					{
+						assembler.Push(packets.data() + (size_t)i * packet_stride, octets[i]);
+						duplicated++;
+					}
+				}
+				seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			}
+			assembler.Flush();
+
+			const Cf::FrameAssemblerStatistics& statistics = assembler.GetStatistics();
+			bool passed = content_matched && content_checked && statistics.packets_invalid.load() == 0 && statistics.frames_dropped.load() == 0
+				&& (scenario.loss != 0 || (statistics.frames_complete.load() == (uint64_t)frames && statistics.packets_lost.load() == 0))
+				&& statistics.packets_duplicate.load() == duplicated;
+			matched = matched && passed;
+
+			std::cout << width << "x" << height << (output.interlaced ? "i" : "p") << " " << output.packing_mode << " " << Cf::PixelFormatName(output.pixel_format) << " " << scenario.name
+				<< "\t" << statistics.packets.load() / seconds / 1e6 << " Mpps"
+				<< "\t" << frames / seconds << " frames/s"
+				<< "\tcomplete " << statistics.frames_complete.load() << ", incomplete " << statistics.frames_incomplete.load()
+				<< ", lost " << statistics.packets_lost.load() << ", reordered " << statistics.packets_reordered.load()
+				<< ", duplicate " << statistics.packets_duplicate.load()
+				<< ", late " << statistics.packets_late.load() << ", placed " << statistics.packets_placed.load()
+				<< (passed ? "" : "\tFAILED") << std::endl;
+		}
+	}
+
+	return matched ? 0 : 1;
+}
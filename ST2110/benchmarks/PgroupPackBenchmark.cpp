@@ -0,0 +1,237 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+	struct Format
+	{
+		const char* sampling;
+		const char* depth;
+		const char* packing_mode;
+	};
+
+	// One sampling per PgroupLayout at every depth, so each kernel of the
+	// KernelTable is measured; the other samplings of a chroma structure
+	// share these kernels. BPM only changes the packet plan.
+	const Format FORMATS[] =
+	{
+		{ "YCbCr-4:2:2", "8", "2110GPM" }, { "YCbCr-4:2:2", "10", "2110GPM" }, { "YCbCr-4:2:2", "12", "2110GPM" }, { "YCbCr-4:2:2", "16", "2110GPM" }, { "YCbCr-4:2:2", "16f", "2110GPM" },
+		{ "YCbCr-4:4:4", "8", "2110GPM" }, { "YCbCr-4:4:4", "10", "2110GPM" }, { "YCbCr-4:4:4", "12", "2110GPM" }, { "YCbCr-4:4:4", "16", "2110GPM" }, { "YCbCr-4:4:4", "16f", "2110GPM" },
+		{ "YCbCr-4:2:0", "8", "2110GPM" }, { "YCbCr-4:2:0", "10", "2110GPM" }, { "YCbCr-4:2:0", "12", "2110GPM" }, { "YCbCr-4:2:0", "16", "2110GPM" }, { "YCbCr-4:2:0", "16f", "2110GPM" },
+		{ "RGB", "8", "2110GPM" }, { "RGB", "10", "2110GPM" }, { "RGB", "12", "2110GPM" }, { "RGB", "16", "2110GPM" }, { "RGB", "16f", "2110GPM" },
+		{ "YCbCr-4:2:2", "8", "2110BPM" }, { "YCbCr-4:2:2", "10", "2110BPM" }, { "YCbCr-4:2:0", "10", "2110BPM" }, { "RGB", "12", "2110BPM" }
+	};
+
+	const Cf::PixelFormat PIXEL_FORMATS[] = { Cf::PixelFormat::PLANAR, Cf::PixelFormat::V210, Cf::PixelFormat::P010, Cf::PixelFormat::PGROUP };
+
+	std::string MakeSDP(const Format& format, int32_t width, int32_t height)
+	{
+		return std::string(
+			"v=0\r\n"
+			"o=- 1443716955 1443716955 IN IP4 192.168.1.230\r\n"
+			"s=st2110 stream\r\n"
+			"t=0 0\r\n"
+			"m=video 20000 RTP/AVP 96\r\n"
+			"c=IN IP4 239.100.9.10/32\r\n"
+			"a=rtpmap:96 raw/90000\r\n"
+			"a=fmtp:96 sampling=") + format.sampling + "; width=" + std::to_string(width) + "; height=" + std::to_string(height)
+			+ "; exactframerate=50; depth=" + format.depth + "; TCS=SDR; colorimetry=BT709; PM=" + format.packing_mode + "; SSN=ST2110-20:2017; TP=2110TPN; \r\n";
+	}
+
+	// Random frame whose samples fit the depth of the format
+	void FillFrame(const Cf::VideoFormat& format, const Cf::FrameLayout& layout, std::vector<uint8_t>& frame, std::mt19937& random)
+	{
+		for (uint32_t plane = 0; plane < layout.plane_count; plane++)
+		{
+			for (uint32_t line = 0; line < layout.heights[plane]; line++)
+			{
+				uint8_t* data = frame.data() + layout.offsets[plane] + (size_t)layout.strides[plane] * line;
+
+				if (layout.pixel_format == Cf::PixelFormat::V210)
+				{
+					for (uint32_t i = 0; i < layout.line_bytes[plane] / 4; i++)
+						((uint32_t*)data)[i] = random() & 0x3FFFFFFF;
+				}
+				else if (layout.pixel_format == Cf::PixelFormat::P010)
+				{
+					for (uint32_t i = 0; i < layout.line_bytes[plane] / 2; i++)
+						((uint16_t*)data)[i] = (uint16_t)(random() << (16 - format.depth_bits));
+				}
+				else if (format.depth_bits == 8)
+				{
+					for (uint32_t i = 0; i < layout.line_bytes[plane]; i++)
+						data[i] = (uint8_t)random();
+				}
+				else
+				{
+					for (uint32_t i = 0; i < layout.line_bytes[plane] / 2; i++)
+						((uint16_t*)data)[i] = (uint16_t)(random() & ((1u << format.depth_bits) - 1));
+				}
+			}
+		}
+	}
+
+	// Packs every packet of a frame back to back. Returns the payload octets.
+	size_t PackFrame(const Cf::PgroupPacker& packer, const Cf::FramePlanes& planes, std::vector<uint8_t>& packets)
+	{
+		size_t octets = 0;
+		uint32_t max_payload = packer.GetMaxPayloadOctets();
+
+		for (uint32_t packet = 0; packet < packer.GetPacketsPerFrame(); packet++)
+			octets += packer.PackPacket(planes, packet, packet, packets.data() + (size_t)packet * max_payload);
+
+		return octets;
+	}
+
+	// Unpacks the packets through their SRD headers and compares the result
+	// with the source frame
+	bool RoundTrip(const Cf::PgroupPacker& packer, const Cf::FrameLayout& layout, const std::vector<uint8_t>& packets, const std::vector<uint8_t>& source)
+	{
+		Cf::PgroupUnpacker unpacker(packer.GetFormat(), layout.pixel_format, Cf::SimdLevel::SCALAR);
+		std::vector<uint8_t> frame(layout.size);
+		Cf::FramePlanes planes = layout.GetPlanes(frame.data());
+
+		for (uint32_t packet = 0; packet < packer.GetPacketsPerFrame(); packet++)
+		{
+			const uint8_t* payload = packets.data() + (size_t)packet * packer.GetMaxPayloadOctets();
+			const uint8_t* header = payload + Cf::StreamGeometryDetail::EXTENDED_SEQUENCE_OCTETS;
+
+			uint32_t srd_count = 1;
+			while (header[(srd_count - 1) * Cf::SampleRowData::OCTETS + 4] & 0x80)
+				srd_count++;
+
+			const uint8_t* data = header + srd_count * Cf::SampleRowData::OCTETS;
+			for (uint32_t i = 0; i < srd_count; i++)
+			{
+				Cf::SampleRowData srd;
+				srd.Read(header + i * Cf::SampleRowData::OCTETS);
+
+				Cf::FramePlanes target = packer.GetFormat().IsInterlaced() ? planes.GetField(srd.second_field ? 1 : 0) : planes;
+				if (!unpacker.Unpack(data, srd.length, srd.row, srd.offset, target, packer.GetFormat().field_height))
+					return false;
+
+				data += srd.length;
+			}
+		}
+
+		for (uint32_t plane = 0; plane < layout.plane_count; plane++)
+		{
+			for (uint32_t line = 0; line < layout.heights[plane]; line++)
+			{
+				size_t offset = layout.offsets[plane] + (size_t)layout.strides[plane] * line;
+				if (std::memcmp(frame.data() + offset, source.data() + offset, layout.line_bytes[plane]) != 0)
+					return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+
+/// <summary>
+/// PgroupPackBenchmark: Packs random frames into 2110-20 packets with every
+///						 kernel the CPU supports, for each sampling, depth,
+///						 packing mode and pixel format. Reports payload
+///						 throughput and packets per second, and fails if
+///						 the packets do not unpack back to the frame or a
+///						 SIMD kernel differs from the scalar kernel.
+/// </summary>
+int main(int argc, char** argv)
+{
+	int32_t width = argc > 2 ? std::atoi(argv[1]) : 3840;
+	int32_t height = argc > 2 ? std::atoi(argv[2]) : 2160;
+	int32_t frames = argc > 3 ? std::atoi(argv[3]) : 50;
+	if (width <= 0 || height <= 0 || frames <= 0)
+	{
+		std::cerr << "usage: " << argv[0] << " [width height [frames]]" << std::endl;
+		return 2;
+	}
+
+	Cf::SimdLevel detected = Cf::DetectSimdLevel();
+	std::cout << "CPU: " << Cf::SimdLevelName(detected) << ", " << width << "x" << height << ", " << frames << " frames" << std::endl;
+
+	std::mt19937 random(2110);
+	bool matched = true;
+
+	for (const Format& format : FORMATS)
+	{
+		Cf::SDPParser sdp_parser(MakeSDP(format, width, height));
+		Cf::VideoFormat video_format(*sdp_parser.GetSDP().GetFirstVideo());
+
+		for (Cf::PixelFormat pixel_format : PIXEL_FORMATS)
+		{
+			if (!Cf::FrameLayout::IsSupported(video_format, pixel_format))
+				continue;
+
+			Cf::FrameLayout layout(video_format, pixel_format);
+			std::vector<uint8_t> source(layout.size);
+			FillFrame(video_format, layout, source, random);
+			Cf::FramePlanes planes = layout.GetPlanes(source.data());
+
+			Cf::PgroupPacker scalar_packer(video_format, pixel_format, Cf::SimdLevel::SCALAR);
+			std::vector<uint8_t> reference((size_t)scalar_packer.GetPacketsPerFrame() * scalar_packer.GetMaxPayloadOctets());
+			PackFrame(scalar_packer, planes, reference);
+
+			bool round_trip = RoundTrip(scalar_packer, layout, reference, source);
+			matched = matched && round_trip;
+
+			for (int32_t level = 0; level <= (int32_t)detected; level++)
+			{
+				Cf::PgroupPacker packer(video_format, pixel_format, (Cf::SimdLevel)level);
+				if ((int32_t)packer.GetSimdLevel() != level)
+					continue;
+
+				std::vector<uint8_t> packets(reference.size());
+
+				// Warm up, then check against the scalar kernel
+				size_t octets = PackFrame(packer, planes, packets);
+				bool same = round_trip && packets == reference;
+				matched = matched && same;
+
+				auto start = std::chrono::steady_clock::now();
+				for (int32_t i = 0; i < frames; i++)
+					PackFrame(packer, planes, packets);
+				auto stop = std::chrono::steady_clock::now();
+
+				double seconds = std::chrono::duration<double>(stop - start).count();
+
+				std::cout << format.sampling << "/" << format.depth << " " << format.packing_mode
+					<< "\t" << Cf::PixelFormatName(pixel_format)
+					<< "\t" << Cf::SimdLevelName(packer.GetSimdLevel())
+					<< "\t" << (double)octets * 8 * frames / seconds / 1e9 << " Gb/s"
+					<< "\t" << packer.GetPacketsPerFrame() * (frames / seconds) / 1e6 << " Mpps"
+					<< (same ? "" : "\tMISMATCH") << std::endl;
+			}
+		}
+	}
+
+	return matched ? 0 : 1;
+}
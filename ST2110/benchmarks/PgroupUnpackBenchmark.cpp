@@ -0,0 +1,159 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+	struct Format
+	{
+		const char* sampling;
+		const char* depth;
+	};
+
+	// One sampling per PgroupLayout at every depth, so each kernel of the
+	// KernelTable is measured; the other samplings of a chroma structure
+	// share these kernels
+	const Format FORMATS[] =
+	{
+		{ "YCbCr-4:2:2", "8" }, { "YCbCr-4:2:2", "10" }, { "YCbCr-4:2:2", "12" }, { "YCbCr-4:2:2", "16" }, { "YCbCr-4:2:2", "16f" },
+		{ "YCbCr-4:4:4", "8" }, { "YCbCr-4:4:4", "10" }, { "YCbCr-4:4:4", "12" }, { "YCbCr-4:4:4", "16" }, { "YCbCr-4:4:4", "16f" },
+		{ "YCbCr-4:2:0", "8" }, { "YCbCr-4:2:0", "10" }, { "YCbCr-4:2:0", "12" }, { "YCbCr-4:2:0", "16" }, { "YCbCr-4:2:0", "16f" },
+		{ "RGB", "8" }, { "RGB", "10" }, { "RGB", "12" }, { "RGB", "16" }, { "RGB", "16f" }
+	};
+
+	const Cf::PixelFormat PIXEL_FORMATS[] = { Cf::PixelFormat::PLANAR, Cf::PixelFormat::V210, Cf::PixelFormat::P010, Cf::PixelFormat::PGROUP };
+
+	std::string MakeSDP(const Format& format, int32_t width, int32_t height)
+	{
+		return std::string(
+			"v=0\r\n"
+			"o=- 1443716955 1443716955 IN IP4 192.168.1.230\r\n"
+			"s=st2110 stream\r\n"
+			"t=0 0\r\n"
+			"m=video 20000 RTP/AVP 96\r\n"
+			"c=IN IP4 239.100.9.10/32\r\n"
+			"a=rtpmap:96 raw/90000\r\n"
+			"a=fmtp:96 sampling=") + format.sampling + "; width=" + std::to_string(width) + "; height=" + std::to_string(height)
+			+ "; exactframerate=50; depth=" + format.depth + "; TCS=SDR; colorimetry=BT709; PM=2110GPM; SSN=ST2110-20:2017; TP=2110TPN; \r\n";
+	}
+
+	// Unpacked bytes of a frame, padding excluded
+	bool SameFrame(const Cf::FrameLayout& layout, const std::vector<uint8_t>& a, const std::vector<uint8_t>& b)
+	{
+		for (uint32_t plane = 0; plane < layout.plane_count; plane++)
+		{
+			for (uint32_t line = 0; line < layout.heights[plane]; line++)
+			{
+				size_t offset = layout.offsets[plane] + (size_t)layout.strides[plane] * line;
+				if (std::memcmp(a.data() + offset, b.data() + offset, layout.line_bytes[plane]) != 0)
+					return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+
+/// <summary>
+/// PgroupUnpackBenchmark: Unpacks random 2110-20 frames with every kernel
+///						   the CPU supports, for each sampling, depth and
+///						   pixel format. Reports payload throughput and
+///						   frames per second, and fails if a SIMD kernel
+///						   does not match the scalar kernel.
+/// </summary>
+int main(int argc, char** argv)
+{
+	int32_t width = argc > 2 ? std::atoi(argv[1]) : 3840;
+	int32_t height = argc > 2 ? std::atoi(argv[2]) : 2160;
+	int32_t frames = argc > 3 ? std::atoi(argv[3]) : 50;
+	if (width <= 0 || height <= 0 || frames <= 0)
+	{
+		std::cerr << "usage: " << argv[0] << " [width height [frames]]" << std::endl;
+		return 2;
+	}
+
+	Cf::SimdLevel detected = Cf::DetectSimdLevel();
+	std::cout << "CPU: " << Cf::SimdLevelName(detected) << ", " << width << "x" << height << ", " << frames << " frames" << std::endl;
+
+	std::mt19937 random(2110);
+	bool matched = true;
+
+	for (const Format& format : FORMATS)
+	{
+		Cf::SDPParser sdp_parser(MakeSDP(format, width, height));
+		Cf::VideoFormat video_format(*sdp_parser.GetSDP().GetFirstVideo());
+
+		std::vector<uint8_t> payload(video_format.frame_octets + 64);
+		for (uint8_t& octet : payload)
+			octet = (uint8_t)random();
+
+		for (Cf::PixelFormat pixel_format : PIXEL_FORMATS)
+		{
+			if (!Cf::FrameLayout::IsSupported(video_format, pixel_format))
+				continue;
+
+			Cf::FrameLayout layout(video_format, pixel_format);
+			std::vector<uint8_t> reference(layout.size);
+			Cf::PgroupUnpacker(video_format, pixel_format, Cf::SimdLevel::SCALAR).UnpackFrame(payload.data(), layout.GetPlanes(reference.data()));
+
+			for (int32_t level = 0; level <= (int32_t)detected; level++)
+			{
+				Cf::PgroupUnpacker unpacker(video_format, pixel_format, (Cf::SimdLevel)level);
+				if ((int32_t)unpacker.GetSimdLevel() != level)
+					continue;
+
+				std::vector<uint8_t> frame(layout.size);
+				Cf::FramePlanes planes = layout.GetPlanes(frame.data());
+
+				// Warm up, then check against the scalar kernel
+				unpacker.UnpackFrame(payload.data(), planes);
+				bool same = SameFrame(layout, reference, frame);
+				matched = matched && same;
+
+				auto start = std::chrono::steady_clock::now();
+				for (int32_t i = 0; i < frames; i++)
+					unpacker.UnpackFrame(payload.data(), planes);
+				auto stop = std::chrono::steady_clock::now();
+
+				double seconds = std::chrono::duration<double>(stop - start).count();
+				double gbps = (double)video_format.frame_octets * 8 * frames / seconds / 1e9;
+
+				std::cout << format.sampling << "/" << format.depth
+					<< "\t" << Cf::PixelFormatName(pixel_format)
+					<< "\t" << Cf::SimdLevelName(unpacker.GetSimdLevel())
+					<< "\t" << gbps << " Gb/s"
+					<< "\t" << frames / seconds << " fps"
+					<< (same ? "" : "\tMISMATCH") << std::endl;
+			}
+		}
+	}
+
+	return matched ? 0 : 1;
+}
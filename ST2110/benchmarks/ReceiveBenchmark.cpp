@@ -0,0 +1,377 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#include "st2110_adapter.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+
+namespace
+{
+	// RTP header and 125 us of 8 channel L24: the many small packets of
+	// the audio streams an ingest box carries per NIC
+	constexpr uint32_t PACKET_OCTETS = 12 + 6 * 8 * 3;
+
+	// RTP header, extended sequence number, SRD header and 1200 octets of
+	// pgroups: the size of a 2110-20 GPM packet
+	constexpr uint32_t VIDEO_PACKET_OCTETS = 12 + 2 + 6 + 1200;
+
+	constexpr uint32_t SEND_BATCH = 64;
+	constexpr int32_t FIRST_PORT = 20000;
+
+	// One multicast audio stream from one source, received on loopback
+	std::string MakeSDP(int32_t port)
+	{
+		return std::string(
+			"v=0\r\n"
+			"o=- 1443716955 1443716955 IN IP4 127.0.0.1\r\n"
+			"s=st2110 audio\r\n"
+			"t=0 0\r\n"
+			"m=audio ") + std::to_string(port) + " RTP/AVP 97\r\n"
+			"c=IN IP4 239.100.9.11/32\r\n"
+			"a=source-filter: incl IN IP4 239.100.9.11 127.0.0.1\r\n"
+			"a=rtpmap:97 L24/48000/8\r\n"
+			"a=fmtp:97 channel-order=SMPTE2110.(SGRP,SGRP)\r\n"
+			"a=ptime:0.125\r\n";
+	}
+
+	// One multicast video stream from one source, received on loopback
+	std::string MakeVideoSDP(int32_t port)
+	{
+		return std::string(
+			"v=0\r\n"
+			"o=- 1443716955 1443716955 IN IP4 127.0.0.1\r\n"
+			"s=st2110 stream\r\n"
+			"t=0 0\r\n"
+			"m=video ") + std::to_string(port) + " RTP/AVP 96\r\n"
+			"c=IN IP4 239.100.9.10/32\r\n"
+			"a=source-filter: incl IN IP4 239.100.9.10 127.0.0.1\r\n"
+			"a=rtpmap:96 raw/90000\r\n"
+			"a=fmtp:96 sampling=YCbCr-4:2:2; width=1920; height=1080; exactframerate=50; depth=10; TCS=SDR; colorimetry=BT709; PM=2110GPM; SSN=ST2110-20:2017; TP=2110TPN; \r\n";
+	}
+
+	double ThreadSeconds()
+	{
+		timespec time = {};
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+		return time.tv_sec + time.tv_nsec * 1e-9;
+	}
+
+	// Sends RTP packets of the given size round robin to every stream as
+	// fast as loopback takes them, SEND_BATCH per sendmmsg(). Returns the
+	// packets sent.
+	uint64_t Send(const std::vector<Cf::SDP::Endpoint>& endpoints, uint32_t packet_octets, uint8_t payload_type, const std::atomic<bool>& sending)
+	{
+		int32_t descriptor = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+		in_addr loopback = {};
+		loopback.s_addr = htonl(INADDR_LOOPBACK);
+		setsockopt(descriptor, IPPROTO_IP, IP_MULTICAST_IF, &loopback, sizeof(loopback));
+
+		std::vector<uint8_t> packets((size_t)SEND_BATCH * packet_octets);
+		std::vector<iovec> vectors(SEND_BATCH);
+		std::vector<mmsghdr> messages(SEND_BATCH);
+		for (uint32_t i = 0; i < SEND_BATCH; i++)
+		{
+			const Cf::SDP::Endpoint& endpoint = endpoints[i % endpoints.size()];
+			vectors[i] = { packets.data() + (size_t)i * packet_octets, packet_octets };
+			messages[i].msg_hdr.msg_name = (void*)endpoint.GetSockAddr();
+			messages[i].msg_hdr.msg_namelen = endpoint.GetSockAddrLength();
+			messages[i].msg_hdr.msg_iov = &vectors[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		Cf::RtpHeader header;
+		header.payload_type = payload_type;
+		uint64_t sent = 0;
+
+		while (sending.load(std::memory_order_relaxed))
+		{
+			for (uint32_t i = 0; i < SEND_BATCH; i++, header.sequence_number++)
+				header.Write(packets.data() + (size_t)i * packet_octets);
+
+			int32_t count = sendmmsg(descriptor, messages.data(), SEND_BATCH, 0);
+			if (count > 0)
+				sent += count;
+		}
+
+		close(descriptor);
+		return sent;
+	}
+
+	struct Result
+	{
+		uint64_t sent = 0;
+		uint64_t received = 0;
+		uint64_t system_calls = 0;
+		uint64_t ring_full = 0;
+		double receive_cpu_seconds = 0;
+		double seconds = 0;
+	};
+
+	// Runs the sender for the given time while `receive` runs on its
+	// threads, then lets the receivers drain
+	template<typename Receive>
+	Result Measure(const std::vector<Cf::SDP::Endpoint>& endpoints, uint32_t packet_octets, uint8_t payload_type, int32_t seconds_to_run, Receive receive)
+	{
+		Result result;
+		std::atomic<bool> sending = true;
+
+		auto start = std::chrono::steady_clock::now();
+		std::thread sender([&]() { result.sent = Send(endpoints, packet_octets, payload_type, sending); });
+
+		std::this_thread::sleep_for(std::chrono::seconds(seconds_to_run));
+		sending.store(false);
+		sender.join();
+		result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		receive(&result);
+		return result;
+	}
+
+	void Print(const char* backend, int32_t streams, const Result& result)
+	{
+		std::cout << backend << ", " << streams << " streams: "
+			<< result.received / result.seconds / 1e6 << " Mpps, "
+			<< (double)result.received / std::max<uint64_t>(result.system_calls, 1) << " packets per call, "
+			<< result.receive_cpu_seconds * 1e9 / std::max<uint64_t>(result.received, 1) << " ns receive CPU per packet, "
+			<< "lost " << result.sent - std::min(result.sent, result.received) << " of " << result.sent << std::endl;
+	}
+}
+
+
+/// <summary>
+/// ReceiveBenchmark: Sends small RTP packets round robin to a number of
+///					  loopback multicast audio streams and receives them
+///					  with each backend: an RtpReceiver (recvmmsg) and a
+///					  thread per stream, and one UringReceiver thread for
+///					  all streams. Then sends one 2110-20 sized stream to
+///					  an RtpReceiver whose ring is read by a number of
+///					  consumer threads. Reports packets per second, packets
+///					  per system call, receive CPU time per packet and
+///					  packets that did not arrive.
+/// </summary>
+int main(int argc, char** argv)
+{
+	int32_t stream_count = argc > 1 ? std::atoi(argv[1]) : 32;
+	int32_t seconds_to_run = argc > 2 ? std::atoi(argv[2]) : 4;
+	std::string mode = argc > 3 ? argv[3] : "all";
+	const char* interface_name = argc > 4 ? argv[4] : "lo";
+	int32_t consumer_count = argc > 5 ? std::atoi(argv[5]) : 2;
+	if (stream_count <= 0 || seconds_to_run <= 0 || consumer_count <= 0 ||
+		(mode != "all" && mode != "both" && mode != "recvmmsg" && mode != "uring" && mode != "consumers"))
+	{
+		std::cerr << "usage: " << argv[0] << " [streams [seconds [all|both|recvmmsg|uring|consumers [interface [consumers]]]]]" << std::endl;
+		return 2;
+	}
+
+	bool run_recvmmsg = mode == "all" || mode == "both" || mode == "recvmmsg";
+	bool run_uring = mode == "all" || mode == "both" || mode == "uring";
+	bool run_consumers = mode == "all" || mode == "consumers";
+
+	std::vector<std::unique_ptr<Cf::SDPParser>> sdp_parsers;
+	std::vector<Cf::SDP::Endpoint> endpoints;
+	for (int32_t i = 0; i < stream_count; i++)
+	{
+		sdp_parsers.push_back(std::make_unique<Cf::SDPParser>(MakeSDP(FIRST_PORT + i)));
+		endpoints.push_back(sdp_parsers.back()->GetSDP().GetAudio(0).endpoint);
+	}
+
+	bool complete = true;
+
+	if (run_recvmmsg)
+	{
+		Cf::RtpReceiverSettings settings;
+		settings.socket.interface_name = interface_name;
+
+		std::vector<std::unique_ptr<Cf::RtpReceiver>> receivers;
+		for (int32_t i = 0; i < stream_count; i++)
+			receivers.push_back(std::make_unique<Cf::RtpReceiver>(sdp_parsers[i]->GetSDP().GetAudio(0), settings));
+
+		// A blocking thread per stream, reading its own ring
+		std::atomic<bool> receiving = true;
+		std::vector<uint64_t> read(stream_count);
+		std::vector<double> cpu_seconds(stream_count);
+		std::vector<std::thread> threads;
+
+		for (int32_t i = 0; i < stream_count; i++)
+		{
+			threads.emplace_back([&, i]()
+			{
+				Cf::RtpReceiver& receiver = *receivers[i];
+				Cf::RtpHeader header;
+				double start = ThreadSeconds();
+
+				while (receiving.load(std::memory_order_relaxed))
+				{
+					receiver.ReceiveBatch();
+					while (Cf::PacketSlot* slot = receiver.TryAcquire())
+					{
+						read[i] += header.Read(slot->data, slot->octets) != 0;
+						receiver.Release(slot);
+					}
+				}
+
+				cpu_seconds[i] = ThreadSeconds() - start;
+			});
+		}
+
+		Result result = Measure(endpoints, PACKET_OCTETS, 97, seconds_to_run, [&](Result* result_ptr)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+			receiving.store(false);
+			for (std::thread& thread : threads)
+				thread.join();
+
+			for (int32_t i = 0; i < stream_count; i++)
+			{
+				const Cf::RtpReceiverStatistics& statistics = receivers[i]->GetStatistics();
+				result_ptr->received += statistics.packets.load();
+				result_ptr->system_calls += statistics.system_calls.load();
+				result_ptr->receive_cpu_seconds += cpu_seconds[i];
+				complete = complete && read[i] == statistics.packets.load();
+			}
+		});
+
+		Print("recvmmsg", stream_count, result);
+	}
+
+	if (run_uring)
+	{
+		Cf::UringReceiverSettings settings;
+		settings.socket.interface_name = interface_name;
+
+		Cf::UringReceiver receiver(settings);
+		std::vector<uint64_t> read(stream_count);
+		for (int32_t i = 0; i < stream_count; i++)
+		{
+			receiver.AddStream(sdp_parsers[i]->GetSDP().GetAudio(0), [&read, i](const uint8_t* packet, uint32_t octets)
+			{
+				Cf::RtpHeader header;
+				read[i] += header.Read(packet, octets) != 0;
+			});
+		}
+
+		// One thread for every stream
+		std::atomic<bool> receiving = true;
+		double cpu_seconds = 0;
+		std::thread thread([&]()
+		{
+			double start = ThreadSeconds();
+			while (receiving.load(std::memory_order_relaxed))
+				receiver.Receive();
+			cpu_seconds = ThreadSeconds() - start;
+		});
+
+		Result result = Measure(endpoints, PACKET_OCTETS, 97, seconds_to_run, [&](Result* result_ptr)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+			receiving.store(false);
+			thread.join();
+
+			const Cf::UringReceiverStatistics& statistics = receiver.GetStatistics();
+			result_ptr->received = statistics.packets.load();
+			result_ptr->system_calls = statistics.system_calls.load();
+			result_ptr->receive_cpu_seconds = cpu_seconds;
+
+			uint64_t handled = 0;
+			for (uint64_t count : read)
+				handled += count;
+			complete = complete && handled == statistics.packets.load();
+		});
+
+		Print("io_uring", stream_count, result);
+		std::cout << "io_uring buffers exhausted " << receiver.GetStatistics().buffers_exhausted.load() << " times" << std::endl;
+	}
+
+	if (run_consumers)
+	{
+		Cf::SDPParser sdp_parser(MakeVideoSDP(FIRST_PORT + stream_count));
+		const Cf::SDP::VideoDescription& video_description = sdp_parser.GetSDP().GetVideo(0);
+
+		Cf::RtpReceiverSettings settings;
+		settings.socket.interface_name = interface_name;
+
+		// The receive thread fills the ring; every consumer takes slots
+		// from it, which contends on the ring's read index
+		Cf::RtpReceiver receiver(video_description, settings);
+		receiver.Start();
+
+		std::atomic<bool> consuming = true;
+		std::vector<uint64_t> read(consumer_count);
+		std::vector<std::thread> consumers;
+
+		for (int32_t c = 0; c < consumer_count; c++)
+		{
+			consumers.emplace_back([&, c]()
+			{
+				Cf::RtpHeader header;
+
+				// Keep draining after the receiver stops, until the ring is
+				// empty
+				for (;;)
+				{
+					Cf::PacketSlot* slot = receiver.TryAcquire();
+					if (slot == nullptr)
+					{
+						if (!consuming.load(std::memory_order_acquire))
+							break;
+						continue;
+					}
+
+					read[c] += header.Read(slot->data, slot->octets) != 0;
+					receiver.Release(slot);
+				}
+			});
+		}
+
+		Result result = Measure({ video_description.endpoint }, VIDEO_PACKET_OCTETS, 96, seconds_to_run, [&](Result* result_ptr)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+			receiver.Stop();
+			consuming.store(false, std::memory_order_release);
+			for (std::thread& consumer : consumers)
+				consumer.join();
+
+			const Cf::RtpReceiverStatistics& statistics = receiver.GetStatistics();
+			result_ptr->received = statistics.packets.load();
+			result_ptr->system_calls = statistics.system_calls.load();
+			result_ptr->ring_full = statistics.ring_full.load();
+
+			uint64_t handled = 0;
+			for (uint64_t count : read)
+				handled += count;
+			complete = complete && handled == statistics.packets.load();
+		});
+
+		std::cout << "recvmmsg, 1 stream, " << consumer_count << " consumers: "
+			<< result.received / result.seconds / 1e6 << " Mpps, "
+			<< (double)result.received / std::max<uint64_t>(result.system_calls, 1) << " packets per call, "
+			<< "lost " << result.sent - std::min(result.sent, result.received) << " of " << result.sent
+			<< ", ring full " << result.ring_full << std::endl;
+	}
+
+	return complete ? 0 : 1;
+}
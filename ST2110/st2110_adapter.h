@@ -0,0 +1,85 @@
+/*
+~~~~~~
+
+Code Sample License Agreement
+Effective Date: 4/15/2025
+Cinnafilm, Inc. ("Licensor") grants Finn Thomas ("Licensee") a non-exclusive, 
+non-transferable, revocable license to use the provided code samples ("Code") 
+under the following terms:
+- Permitted Use: Licensee may use the Code solely for personal, non-commercial 
+purposes, such as inclusion in a portfolio or demonstration during job 
+interviews.
+- Restrictions: Licensee may not: (a) use the Code for any commercial purpose; 
+(b) distribute, sell, sublicense, or otherwise share the Code with third 
+parties; (c) modify the Code for purposes beyond personal demonstration; or 
+(d) claim ownership of the Code.
+- Ownership: The Code remains the exclusive property of Cinnafilm, Inc.
+- Termination: This license may be terminated by Licensor at any time with 
+written notice to Licensee, after which Licensee must cease all use of the Code.
+No Warranty: The Code is provided "as is," with no warranties of any kind.
+By using the Code, Licensee agrees to these terms.
+
+~~~~~
+*/
+
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <functional>
+
+// SIMD intrinsics for the x86 kernels
+#if defined(__x86_64__) || defined(_M_X64)
+#define ST2110_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// Socket backends (recvmmsg, io_uring, sendmmsg) are Linux only
+#ifdef __linux__
+#define ST2110_LINUX 1
+#include <net/if.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+#endif
+
+
+// common includes
+#include "sdp_adapter.h"
+#include "SimdLevel.h"
+#include "RuntimeDetail.h"
+#include "FrameLayout.h"
+#include "RtpHeader.h"
+#include "KernelDetail.h"
+#include "KernelTable.h"
+#include "PgroupUnpacker.h"
+#include "PgroupPacker.h"
+#include "BpmPlacement.h"
+#include "FramePool.h"
+#include "FrameAssembler.h"
+#include "TestPattern.h"
+#include "AudioFormat.h"
+#include "AudioUnpacker.h"
+#include "AudioPacker.h"
+#include "PacketRing.h"
+#include "RtpSocket.h"
+#include "RtpReceiver.h"
+#include "UringReceiver.h"
+#include "VideoSender.h"
+#include "RtpBlaster.h"